@@ -6,6 +6,7 @@
 #include "soc/soc_caps.h"
 
 #if SOC_LCD_RGB_SUPPORTED
+#include <stdlib.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "driver/gpio.h"
@@ -30,6 +31,8 @@ typedef struct {
         unsigned int enable_io_multiplex: 1;
         unsigned int display_on_off_use_cmd: 1;
         unsigned int reset_level: 1;
+        unsigned int warm_restart: 1;
+        unsigned int warm: 1; // the panel kept its configuration, reset and init only restart the RGB side
     } flags;
     // To save the original functions of RGB panel
     esp_err_t (*init)(esp_lcd_panel_t *panel);
@@ -57,12 +60,18 @@ esp_err_t esp_lcd_new_panel_nv3052_rgb(const esp_lcd_panel_io_handle_t io, const
     ESP_RETURN_ON_FALSE(vendor_config && vendor_config->rgb_config, ESP_ERR_INVALID_ARG, TAG, "`verndor_config` and `rgb_config` are necessary");
     ESP_RETURN_ON_FALSE(!vendor_config->flags.enable_io_multiplex || !vendor_config->flags.mirror_by_cmd,
                         ESP_ERR_INVALID_ARG, TAG, "`mirror_by_cmd` and `enable_io_multiplex` cannot work together");
+    ESP_RETURN_ON_FALSE(!vendor_config->flags.enable_io_multiplex || !vendor_config->flags.warm_restart,
+                        ESP_ERR_INVALID_ARG, TAG, "`warm_restart` and `enable_io_multiplex` cannot work together");
 
     esp_err_t ret = ESP_OK;
     nv3052_panel_t *nv3052 = (nv3052_panel_t *)calloc(1, sizeof(nv3052_panel_t));
     ESP_RETURN_ON_FALSE(nv3052, ESP_ERR_NO_MEM, TAG, "no mem for nv3052 panel");
 
     if (panel_dev_config->reset_gpio_num >= 0) {
+        if (vendor_config->flags.warm_restart) {
+            // inactive from the moment it becomes an output, a glitch would reset the panel
+            gpio_set_level(panel_dev_config->reset_gpio_num, !panel_dev_config->flags.reset_active_high);
+        }
         gpio_config_t io_conf = {
             .mode = GPIO_MODE_OUTPUT,
             .pin_bit_mask = 1ULL << panel_dev_config->reset_gpio_num,
@@ -78,6 +87,7 @@ esp_err_t esp_lcd_new_panel_nv3052_rgb(const esp_lcd_panel_io_handle_t io, const
     nv3052->flags.display_on_off_use_cmd = (vendor_config->rgb_config->disp_gpio_num >= 0) ? 0 : 1;
     nv3052->flags.enable_io_multiplex = vendor_config->flags.enable_io_multiplex;
     nv3052->flags.reset_level = panel_dev_config->flags.reset_active_high;
+    nv3052->flags.warm_restart = vendor_config->flags.warm_restart;
 
     if (nv3052->flags.enable_io_multiplex) {
         if (nv3052->reset_gpio_num >= 0) {  // Perform hardware reset
@@ -132,204 +142,200 @@ err:
     return ret;
 }
 
-static const nv3052_lcd_init_cmd_t rgb_lcd_init_cmds[] = {
-//  {cmd, { data }, data_size, delay_ms}
-    {0xFF, (uint8_t []){0x30}, 1, 0},
-    {0xFF, (uint8_t []){0x52}, 1, 0},
-    {0xFF, (uint8_t []){0x01}, 1, 0},
-    {0xE3, (uint8_t []){0x00}, 1, 0},
-    {0x0A, (uint8_t []){0x01}, 1, 0},
-    {0x23, (uint8_t []){0xA2}, 1, 0},//RGB MODE
-    {0x25, (uint8_t []){0x14}, 1, 0},
-    {0x29, (uint8_t []){0x02}, 1, 0},
-    {0x2A, (uint8_t []){0xCF}, 1, 0},
-    {0x38, (uint8_t []){0x9C}, 1, 0},
-    {0x39, (uint8_t []){0xA7}, 1, 0},
-    {0x3A, (uint8_t []){0x33}, 1, 0},//VCOM
-    {0x91, (uint8_t []){0x77}, 1, 0},
-    {0x92, (uint8_t []){0x77}, 1, 0},
-    {0x99, (uint8_t []){0x52}, 1, 0},
-    {0x9B, (uint8_t []){0x5B}, 1, 0},
-    {0xA0, (uint8_t []){0x55}, 1, 0},
-    {0xA1, (uint8_t []){0x50}, 1, 0},
-    {0xA4, (uint8_t []){0x9C}, 1, 0},
-    {0xA7, (uint8_t []){0x02}, 1, 0},
-    {0xA8, (uint8_t []){0x01}, 1, 0},
-    {0xA9, (uint8_t []){0x01}, 1, 0},
-    {0xAA, (uint8_t []){0xFC}, 1, 0},
-    {0xAB, (uint8_t []){0x28}, 1, 0},
-    {0xAC, (uint8_t []){0x06}, 1, 0},
-    {0xAD, (uint8_t []){0x06}, 1, 0},
-    {0xAE, (uint8_t []){0x06}, 1, 0},
-    {0xAF, (uint8_t []){0x03}, 1, 0},
-    {0xB0, (uint8_t []){0x08}, 1, 0},
-    {0xB1, (uint8_t []){0x26}, 1, 0},
-    {0xB2, (uint8_t []){0x28}, 1, 0},
-    {0xB3, (uint8_t []){0x28}, 1, 0},
-    {0xB4, (uint8_t []){0x03}, 1, 0},
-    {0xB5, (uint8_t []){0x08}, 1, 0},
-    {0xB6, (uint8_t []){0x26}, 1, 0},
-    {0xB7, (uint8_t []){0x08}, 1, 0},
-    {0xB8, (uint8_t []){0x26}, 1, 0},
-    {0xFF, (uint8_t []){0x30}, 1, 0},
-    {0xFF, (uint8_t []){0x52}, 1, 0},
-    {0xFF, (uint8_t []){0x02}, 1, 0},
-    {0xB0, (uint8_t []){0x02}, 1, 0},
-    {0xB1, (uint8_t []){0x31}, 1, 0},
-    {0xB2, (uint8_t []){0x24}, 1, 0},
-    {0xB3, (uint8_t []){0x30}, 1, 0},
-    {0xB4, (uint8_t []){0x38}, 1, 0},
-    {0xB5, (uint8_t []){0x3E}, 1, 0},
-    {0xB6, (uint8_t []){0x26}, 1, 0},
-    {0xB7, (uint8_t []){0x3E}, 1, 0},
-    {0xB8, (uint8_t []){0x0a}, 1, 0},
-    {0xB9, (uint8_t []){0x00}, 1, 0},
-    {0xBA, (uint8_t []){0x11}, 1, 0},
-    {0xBB, (uint8_t []){0x11}, 1, 0},
-    {0xBC, (uint8_t []){0x13}, 1, 0},
-    {0xBD, (uint8_t []){0x14}, 1, 0},
-    {0xBE, (uint8_t []){0x18}, 1, 0},
-    {0xBF, (uint8_t []){0x11}, 1, 0},
-    {0xC0, (uint8_t []){0x16}, 1, 0},
-    {0xC1, (uint8_t []){0x00}, 1, 0},
-    {0xD0, (uint8_t []){0x05}, 1, 0},
-    {0xD1, (uint8_t []){0x30}, 1, 0},
-    {0xD2, (uint8_t []){0x25}, 1, 0},
-    {0xD3, (uint8_t []){0x35}, 1, 0},
-    {0xD4, (uint8_t []){0x34}, 1, 0},
-    {0xD5, (uint8_t []){0x3B}, 1, 0},
-    {0xD6, (uint8_t []){0x26}, 1, 0},
-    {0xD7, (uint8_t []){0x3D}, 1, 0},
-    {0xD8, (uint8_t []){0x0a}, 1, 0},
-    {0xD9, (uint8_t []){0x00}, 1, 0},
-    {0xDA, (uint8_t []){0x12}, 1, 0},
-    {0xDB, (uint8_t []){0x10}, 1, 0},
-    {0xDC, (uint8_t []){0x12}, 1, 0},
-    {0xDD, (uint8_t []){0x14}, 1, 0},
-    {0xDE, (uint8_t []){0x18}, 1, 0},
-    {0xDF, (uint8_t []){0x11}, 1, 0},
-    {0xE0, (uint8_t []){0x15}, 1, 0},
-    {0xE1, (uint8_t []){0x00}, 1, 0},
-    {0xFF, (uint8_t []){0x30}, 1, 0},
-    {0xFF, (uint8_t []){0x52}, 1, 0},
-    {0xFF, (uint8_t []){0x03}, 1, 0},
-    {0x08, (uint8_t []){0x09}, 1, 0},
-    {0x09, (uint8_t []){0x0A}, 1, 0},
-    {0x0A, (uint8_t []){0x0B}, 1, 0},
-    {0x0B, (uint8_t []){0x0C}, 1, 0},
-    {0x28, (uint8_t []){0x22}, 1, 0},
-    {0x2A, (uint8_t []){0xEC}, 1, 0},
-    {0x2B, (uint8_t []){0xEC}, 1, 0},
-    {0x30, (uint8_t []){0x00}, 1, 0},
-    {0x31, (uint8_t []){0x00}, 1, 0},
-    {0x32, (uint8_t []){0x00}, 1, 0},
-    {0x33, (uint8_t []){0x00}, 1, 0},
-    {0x34, (uint8_t []){0x61}, 1, 0},
-    {0x35, (uint8_t []){0xD4}, 1, 0},
-    {0x36, (uint8_t []){0x24}, 1, 0},
-    {0x37, (uint8_t []){0x03}, 1, 0},
-    {0x40, (uint8_t []){0x0D}, 1, 0},
-    {0x41, (uint8_t []){0x0E}, 1, 0},
-    {0x42, (uint8_t []){0x0F}, 1, 0},
-    {0x43, (uint8_t []){0x10}, 1, 0},
-    {0x44, (uint8_t []){0x22}, 1, 0},
-    {0x45, (uint8_t []){0xE1}, 1, 0},
-    {0x46, (uint8_t []){0xE2}, 1, 0},
-    {0x47, (uint8_t []){0x22}, 1, 0},
-    {0x48, (uint8_t []){0xE3}, 1, 0},
-    {0x49, (uint8_t []){0xE4}, 1, 0},
-    {0x50, (uint8_t []){0x11}, 1, 0},
-    {0x51, (uint8_t []){0x12}, 1, 0},
-    {0x52, (uint8_t []){0x13}, 1, 0},
-    {0x53, (uint8_t []){0x14}, 1, 0},
-    {0x54, (uint8_t []){0x22}, 1, 0},
-    {0x55, (uint8_t []){0xE5}, 1, 0},
-    {0x56, (uint8_t []){0xE6}, 1, 0},
-    {0x57, (uint8_t []){0x22}, 1, 0},
-    {0x58, (uint8_t []){0xE7}, 1, 0},
-    {0x59, (uint8_t []){0xE8}, 1, 0},
-    {0x80, (uint8_t []){0x05}, 1, 0},
-    {0x81, (uint8_t []){0x1E}, 1, 0},
-    {0x82, (uint8_t []){0x02}, 1, 0},
-    {0x83, (uint8_t []){0x04}, 1, 0},
-    {0x84, (uint8_t []){0x1E}, 1, 0},
-    {0x85, (uint8_t []){0x1E}, 1, 0},
-    {0x86, (uint8_t []){0x1f}, 1, 0},
-    {0x87, (uint8_t []){0x1f}, 1, 0},
-    {0x88, (uint8_t []){0x0E}, 1, 0},
-    {0x89, (uint8_t []){0x10}, 1, 0},
-    {0x8A, (uint8_t []){0x0A}, 1, 0},
-    {0x8B, (uint8_t []){0x0C}, 1, 0},
-    {0x96, (uint8_t []){0x05}, 1, 0},
-    {0x97, (uint8_t []){0x1E}, 1, 0},
-    {0x98, (uint8_t []){0x01}, 1, 0},
-    {0x99, (uint8_t []){0x03}, 1, 0},
-    {0x9A, (uint8_t []){0x1E}, 1, 0},
-    {0x9B, (uint8_t []){0x1E}, 1, 0},
-    {0x9C, (uint8_t []){0x1f}, 1, 0},
-    {0x9D, (uint8_t []){0x1f}, 1, 0},
-    {0x9E, (uint8_t []){0x0D}, 1, 0},
-    {0x9F, (uint8_t []){0x0F}, 1, 0},
-    {0xA0, (uint8_t []){0x09}, 1, 0},
-    {0xA1, (uint8_t []){0x0B}, 1, 0},
-    {0xB0, (uint8_t []){0x05}, 1, 0},
-    {0xB1, (uint8_t []){0x1F}, 1, 0},
-    {0xB2, (uint8_t []){0x03}, 1, 0},
-    {0xB3, (uint8_t []){0x01}, 1, 0},
-    {0xB4, (uint8_t []){0x1E}, 1, 0},
-    {0xB5, (uint8_t []){0x1E}, 1, 0},
-    {0xB6, (uint8_t []){0x1f}, 1, 0},
-    {0xB7, (uint8_t []){0x1E}, 1, 0},
-    {0xB8, (uint8_t []){0x0B}, 1, 0},
-    {0xB9, (uint8_t []){0x09}, 1, 0},
-    {0xBA, (uint8_t []){0x0F}, 1, 0},
-    {0xBB, (uint8_t []){0x0D}, 1, 0},
-    {0xC6, (uint8_t []){0x05}, 1, 0},
-    {0xC7, (uint8_t []){0x1F}, 1, 0},
-    {0xC8, (uint8_t []){0x04}, 1, 0},
-    {0xC9, (uint8_t []){0x02}, 1, 0},
-    {0xCA, (uint8_t []){0x1E}, 1, 0},
-    {0xCB, (uint8_t []){0x1E}, 1, 0},
-    {0xCC, (uint8_t []){0x1f}, 1, 0},
-    {0xCD, (uint8_t []){0x1E}, 1, 0},
-    {0xCE, (uint8_t []){0x0C}, 1, 0},
-    {0xCF, (uint8_t []){0x0A}, 1, 0},
-    {0xD0, (uint8_t []){0x10}, 1, 0},
-    {0xD1, (uint8_t []){0x0E}, 1, 0},
-    {0xFF, (uint8_t []){0x30}, 1, 0},
-    {0xFF, (uint8_t []){0x52}, 1, 0},
-    {0xFF, (uint8_t []){0x00}, 1, 0},
-    {0x36, (uint8_t []){0x02}, 1, 0},//反扫09
-    {0x3A, (uint8_t []){0x77}, 1, 0},//16BIT
-    {0x11, (uint8_t []){0x00}, 1, 200},
-    {0x29, (uint8_t []){0x00}, 1, 100},
+static const uint8_t rgb_lcd_init_seq[] = {
+//  LCD_INIT_SEQ_CMD(cmd, delay_ms, data...)
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x30),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x52),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0xE3, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x0A, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0x23, 0, 0xA2),//RGB MODE
+    LCD_INIT_SEQ_CMD(0x25, 0, 0x14),
+    LCD_INIT_SEQ_CMD(0x29, 0, 0x02),
+    LCD_INIT_SEQ_CMD(0x2A, 0, 0xCF),
+    LCD_INIT_SEQ_CMD(0x38, 0, 0x9C),
+    LCD_INIT_SEQ_CMD(0x39, 0, 0xA7),
+    LCD_INIT_SEQ_CMD(0x3A, 0, 0x33),//VCOM
+    LCD_INIT_SEQ_CMD(0x91, 0, 0x77),
+    LCD_INIT_SEQ_CMD(0x92, 0, 0x77),
+    LCD_INIT_SEQ_CMD(0x99, 0, 0x52),
+    LCD_INIT_SEQ_CMD(0x9B, 0, 0x5B),
+    LCD_INIT_SEQ_CMD(0xA0, 0, 0x55),
+    LCD_INIT_SEQ_CMD(0xA1, 0, 0x50),
+    LCD_INIT_SEQ_CMD(0xA4, 0, 0x9C),
+    LCD_INIT_SEQ_CMD(0xA7, 0, 0x02),
+    LCD_INIT_SEQ_CMD(0xA8, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0xA9, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0xAA, 0, 0xFC),
+    LCD_INIT_SEQ_CMD(0xAB, 0, 0x28),
+    LCD_INIT_SEQ_CMD(0xAC, 0, 0x06),
+    LCD_INIT_SEQ_CMD(0xAD, 0, 0x06),
+    LCD_INIT_SEQ_CMD(0xAE, 0, 0x06),
+    LCD_INIT_SEQ_CMD(0xAF, 0, 0x03),
+    LCD_INIT_SEQ_CMD(0xB0, 0, 0x08),
+    LCD_INIT_SEQ_CMD(0xB1, 0, 0x26),
+    LCD_INIT_SEQ_CMD(0xB2, 0, 0x28),
+    LCD_INIT_SEQ_CMD(0xB3, 0, 0x28),
+    LCD_INIT_SEQ_CMD(0xB4, 0, 0x03),
+    LCD_INIT_SEQ_CMD(0xB5, 0, 0x08),
+    LCD_INIT_SEQ_CMD(0xB6, 0, 0x26),
+    LCD_INIT_SEQ_CMD(0xB7, 0, 0x08),
+    LCD_INIT_SEQ_CMD(0xB8, 0, 0x26),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x30),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x52),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x02),
+    LCD_INIT_SEQ_CMD(0xB0, 0, 0x02),
+    LCD_INIT_SEQ_CMD(0xB1, 0, 0x31),
+    LCD_INIT_SEQ_CMD(0xB2, 0, 0x24),
+    LCD_INIT_SEQ_CMD(0xB3, 0, 0x30),
+    LCD_INIT_SEQ_CMD(0xB4, 0, 0x38),
+    LCD_INIT_SEQ_CMD(0xB5, 0, 0x3E),
+    LCD_INIT_SEQ_CMD(0xB6, 0, 0x26),
+    LCD_INIT_SEQ_CMD(0xB7, 0, 0x3E),
+    LCD_INIT_SEQ_CMD(0xB8, 0, 0x0a),
+    LCD_INIT_SEQ_CMD(0xB9, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0xBA, 0, 0x11),
+    LCD_INIT_SEQ_CMD(0xBB, 0, 0x11),
+    LCD_INIT_SEQ_CMD(0xBC, 0, 0x13),
+    LCD_INIT_SEQ_CMD(0xBD, 0, 0x14),
+    LCD_INIT_SEQ_CMD(0xBE, 0, 0x18),
+    LCD_INIT_SEQ_CMD(0xBF, 0, 0x11),
+    LCD_INIT_SEQ_CMD(0xC0, 0, 0x16),
+    LCD_INIT_SEQ_CMD(0xC1, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0xD0, 0, 0x05),
+    LCD_INIT_SEQ_CMD(0xD1, 0, 0x30),
+    LCD_INIT_SEQ_CMD(0xD2, 0, 0x25),
+    LCD_INIT_SEQ_CMD(0xD3, 0, 0x35),
+    LCD_INIT_SEQ_CMD(0xD4, 0, 0x34),
+    LCD_INIT_SEQ_CMD(0xD5, 0, 0x3B),
+    LCD_INIT_SEQ_CMD(0xD6, 0, 0x26),
+    LCD_INIT_SEQ_CMD(0xD7, 0, 0x3D),
+    LCD_INIT_SEQ_CMD(0xD8, 0, 0x0a),
+    LCD_INIT_SEQ_CMD(0xD9, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0xDA, 0, 0x12),
+    LCD_INIT_SEQ_CMD(0xDB, 0, 0x10),
+    LCD_INIT_SEQ_CMD(0xDC, 0, 0x12),
+    LCD_INIT_SEQ_CMD(0xDD, 0, 0x14),
+    LCD_INIT_SEQ_CMD(0xDE, 0, 0x18),
+    LCD_INIT_SEQ_CMD(0xDF, 0, 0x11),
+    LCD_INIT_SEQ_CMD(0xE0, 0, 0x15),
+    LCD_INIT_SEQ_CMD(0xE1, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x30),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x52),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x03),
+    LCD_INIT_SEQ_CMD(0x08, 0, 0x09),
+    LCD_INIT_SEQ_CMD(0x09, 0, 0x0A),
+    LCD_INIT_SEQ_CMD(0x0A, 0, 0x0B),
+    LCD_INIT_SEQ_CMD(0x0B, 0, 0x0C),
+    LCD_INIT_SEQ_CMD(0x28, 0, 0x22),
+    LCD_INIT_SEQ_CMD(0x2A, 0, 0xEC),
+    LCD_INIT_SEQ_CMD(0x2B, 0, 0xEC),
+    LCD_INIT_SEQ_CMD(0x30, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x31, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x32, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x33, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x34, 0, 0x61),
+    LCD_INIT_SEQ_CMD(0x35, 0, 0xD4),
+    LCD_INIT_SEQ_CMD(0x36, 0, 0x24),
+    LCD_INIT_SEQ_CMD(0x37, 0, 0x03),
+    LCD_INIT_SEQ_CMD(0x40, 0, 0x0D),
+    LCD_INIT_SEQ_CMD(0x41, 0, 0x0E),
+    LCD_INIT_SEQ_CMD(0x42, 0, 0x0F),
+    LCD_INIT_SEQ_CMD(0x43, 0, 0x10),
+    LCD_INIT_SEQ_CMD(0x44, 0, 0x22),
+    LCD_INIT_SEQ_CMD(0x45, 0, 0xE1),
+    LCD_INIT_SEQ_CMD(0x46, 0, 0xE2),
+    LCD_INIT_SEQ_CMD(0x47, 0, 0x22),
+    LCD_INIT_SEQ_CMD(0x48, 0, 0xE3),
+    LCD_INIT_SEQ_CMD(0x49, 0, 0xE4),
+    LCD_INIT_SEQ_CMD(0x50, 0, 0x11),
+    LCD_INIT_SEQ_CMD(0x51, 0, 0x12),
+    LCD_INIT_SEQ_CMD(0x52, 0, 0x13),
+    LCD_INIT_SEQ_CMD(0x53, 0, 0x14),
+    LCD_INIT_SEQ_CMD(0x54, 0, 0x22),
+    LCD_INIT_SEQ_CMD(0x55, 0, 0xE5),
+    LCD_INIT_SEQ_CMD(0x56, 0, 0xE6),
+    LCD_INIT_SEQ_CMD(0x57, 0, 0x22),
+    LCD_INIT_SEQ_CMD(0x58, 0, 0xE7),
+    LCD_INIT_SEQ_CMD(0x59, 0, 0xE8),
+    LCD_INIT_SEQ_CMD(0x80, 0, 0x05),
+    LCD_INIT_SEQ_CMD(0x81, 0, 0x1E),
+    LCD_INIT_SEQ_CMD(0x82, 0, 0x02),
+    LCD_INIT_SEQ_CMD(0x83, 0, 0x04),
+    LCD_INIT_SEQ_CMD(0x84, 0, 0x1E),
+    LCD_INIT_SEQ_CMD(0x85, 0, 0x1E),
+    LCD_INIT_SEQ_CMD(0x86, 0, 0x1f),
+    LCD_INIT_SEQ_CMD(0x87, 0, 0x1f),
+    LCD_INIT_SEQ_CMD(0x88, 0, 0x0E),
+    LCD_INIT_SEQ_CMD(0x89, 0, 0x10),
+    LCD_INIT_SEQ_CMD(0x8A, 0, 0x0A),
+    LCD_INIT_SEQ_CMD(0x8B, 0, 0x0C),
+    LCD_INIT_SEQ_CMD(0x96, 0, 0x05),
+    LCD_INIT_SEQ_CMD(0x97, 0, 0x1E),
+    LCD_INIT_SEQ_CMD(0x98, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0x99, 0, 0x03),
+    LCD_INIT_SEQ_CMD(0x9A, 0, 0x1E),
+    LCD_INIT_SEQ_CMD(0x9B, 0, 0x1E),
+    LCD_INIT_SEQ_CMD(0x9C, 0, 0x1f),
+    LCD_INIT_SEQ_CMD(0x9D, 0, 0x1f),
+    LCD_INIT_SEQ_CMD(0x9E, 0, 0x0D),
+    LCD_INIT_SEQ_CMD(0x9F, 0, 0x0F),
+    LCD_INIT_SEQ_CMD(0xA0, 0, 0x09),
+    LCD_INIT_SEQ_CMD(0xA1, 0, 0x0B),
+    LCD_INIT_SEQ_CMD(0xB0, 0, 0x05),
+    LCD_INIT_SEQ_CMD(0xB1, 0, 0x1F),
+    LCD_INIT_SEQ_CMD(0xB2, 0, 0x03),
+    LCD_INIT_SEQ_CMD(0xB3, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0xB4, 0, 0x1E),
+    LCD_INIT_SEQ_CMD(0xB5, 0, 0x1E),
+    LCD_INIT_SEQ_CMD(0xB6, 0, 0x1f),
+    LCD_INIT_SEQ_CMD(0xB7, 0, 0x1E),
+    LCD_INIT_SEQ_CMD(0xB8, 0, 0x0B),
+    LCD_INIT_SEQ_CMD(0xB9, 0, 0x09),
+    LCD_INIT_SEQ_CMD(0xBA, 0, 0x0F),
+    LCD_INIT_SEQ_CMD(0xBB, 0, 0x0D),
+    LCD_INIT_SEQ_CMD(0xC6, 0, 0x05),
+    LCD_INIT_SEQ_CMD(0xC7, 0, 0x1F),
+    LCD_INIT_SEQ_CMD(0xC8, 0, 0x04),
+    LCD_INIT_SEQ_CMD(0xC9, 0, 0x02),
+    LCD_INIT_SEQ_CMD(0xCA, 0, 0x1E),
+    LCD_INIT_SEQ_CMD(0xCB, 0, 0x1E),
+    LCD_INIT_SEQ_CMD(0xCC, 0, 0x1f),
+    LCD_INIT_SEQ_CMD(0xCD, 0, 0x1E),
+    LCD_INIT_SEQ_CMD(0xCE, 0, 0x0C),
+    LCD_INIT_SEQ_CMD(0xCF, 0, 0x0A),
+    LCD_INIT_SEQ_CMD(0xD0, 0, 0x10),
+    LCD_INIT_SEQ_CMD(0xD1, 0, 0x0E),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x30),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x52),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x36, 0, 0x02),//反扫09
+    LCD_INIT_SEQ_CMD(0x3A, 0, 0x77),//16BIT
+    LCD_INIT_SEQ_CMD(0x11, 200, 0x00),
+    LCD_INIT_SEQ_CMD(0x29, 100, 0x00),
 };
 
+static uint32_t panel_nv3052_init_seq_checksum(nv3052_panel_t *nv3052)
+{
+    if (nv3052->init_cmds) {
+        return lcd_init_seq_checksum(nv3052->init_cmds, nv3052->init_cmds_size);
+    }
+    return lcd_init_seq_checksum_packed(rgb_lcd_init_seq, sizeof(rgb_lcd_init_seq));
+}
+
 static esp_err_t panel_nv3052_send_init_cmds(nv3052_panel_t *nv3052)
 {
     esp_lcd_panel_io_handle_t io = nv3052->io;
-    const nv3052_lcd_init_cmd_t *init_cmds = NULL;
-    uint16_t init_cmds_size = 0;
-    bool is_command2_disable = true;
-    bool is_cmd_overwritten = false;
 
     // vendor specific initialization, it can be different between manufacturers
     // should consult the LCD supplier for initialization sequence code
+    // sent back to back, with real waits only where the sequence asks for them
     if (nv3052->init_cmds) {
-        init_cmds = nv3052->init_cmds;
-        init_cmds_size = nv3052->init_cmds_size;
+        ESP_RETURN_ON_ERROR(lcd_init_seq_send(io, nv3052->init_cmds, nv3052->init_cmds_size, NULL),
+                            TAG, "send init commands failed");
     } else {
-        init_cmds = rgb_lcd_init_cmds;
-        init_cmds_size = sizeof(rgb_lcd_init_cmds) / sizeof(nv3052_lcd_init_cmd_t);
-    }
-
-    for (int i = 0; i < init_cmds_size; i++) {
-        // Send command
-        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes),
-                            TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(init_cmds[i].delay_ms));
-
-        ESP_LOGW(TAG,"send commands %d/%d",i,init_cmds_size);
+        ESP_RETURN_ON_ERROR(lcd_init_seq_send_packed(io, rgb_lcd_init_seq, sizeof(rgb_lcd_init_seq), NULL),
+                            TAG, "send init commands failed");
     }
     ESP_LOGI(TAG, "send init commands success");
 
@@ -340,11 +346,21 @@ static esp_err_t panel_nv3052_init(esp_lcd_panel_t *panel)
 {
     nv3052_panel_t *nv3052 = (nv3052_panel_t *)panel->user_data;
 
-    if (!nv3052->flags.enable_io_multiplex) {
+    if (!nv3052->flags.enable_io_multiplex && !nv3052->flags.warm) {
+        if (nv3052->flags.warm_restart) {
+            lcd_init_seq_warm_invalidate();
+        }
         ESP_RETURN_ON_ERROR(panel_nv3052_send_init_cmds(nv3052), TAG, "send init commands failed");
+        if (nv3052->flags.warm_restart) {
+            lcd_init_seq_warm_save(panel_nv3052_init_seq_checksum(nv3052), nv3052->madctl_val, nv3052->colmod_val);
+        }
     }
     // Init RGB panel
     ESP_RETURN_ON_ERROR(nv3052->init(panel), TAG, "init RGB panel failed");
+    if (nv3052->flags.warm_restart && nv3052->reset_gpio_num >= 0) {
+        // the pad keeps its level through the software reset, RST can't glitch while the chip restarts
+        gpio_hold_en(nv3052->reset_gpio_num);
+    }
 
     return ESP_OK;
 }
@@ -354,6 +370,7 @@ static esp_err_t panel_nv3052_del(esp_lcd_panel_t *panel)
     nv3052_panel_t *nv3052 = (nv3052_panel_t *)panel->user_data;
 
     if (nv3052->reset_gpio_num >= 0) {
+        gpio_hold_dis(nv3052->reset_gpio_num);
         gpio_reset_pin(nv3052->reset_gpio_num);
     }
     // Delete RGB panel
@@ -368,8 +385,21 @@ static esp_err_t panel_nv3052_reset(esp_lcd_panel_t *panel)
     nv3052_panel_t *nv3052 = (nv3052_panel_t *)panel->user_data;
     esp_lcd_panel_io_handle_t io = nv3052->io;
 
+    if (nv3052->flags.warm_restart) {
+        if (lcd_init_seq_warm_restore(panel_nv3052_init_seq_checksum(nv3052), &nv3052->madctl_val, &nv3052->colmod_val)) {
+            // the panel stayed powered and configured across a software reset
+            nv3052->flags.warm = 1;
+            ESP_LOGI(TAG, "panel kept its configuration, skip reset and init sequence");
+            return nv3052->reset(panel);
+        }
+        // a panel reset and not initialized again must never be trusted after the next restart
+        lcd_init_seq_warm_invalidate();
+    }
+
     // Perform hardware reset
     if (nv3052->reset_gpio_num >= 0) {
+        // held since the last init, a held pad ignores the level
+        gpio_hold_dis(nv3052->reset_gpio_num);
         gpio_set_level(nv3052->reset_gpio_num, nv3052->flags.reset_level);
         vTaskDelay(pdMS_TO_TICKS(10));
         gpio_set_level(nv3052->reset_gpio_num, !nv3052->flags.reset_level);
@@ -409,6 +439,9 @@ static esp_err_t panel_nv3052_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool
         ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]) {
             nv3052->madctl_val,
         }, 1), TAG, "send command failed");;
+        if (nv3052->flags.warm_restart) {
+            lcd_init_seq_warm_save(panel_nv3052_init_seq_checksum(nv3052), nv3052->madctl_val, nv3052->colmod_val);
+        }
     } else {
         // Control mirror through RGB panel
         ESP_RETURN_ON_ERROR(nv3052->mirror(panel, mirror_x, mirror_y), TAG, "RGB panel mirror failed");
@@ -437,4 +470,48 @@ static esp_err_t panel_nv3052_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
     }
     return ESP_OK;
 }
+
+static esp_err_t panel_nv3052_desc_new(esp_lcd_panel_io_handle_t io, const lcd_panel_new_config_t *config,
+                                       esp_lcd_panel_handle_t *ret_panel)
+{
+    nv3052_vendor_config_t vendor_config = {
+        .rgb_config = config->rgb_config,
+        .flags = {
+            .mirror_by_cmd = config->flags.mirror_by_cmd,
+            .warm_restart = config->flags.warm_restart,
+        },
+    };
+    esp_lcd_panel_dev_config_t panel_dev_config = {
+        .reset_gpio_num = config->reset_gpio_num,
+        .rgb_ele_order = LCD_RGB_ELEMENT_ORDER_RGB,
+        .bits_per_pixel = 16,
+        .vendor_config = &vendor_config,
+    };
+    return esp_lcd_new_panel_nv3052_rgb(io, &panel_dev_config, ret_panel);
+}
+
+const lcd_panel_desc_t nv3052_panel_desc = {
+    .name = "nv3052c",
+    .timings = {
+        .pclk_hz = 15 * 1000 * 1000,
+        .h_res = 720,
+        .v_res = 720,
+        .hsync_pulse_width = 2,
+        .hsync_back_porch = 44,
+        .hsync_front_porch = 46,
+        .vsync_pulse_width = 5,
+        .vsync_back_porch = 15,
+        .vsync_front_porch = 16,
+        .flags.pclk_active_neg = true,
+    },
+    .io = {
+        .spi_mode = 0,
+        .cmd_bytes = 1,
+        .param_bytes = 1,
+    },
+    .init_seq = rgb_lcd_init_seq,
+    .init_seq_size = sizeof(rgb_lcd_init_seq),
+    .new_panel = panel_nv3052_desc_new,
+};
+
 #endif
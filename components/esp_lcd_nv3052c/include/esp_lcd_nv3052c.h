@@ -10,9 +10,11 @@
 
 #include "hal/lcd_types.h"
 #include "esp_lcd_panel_vendor.h"
+#include "lcd_init_seq.h"
 
 #if SOC_LCD_RGB_SUPPORTED
 #include "esp_lcd_panel_rgb.h"
+#include "lcd_panel_registry.h"
 #endif
 
 #if SOC_MIPI_DSI_SUPPORTED
@@ -38,12 +40,7 @@ extern "C" {
  * @brief LCD panel initialization commands.
  *
  */
-typedef struct {
-    int cmd;                /*<! The specific LCD command */
-    const void *data;       /*<! Buffer that holds the command specific data */
-    size_t data_bytes;      /*<! Size of `data` in memory, in bytes */
-    unsigned int delay_ms;  /*<! Delay in milliseconds after this command */
-} nv3052_lcd_init_cmd_t;
+typedef lcd_init_seq_cmd_t nv3052_lcd_init_cmd_t;
 
 /**
  * @brief LCD panel vendor configuration.
@@ -83,6 +80,11 @@ typedef struct {
              *   Please set it to 1 to release the panel IO and its pins (except CS signal).
              *   This flag is only valid for the RGB interface.
              */
+        unsigned int warm_restart: 1;               /*<! Skip the panel reset and initialization sequence after a software reset
+                                                     *   if the panel kept its configuration. The panel must stay powered while
+                                                     *   the chip restarts, the RST pad is held inactive from init on.
+                                                     *   Can't be used with `enable_io_multiplex`.
+                                                     */
     } flags;
 } nv3052_vendor_config_t;
 
@@ -103,6 +105,13 @@ typedef struct {
  */
 esp_err_t esp_lcd_new_panel_nv3052(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel);
 esp_err_t esp_lcd_new_panel_nv3052_rgb(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config,esp_lcd_panel_handle_t *ret_panel);
+
+#if SOC_LCD_RGB_SUPPORTED
+/**
+ * @brief The 720x720 NV3052C panel, with its timings, to register with `lcd_panel_registry_add()`.
+ */
+extern const lcd_panel_desc_t nv3052_panel_desc;
+#endif
 /**
  * @brief 3-wire SPI panel IO configuration structure
  *
@@ -4,9 +4,11 @@
 
 #include "hal/lcd_types.h"
 #include "esp_lcd_panel_vendor.h"
+#include "lcd_init_seq.h"
 
 #if SOC_LCD_RGB_SUPPORTED
 #include "esp_lcd_panel_rgb.h"
+#include "lcd_panel_registry.h"
 #endif
 
 #ifdef __cplusplus
@@ -17,12 +19,7 @@ extern "C" {
  * @brief LCD panel initialization cmds.
  * 
  */
-typedef struct{
-    int cmd;
-    const void* data;
-    size_t data_bytes;
-    unsigned int delay_ms;
-} h040a18_lcd_init_cmd_t;
+typedef lcd_init_seq_cmd_t h040a18_lcd_init_cmd_t;
 
 typedef struct{
     const h040a18_lcd_init_cmd_t *init_cmds;
@@ -39,6 +36,8 @@ typedef struct{
             unsigned int auto_del_panel_io: 1;
             unsigned int enable_io_multiplex: 1;
         };
+        unsigned int warm_restart: 1;   /*<! Skip the panel reset and init sequence after a software reset, if the panel kept its configuration.
+                                         *   The RST pad is held after init so it stays inactive while the chip restarts */
     }flags;
 }h040a18_vendor_config_t;
 
@@ -59,6 +58,13 @@ typedef struct{
  */
 esp_err_t esp_lcd_new_panel_h040a18(const esp_lcd_panel_io_handle_t io_handle,const esp_lcd_panel_dev_config_t *panel_dev_config,esp_lcd_panel_handle_t *ret_panel);
 
+#if SOC_LCD_RGB_SUPPORTED
+/**
+ * @brief The 400x960 H040A18 panel, with its timings, to register with `lcd_panel_registry_add()`.
+ */
+extern const lcd_panel_desc_t h040a18_panel_desc;
+#endif
+
 /**
  * @brief 3-wire SPI panel IO configuration structure
  *
@@ -1,6 +1,7 @@
 #include "soc/soc_caps.h"
 
 #if SOC_LCD_RGB_SUPPORTED
+#include <stdlib.h>
 #include "driver/gpio.h"
 #include "esp_check.h"
 #include "esp_lcd_panel_commands.h"
@@ -26,6 +27,8 @@ typedef struct {
         unsigned int enable_io_multiplex : 1;
         unsigned int display_on_off_use_cmd : 1;
         unsigned int reset_level : 1;
+        unsigned int warm_restart : 1;
+        unsigned int warm : 1; // the panel kept its configuration, reset and init only restart the RGB side
     } flags;
 
     esp_err_t (*init)(esp_lcd_panel_t *panel);
@@ -50,12 +53,17 @@ esp_err_t esp_lcd_new_panel_h040a18(const esp_lcd_panel_io_handle_t io_handle, c
     h040a18_vendor_config_t *vendor_config = (h040a18_vendor_config_t *)panel_dev_config->vendor_config;
     ESP_RETURN_ON_FALSE(vendor_config && vendor_config->rgb_config, ESP_ERR_INVALID_ARG, TAG, "`vendor_config` and `rgb_config` are necessary");
     ESP_RETURN_ON_FALSE(!vendor_config->flags.enable_io_multiplex || !vendor_config->flags.mirror_by_cmd, ESP_ERR_INVALID_ARG, TAG, "`mirror_by_cmd` and `enable_io_multiplex` can't work together");
+    ESP_RETURN_ON_FALSE(!vendor_config->flags.enable_io_multiplex || !vendor_config->flags.warm_restart, ESP_ERR_INVALID_ARG, TAG, "`warm_restart` and `enable_io_multiplex` can't work together");
 
     esp_err_t ret = ESP_OK;
     h040a18_panel_t *h040a18 = (h040a18_panel_t *)calloc(1, sizeof(h040a18_panel_t));
     ESP_RETURN_ON_FALSE(h040a18, ESP_ERR_NO_MEM, TAG, "no mem for h040a18 panel");
 
     if (panel_dev_config->reset_gpio_num >= 0) {
+        if (vendor_config->flags.warm_restart) {
+            // inactive from the moment it becomes an output, a glitch would reset the panel
+            gpio_set_level(panel_dev_config->reset_gpio_num, !panel_dev_config->flags.reset_active_high);
+        }
         gpio_config_t io_config = {
             .mode = GPIO_MODE_OUTPUT,
             .pin_bit_mask = 1ULL << panel_dev_config->reset_gpio_num,
@@ -71,6 +79,7 @@ esp_err_t esp_lcd_new_panel_h040a18(const esp_lcd_panel_io_handle_t io_handle, c
     h040a18->flags.display_on_off_use_cmd = (vendor_config->rgb_config->disp_gpio_num >= 0) ? 0 : 1;
     h040a18->flags.enable_io_multiplex = vendor_config->flags.enable_io_multiplex;
     h040a18->flags.reset_level = panel_dev_config->flags.reset_active_high;
+    h040a18->flags.warm_restart = vendor_config->flags.warm_restart;
 
     if (h040a18->flags.enable_io_multiplex) {
         if (h040a18->reset_gpio_num >= 0) {
@@ -116,78 +125,74 @@ err:
     return ret;
 }
 
-static const h040a18_lcd_init_cmd_t rgb_lcd_init_cmds [] = {
-    {0x3A, (uint8_t []){0x77}, 1, 0},
-    {0x36, (uint8_t []){0x00}, 1, 0},
-    // {0x36, (uint8_t []){0x10}, 1, 0}, //vertical direction reverse
-    {0xFF, (uint8_t []){0x77, 0x01, 0x00, 0x00, 0x13}, 5, 0},
-    {0xEF, (uint8_t []){0x08}, 1, 0},
-    {0xFF, (uint8_t []){0x77, 0x01, 0x00, 0x00, 0x10}, 5, 0},
-    {0xC0, (uint8_t []){0x77, 0x00}, 2, 0},
-    {0xC1, (uint8_t []){0x0E, 0x0C}, 2, 0},
-    {0xC2, (uint8_t []){0x07, 0x02}, 2, 0},
-    {0xCC, (uint8_t []){0x30}, 1, 0},
-    {0xB0, (uint8_t []){0x00, 0x13, 0x1E, 0x0D, 0x11, 0x06, 0x0F, 0x07, 0x0F, 0x2C, 0x05, 0x17, 0x1E, 0x2D, 0x34, 0x1D}, 16, 0},
-    {0xB1, (uint8_t []){0x00, 0x1A, 0x1F, 0x0F, 0x12, 0x08, 0x0B, 0x0A, 0x03, 0x22, 0x03, 0x0F, 0x09, 0x28, 0x33, 0x1F}, 16, 0},
-    {0xFF, (uint8_t []){0x77, 0x01, 0x00, 0x00, 0x11}, 5, 0},
-    {0xB0, (uint8_t []){0x5C}, 1, 0},
-    {0xB1, (uint8_t []){0x69}, 1, 0},
-    {0xB2, (uint8_t []){0x87}, 1, 0},
-    {0xB3, (uint8_t []){0x80}, 1, 0},
-    {0xB5, (uint8_t []){0x4A}, 1, 0},
-    {0xB7, (uint8_t []){0x85}, 1, 0},
-    {0xB8, (uint8_t []){0x48}, 1, 0},
-    {0xB9, (uint8_t []){0x10, 0x1F}, 2, 0},
-    {0xBB, (uint8_t []){0x03}, 1, 0},
-    {0xC0, (uint8_t []){0x80}, 1, 0},
-    {0xC1, (uint8_t []){0x08}, 1, 0},
-    {0xC2, (uint8_t []){0x08}, 1, 0},
-    // {0xC3, (uint8_t []){0x80, 0x10, 0x18}, 1, 0}, // RGBCTRL
-    {0xD0, (uint8_t []){0x88}, 1, 0},
-    {0xE0, (uint8_t []){0x00, 0x00, 0x02, 0x00, 0x00, 0x0C}, 6, 0},
-    {0xE1, (uint8_t []){0x03, 0x96, 0x05, 0x96, 0x02, 0x96, 0x04, 0x96, 0x00, 0x44, 0x44}, 11, 0},
-    {0xE2, (uint8_t []){0x00, 0x00, 0x03, 0x03, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00}, 12, 0},
-    {0xE3, (uint8_t []){0x00, 0x00, 0x33, 0x33}, 4, 0},
-    {0xE4, (uint8_t []){0x44, 0x44}, 2, 0},
-    {0xE5, (uint8_t []){0x0B, 0xD4, 0x28, 0x8C, 0x0D, 0xD6, 0x28, 0x8C, 0x07, 0xD0, 0x28, 0x8C, 0x09, 0xD2, 0x28, 0x8C}, 16, 0},
-    {0xE6, (uint8_t []){0x00, 0x00, 0x33, 0x33}, 4, 0},
-    {0xE7, (uint8_t []){0x44, 0x44}, 2, 0},
-    {0xE8, (uint8_t []){0x0A, 0xD5, 0x28, 0x8C, 0x0C, 0xD7, 0x28, 0x8C, 0x06, 0xD1, 0x28, 0x8C, 0x08, 0xD3, 0x28, 0x8C}, 16, 0},
-    {0xEB, (uint8_t []){0x00, 0x01, 0xE4, 0xE4, 0x44, 0x00}, 6, 0},
-    {0xED, (uint8_t []){0xFF, 0x45, 0x67, 0xFC, 0x01, 0x3F, 0xAB, 0xFF, 0xFF, 0xBA, 0xF3, 0x10, 0xCF, 0x76, 0x54, 0xFF}, 16, 0},
-    {0xEF, (uint8_t []){0x10, 0x0D, 0x04, 0x08, 0x3F, 0x1F}, 6, 0},
-    {0xFF, (uint8_t []){0x77, 0x01, 0x00, 0x00, 0x13}, 5, 0},
-    {0xE8, (uint8_t []){0x00, 0x0E}, 2, 0},
-
-    {0x11, (uint8_t []){0x00}, 0, 120},
-
-    {0xE8, (uint8_t []){0x00, 0x0C}, 2, 20},
-    {0xE8, (uint8_t []){0x40, 0x00}, 2, 0},
-    {0xFF, (uint8_t []){0x77, 0x01, 0x00, 0x00, 0x00}, 5, 0},
-    {0x35, (uint8_t []){0x00}, 1, 0},
-
-    {0x29, (uint8_t []){0x00}, 0, 20},
+static const uint8_t rgb_lcd_init_seq[] = {
+    LCD_INIT_SEQ_CMD(0x3A, 0, 0x77),
+    LCD_INIT_SEQ_CMD(0x36, 0, 0x00),
+    // LCD_INIT_SEQ_CMD(0x36, 0, 0x10), //vertical direction reverse
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x77, 0x01, 0x00, 0x00, 0x13),
+    LCD_INIT_SEQ_CMD(0xEF, 0, 0x08),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x77, 0x01, 0x00, 0x00, 0x10),
+    LCD_INIT_SEQ_CMD(0xC0, 0, 0x77, 0x00),
+    LCD_INIT_SEQ_CMD(0xC1, 0, 0x0E, 0x0C),
+    LCD_INIT_SEQ_CMD(0xC2, 0, 0x07, 0x02),
+    LCD_INIT_SEQ_CMD(0xCC, 0, 0x30),
+    LCD_INIT_SEQ_CMD(0xB0, 0, 0x00, 0x13, 0x1E, 0x0D, 0x11, 0x06, 0x0F, 0x07, 0x0F, 0x2C, 0x05, 0x17, 0x1E, 0x2D, 0x34, 0x1D),
+    LCD_INIT_SEQ_CMD(0xB1, 0, 0x00, 0x1A, 0x1F, 0x0F, 0x12, 0x08, 0x0B, 0x0A, 0x03, 0x22, 0x03, 0x0F, 0x09, 0x28, 0x33, 0x1F),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x77, 0x01, 0x00, 0x00, 0x11),
+    LCD_INIT_SEQ_CMD(0xB0, 0, 0x5C),
+    LCD_INIT_SEQ_CMD(0xB1, 0, 0x69),
+    LCD_INIT_SEQ_CMD(0xB2, 0, 0x87),
+    LCD_INIT_SEQ_CMD(0xB3, 0, 0x80),
+    LCD_INIT_SEQ_CMD(0xB5, 0, 0x4A),
+    LCD_INIT_SEQ_CMD(0xB7, 0, 0x85),
+    LCD_INIT_SEQ_CMD(0xB8, 0, 0x48),
+    LCD_INIT_SEQ_CMD(0xB9, 0, 0x10, 0x1F),
+    LCD_INIT_SEQ_CMD(0xBB, 0, 0x03),
+    LCD_INIT_SEQ_CMD(0xC0, 0, 0x80),
+    LCD_INIT_SEQ_CMD(0xC1, 0, 0x08),
+    LCD_INIT_SEQ_CMD(0xC2, 0, 0x08),
+    // LCD_INIT_SEQ_CMD(0xC3, 0, 0x80), // RGBCTRL
+    LCD_INIT_SEQ_CMD(0xD0, 0, 0x88),
+    LCD_INIT_SEQ_CMD(0xE0, 0, 0x00, 0x00, 0x02, 0x00, 0x00, 0x0C),
+    LCD_INIT_SEQ_CMD(0xE1, 0, 0x03, 0x96, 0x05, 0x96, 0x02, 0x96, 0x04, 0x96, 0x00, 0x44, 0x44),
+    LCD_INIT_SEQ_CMD(0xE2, 0, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00),
+    LCD_INIT_SEQ_CMD(0xE3, 0, 0x00, 0x00, 0x33, 0x33),
+    LCD_INIT_SEQ_CMD(0xE4, 0, 0x44, 0x44),
+    LCD_INIT_SEQ_CMD(0xE5, 0, 0x0B, 0xD4, 0x28, 0x8C, 0x0D, 0xD6, 0x28, 0x8C, 0x07, 0xD0, 0x28, 0x8C, 0x09, 0xD2, 0x28, 0x8C),
+    LCD_INIT_SEQ_CMD(0xE6, 0, 0x00, 0x00, 0x33, 0x33),
+    LCD_INIT_SEQ_CMD(0xE7, 0, 0x44, 0x44),
+    LCD_INIT_SEQ_CMD(0xE8, 0, 0x0A, 0xD5, 0x28, 0x8C, 0x0C, 0xD7, 0x28, 0x8C, 0x06, 0xD1, 0x28, 0x8C, 0x08, 0xD3, 0x28, 0x8C),
+    LCD_INIT_SEQ_CMD(0xEB, 0, 0x00, 0x01, 0xE4, 0xE4, 0x44, 0x00),
+    LCD_INIT_SEQ_CMD(0xED, 0, 0xFF, 0x45, 0x67, 0xFC, 0x01, 0x3F, 0xAB, 0xFF, 0xFF, 0xBA, 0xF3, 0x10, 0xCF, 0x76, 0x54, 0xFF),
+    LCD_INIT_SEQ_CMD(0xEF, 0, 0x10, 0x0D, 0x04, 0x08, 0x3F, 0x1F),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x77, 0x01, 0x00, 0x00, 0x13),
+    LCD_INIT_SEQ_CMD(0xE8, 0, 0x00, 0x0E),
+
+    LCD_INIT_SEQ_CMD(0x11, 120),
+
+    LCD_INIT_SEQ_CMD(0xE8, 20, 0x00, 0x0C),
+    LCD_INIT_SEQ_CMD(0xE8, 0, 0x40, 0x00),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x77, 0x01, 0x00, 0x00, 0x00),
+    LCD_INIT_SEQ_CMD(0x35, 0, 0x00),
+
+    LCD_INIT_SEQ_CMD(0x29, 20),
 };
 
+static uint32_t panel_h040a18_init_seq_checksum(h040a18_panel_t *h040a18) {
+    if (h040a18->init_cmds) {
+        return lcd_init_seq_checksum(h040a18->init_cmds, h040a18->init_cmds_size);
+    }
+    return lcd_init_seq_checksum_packed(rgb_lcd_init_seq, sizeof(rgb_lcd_init_seq));
+}
+
 static esp_err_t panel_h040a18_send_init_cmds(h040a18_panel_t *h040a18) {
     esp_lcd_panel_io_handle_t io_handle = h040a18->io_handle;
-    const h040a18_lcd_init_cmd_t *init_cmds = NULL;
-    uint16_t init_cmds_size = 0;
 
+    /*  Send Initialization Commands, with real waits only where the sequence asks for them  */
     if (h040a18->init_cmds) {
-        init_cmds = h040a18->init_cmds;
-        init_cmds_size = h040a18->init_cmds_size;
+        ESP_RETURN_ON_ERROR(lcd_init_seq_send(io_handle, h040a18->init_cmds, h040a18->init_cmds_size, NULL), TAG, "send Initialization commands failed");
     } else {
-        init_cmds = rgb_lcd_init_cmds;
-        init_cmds_size = sizeof(rgb_lcd_init_cmds) / sizeof(h040a18_lcd_init_cmd_t);
-    }
-
-    for (int i = 0; i < init_cmds_size; i++) {
-        /*  Send Initialization Commands   */
-        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io_handle, init_cmds [i].cmd, init_cmds [i].data, init_cmds [i].data_bytes), TAG, "send Initialization commands failed");
-        vTaskDelay(pdMS_TO_TICKS(init_cmds [i].delay_ms));
-
-        ESP_LOGW(TAG, "send commands %d/%d", i, init_cmds_size);
+        ESP_RETURN_ON_ERROR(lcd_init_seq_send_packed(io_handle, rgb_lcd_init_seq, sizeof(rgb_lcd_init_seq), NULL), TAG, "send Initialization commands failed");
     }
     ESP_LOGI(TAG, "send initialization cmds success");
 
@@ -196,11 +201,21 @@ static esp_err_t panel_h040a18_send_init_cmds(h040a18_panel_t *h040a18) {
 
 static esp_err_t panel_h040a18_init(esp_lcd_panel_t *panel) {
     h040a18_panel_t *h040a18 = (h040a18_panel_t *)panel->user_data;
-    if (!h040a18->flags.enable_io_multiplex) {
+    if (!h040a18->flags.enable_io_multiplex && !h040a18->flags.warm) {
+        if (h040a18->flags.warm_restart) {
+            lcd_init_seq_warm_invalidate();
+        }
         ESP_RETURN_ON_ERROR(panel_h040a18_send_init_cmds(h040a18), TAG, "send init cmds failed");
+        if (h040a18->flags.warm_restart) {
+            lcd_init_seq_warm_save(panel_h040a18_init_seq_checksum(h040a18), h040a18->madctl_val, h040a18->colmod_val);
+        }
     }
     /*  Init RGB panel  */
     ESP_RETURN_ON_ERROR(h040a18->init(panel), TAG, "init RGB panel failed");
+    if (h040a18->flags.warm_restart && h040a18->reset_gpio_num >= 0) {
+        // the pad keeps its level through the software reset, RST can't glitch while the chip restarts
+        gpio_hold_en(h040a18->reset_gpio_num);
+    }
 
     return ESP_OK;
 }
@@ -208,6 +223,7 @@ static esp_err_t panel_h040a18_del(esp_lcd_panel_t *panel) {
     h040a18_panel_t *h040a18 = (h040a18_panel_t *)panel->user_data;
 
     if (h040a18->reset_gpio_num >= 0) {
+        gpio_hold_dis(h040a18->reset_gpio_num);
         gpio_reset_pin(h040a18->reset_gpio_num);
     }
     /*  Delete RGB panel  */
@@ -220,8 +236,21 @@ static esp_err_t panel_h040a18_reset(esp_lcd_panel_t *panel) {
     h040a18_panel_t *h040a18 = (h040a18_panel_t *)panel->user_data;
     esp_lcd_panel_io_handle_t io_handle = h040a18->io_handle;
 
+    if (h040a18->flags.warm_restart) {
+        if (lcd_init_seq_warm_restore(panel_h040a18_init_seq_checksum(h040a18), &h040a18->madctl_val, &h040a18->colmod_val)) {
+            // the panel stayed powered and configured across a software reset
+            h040a18->flags.warm = 1;
+            ESP_LOGI(TAG, "panel kept its configuration, skip reset and init sequence");
+            return h040a18->reset(panel);
+        }
+        // a panel reset and not initialized again must never be trusted after the next restart
+        lcd_init_seq_warm_invalidate();
+    }
+
     /*  Perform hardware reset  */
     if (h040a18->reset_gpio_num >= 0) {
+        // held since the last init, a held pad ignores the level
+        gpio_hold_dis(h040a18->reset_gpio_num);
         gpio_set_level(h040a18->reset_gpio_num, h040a18->flags.reset_level);
         vTaskDelay(pdMS_TO_TICKS(10));
         gpio_set_level(h040a18->reset_gpio_num, !h040a18->flags.reset_level);
@@ -287,4 +316,47 @@ static esp_err_t panel_h040a18_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
     return ESP_OK;
 }
 
+static esp_err_t panel_h040a18_desc_new(esp_lcd_panel_io_handle_t io, const lcd_panel_new_config_t *config,
+                                        esp_lcd_panel_handle_t *ret_panel)
+{
+    h040a18_vendor_config_t vendor_config = {
+        .rgb_config = config->rgb_config,
+        .flags = {
+            .mirror_by_cmd = config->flags.mirror_by_cmd,
+            .warm_restart = config->flags.warm_restart,
+        },
+    };
+    esp_lcd_panel_dev_config_t panel_dev_config = {
+        .reset_gpio_num = config->reset_gpio_num,
+        .rgb_ele_order = LCD_RGB_ELEMENT_ORDER_RGB,
+        .bits_per_pixel = 16,
+        .vendor_config = &vendor_config,
+    };
+    return esp_lcd_new_panel_h040a18(io, &panel_dev_config, ret_panel);
+}
+
+const lcd_panel_desc_t h040a18_panel_desc = {
+    .name = "h040a18",
+    .timings = {
+        .pclk_hz = 20 * 1000 * 1000,
+        .h_res = 400,
+        .v_res = 960,
+        .hsync_pulse_width = 8,
+        .hsync_back_porch = 50,
+        .hsync_front_porch = 50,
+        .vsync_pulse_width = 8,
+        .vsync_back_porch = 20,
+        .vsync_front_porch = 20,
+        .flags.pclk_active_neg = true,
+    },
+    .io = {
+        .spi_mode = 0,
+        .cmd_bytes = 1,
+        .param_bytes = 1,
+    },
+    .init_seq = rgb_lcd_init_seq,
+    .init_seq_size = sizeof(rgb_lcd_init_seq),
+    .new_panel = panel_h040a18_desc_new,
+};
+
 #endif
@@ -1,6 +1,7 @@
 #include "soc/soc_caps.h"
 
 #if SOC_LCD_RGB_SUPPORTED
+#include <stdlib.h>
 #include "driver/gpio.h"
 #include "esp_check.h"
 #include "esp_lcd_panel_commands.h"
@@ -26,6 +27,8 @@ typedef struct {
         unsigned int enable_io_multiplex : 1;
         unsigned int display_on_off_use_cmd : 1;
         unsigned int reset_level : 1;
+        unsigned int warm_restart : 1;
+        unsigned int warm : 1; // the panel kept its configuration, reset and init only restart the RGB side
     } flags;
 
     esp_err_t (*init)(esp_lcd_panel_t *panel);
@@ -50,12 +53,17 @@ esp_err_t esp_lcd_new_panel_h035a17(const esp_lcd_panel_io_handle_t io_handle, c
     h035a17_vendor_config_t *vendor_config = (h035a17_vendor_config_t *)panel_dev_config->vendor_config;
     ESP_RETURN_ON_FALSE(vendor_config && vendor_config->rgb_config, ESP_ERR_INVALID_ARG, TAG, "`vendor_config` and `rgb_config` are necessary");
     ESP_RETURN_ON_FALSE(!vendor_config->flags.enable_io_multiplex || !vendor_config->flags.mirror_by_cmd, ESP_ERR_INVALID_ARG, TAG, "`mirror_by_cmd` and `enable_io_multiplex` can't work together");
+    ESP_RETURN_ON_FALSE(!vendor_config->flags.enable_io_multiplex || !vendor_config->flags.warm_restart, ESP_ERR_INVALID_ARG, TAG, "`warm_restart` and `enable_io_multiplex` can't work together");
 
     esp_err_t ret = ESP_OK;
     h035a17_panel_t *h035a17 = (h035a17_panel_t *)calloc(1, sizeof(h035a17_panel_t));
     ESP_RETURN_ON_FALSE(h035a17, ESP_ERR_NO_MEM, TAG, "no mem for h035a17 panel");
 
     if (panel_dev_config->reset_gpio_num >= 0) {
+        if (vendor_config->flags.warm_restart) {
+            // inactive from the moment it becomes an output, a glitch would reset the panel
+            gpio_set_level(panel_dev_config->reset_gpio_num, !panel_dev_config->flags.reset_active_high);
+        }
         gpio_config_t io_config = {
             .mode = GPIO_MODE_OUTPUT,
             .pin_bit_mask = 1ULL << panel_dev_config->reset_gpio_num,
@@ -71,6 +79,7 @@ esp_err_t esp_lcd_new_panel_h035a17(const esp_lcd_panel_io_handle_t io_handle, c
     h035a17->flags.display_on_off_use_cmd = (vendor_config->rgb_config->disp_gpio_num >= 0) ? 0 : 1;
     h035a17->flags.enable_io_multiplex = vendor_config->flags.enable_io_multiplex;
     h035a17->flags.reset_level = panel_dev_config->flags.reset_active_high;
+    h035a17->flags.warm_restart = vendor_config->flags.warm_restart;
 
     if (h035a17->flags.enable_io_multiplex) {
         if (h035a17->reset_gpio_num >= 0) {
@@ -116,221 +125,217 @@ err:
     return ret;
 }
 
-static const h035a17_lcd_init_cmd_t rgb_lcd_init_cmds [] = {
-    {0xFF, (uint8_t []){0x30}, 1, 0},
-    {0xFF, (uint8_t []){0x52}, 1, 0},
-    {0xFF, (uint8_t []){0x01}, 1, 0},
-    {0xE3, (uint8_t []){0x00}, 1, 0},
-    {0x40, (uint8_t []){0x00}, 1, 0},
-    {0x03, (uint8_t []){0x40}, 1, 0},
-    {0x04, (uint8_t []){0x00}, 1, 0},
-    {0x05, (uint8_t []){0x03}, 1, 0},
-    {0x08, (uint8_t []){0x00}, 1, 0},
-    {0x09, (uint8_t []){0x07}, 1, 0},
-    {0x0A, (uint8_t []){0x01}, 1, 0},
-    {0x0B, (uint8_t []){0x32}, 1, 0},
-    {0x0C, (uint8_t []){0x32}, 1, 0},
-    {0x0D, (uint8_t []){0x0B}, 1, 0},
-    {0x0E, (uint8_t []){0x00}, 1, 0},
-    {0x23, (uint8_t []){0xA2}, 1, 0},
-    {0x24, (uint8_t []){0x0c}, 1, 0},
-    {0x25, (uint8_t []){0x06}, 1, 0},
-    {0x26, (uint8_t []){0x14}, 1, 0},
-    {0x27, (uint8_t []){0x14}, 1, 0},
-    {0x38, (uint8_t []){0x9C}, 1, 0},
-    {0x39, (uint8_t []){0xA7}, 1, 0},
-    {0x28, (uint8_t []){0x40}, 1, 0},
-    {0x29, (uint8_t []){0x01}, 1, 0},
-    {0x2A, (uint8_t []){0xdf}, 1, 0},
-    {0x49, (uint8_t []){0x3C}, 1, 0},
-    {0x91, (uint8_t []){0x57}, 1, 0},
-    {0x92, (uint8_t []){0x57}, 1, 0},
-    {0xA0, (uint8_t []){0x55}, 1, 0},
-    {0xA1, (uint8_t []){0x50}, 1, 0},
-    {0xA4, (uint8_t []){0x9C}, 1, 0},
-    {0xA7, (uint8_t []){0x02}, 1, 0},
-    {0xA8, (uint8_t []){0x01}, 1, 0},
-    {0xA9, (uint8_t []){0x01}, 1, 0},
-    {0xAA, (uint8_t []){0xFC}, 1, 0},
-    {0xAB, (uint8_t []){0x28}, 1, 0},
-    {0xAC, (uint8_t []){0x06}, 1, 0},
-    {0xAD, (uint8_t []){0x06}, 1, 0},
-    {0xAE, (uint8_t []){0x06}, 1, 0},
-    {0xAF, (uint8_t []){0x03}, 1, 0},
-    {0xB0, (uint8_t []){0x08}, 1, 0},
-    {0xB1, (uint8_t []){0x26}, 1, 0},
-    {0xB2, (uint8_t []){0x28}, 1, 0},
-    {0xB3, (uint8_t []){0x28}, 1, 0},
-    {0xB4, (uint8_t []){0x03}, 1, 0},
-    {0xB5, (uint8_t []){0x08}, 1, 0},
-    {0xB6, (uint8_t []){0x26}, 1, 0},
-    {0xB7, (uint8_t []){0x08}, 1, 0},
-    {0xB8, (uint8_t []){0x26}, 1, 0},
-    {0xF0, (uint8_t []){0x00}, 1, 0},
-    {0xF6, (uint8_t []){0xC0}, 1, 0},
-    {0xFF, (uint8_t []){0x30}, 1, 0},
-    {0xFF, (uint8_t []){0x52}, 1, 0},
-    {0xFF, (uint8_t []){0x02}, 1, 0},
-    {0xB0, (uint8_t []){0x0B}, 1, 0},
-    {0xB1, (uint8_t []){0x16}, 1, 0},
-    {0xB2, (uint8_t []){0x17}, 1, 0},
-    {0xB3, (uint8_t []){0x2C}, 1, 0},
-    {0xB4, (uint8_t []){0x32}, 1, 0},
-    {0xB5, (uint8_t []){0x3B}, 1, 0},
-    {0xB6, (uint8_t []){0x29}, 1, 0},
-    {0xB7, (uint8_t []){0x40}, 1, 0},
-    {0xB8, (uint8_t []){0x0d}, 1, 0},
-    {0xB9, (uint8_t []){0x05}, 1, 0},
-    {0xBA, (uint8_t []){0x12}, 1, 0},
-    {0xBB, (uint8_t []){0x10}, 1, 0},
-    {0xBC, (uint8_t []){0x12}, 1, 0},
-    {0xBD, (uint8_t []){0x15}, 1, 0},
-    {0xBE, (uint8_t []){0x19}, 1, 0},
-    {0xBF, (uint8_t []){0x0E}, 1, 0},
-    {0xC0, (uint8_t []){0x16}, 1, 0},
-    {0xC1, (uint8_t []){0x0A}, 1, 0},
-    {0xD0, (uint8_t []){0x0C}, 1, 0},
-    {0xD1, (uint8_t []){0x17}, 1, 0},
-    {0xD2, (uint8_t []){0x14}, 1, 0},
-    {0xD3, (uint8_t []){0x2E}, 1, 0},
-    {0xD4, (uint8_t []){0x32}, 1, 0},
-    {0xD5, (uint8_t []){0x3C}, 1, 0},
-    {0xD6, (uint8_t []){0x22}, 1, 0},
-    {0xD7, (uint8_t []){0x3D}, 1, 0},
-    {0xD8, (uint8_t []){0x0D}, 1, 0},
-    {0xD9, (uint8_t []){0x07}, 1, 0},
-    {0xDA, (uint8_t []){0x13}, 1, 0},
-    {0xDB, (uint8_t []){0x13}, 1, 0},
-    {0xDC, (uint8_t []){0x11}, 1, 0},
-    {0xDD, (uint8_t []){0x15}, 1, 0},
-    {0xDE, (uint8_t []){0x19}, 1, 0},
-    {0xDF, (uint8_t []){0x10}, 1, 0},
-    {0xE0, (uint8_t []){0x17}, 1, 0},
-    {0xE1, (uint8_t []){0x0A}, 1, 0},
-    {0xFF, (uint8_t []){0x30}, 1, 0},
-    {0xFF, (uint8_t []){0x52}, 1, 0},
-    {0xFF, (uint8_t []){0x03}, 1, 0},
-    {0x00, (uint8_t []){0x2A}, 1, 0},
-    {0x01, (uint8_t []){0x2A}, 1, 0},
-    {0x02, (uint8_t []){0x2A}, 1, 0},
-    {0x03, (uint8_t []){0x2A}, 1, 0},
-    {0x04, (uint8_t []){0x61}, 1, 0},
-    {0x05, (uint8_t []){0x80}, 1, 0},
-    {0x06, (uint8_t []){0xc7}, 1, 0},
-    {0x07, (uint8_t []){0x01}, 1, 0},
-    {0x08, (uint8_t []){0x03}, 1, 0},
-    {0x09, (uint8_t []){0x04}, 1, 0},
-    {0x70, (uint8_t []){0x22}, 1, 0},
-    {0x71, (uint8_t []){0x80}, 1, 0},
-    {0x30, (uint8_t []){0x2A}, 1, 0},
-    {0x31, (uint8_t []){0x2A}, 1, 0},
-    {0x32, (uint8_t []){0x2A}, 1, 0},
-    {0x33, (uint8_t []){0x2A}, 1, 0},
-    {0x34, (uint8_t []){0x61}, 1, 0},
-    {0x35, (uint8_t []){0xc5}, 1, 0},
-    {0x36, (uint8_t []){0x80}, 1, 0},
-    {0x37, (uint8_t []){0x23}, 1, 0},
-    {0x40, (uint8_t []){0x03}, 1, 0},
-    {0x41, (uint8_t []){0x04}, 1, 0},
-    {0x42, (uint8_t []){0x05}, 1, 0},
-    {0x43, (uint8_t []){0x06}, 1, 0},
-    {0x44, (uint8_t []){0x11}, 1, 0},
-    {0x45, (uint8_t []){0xe8}, 1, 0},
-    {0x46, (uint8_t []){0xe9}, 1, 0},
-    {0x47, (uint8_t []){0x11}, 1, 0},
-    {0x48, (uint8_t []){0xea}, 1, 0},
-    {0x49, (uint8_t []){0xeb}, 1, 0},
-    {0x50, (uint8_t []){0x07}, 1, 0},
-    {0x51, (uint8_t []){0x08}, 1, 0},
-    {0x52, (uint8_t []){0x09}, 1, 0},
-    {0x53, (uint8_t []){0x0a}, 1, 0},
-    {0x54, (uint8_t []){0x11}, 1, 0},
-    {0x55, (uint8_t []){0xec}, 1, 0},
-    {0x56, (uint8_t []){0xed}, 1, 0},
-    {0x57, (uint8_t []){0x11}, 1, 0},
-    {0x58, (uint8_t []){0xef}, 1, 0},
-    {0x59, (uint8_t []){0xf0}, 1, 0},
-    {0xB1, (uint8_t []){0x01}, 1, 0},
-    {0xB4, (uint8_t []){0x15}, 1, 0},
-    {0xB5, (uint8_t []){0x16}, 1, 0},
-    {0xB6, (uint8_t []){0x09}, 1, 0},
-    {0xB7, (uint8_t []){0x0f}, 1, 0},
-    {0xB8, (uint8_t []){0x0d}, 1, 0},
-    {0xB9, (uint8_t []){0x0b}, 1, 0},
-    {0xBA, (uint8_t []){0x00}, 1, 0},
-    {0xC7, (uint8_t []){0x02}, 1, 0},
-    {0xCA, (uint8_t []){0x17}, 1, 0},
-    {0xCB, (uint8_t []){0x18}, 1, 0},
-    {0xCC, (uint8_t []){0x0a}, 1, 0},
-    {0xCD, (uint8_t []){0x10}, 1, 0},
-    {0xCE, (uint8_t []){0x0e}, 1, 0},
-    {0xCF, (uint8_t []){0x0c}, 1, 0},
-    {0xD0, (uint8_t []){0x00}, 1, 0},
-    {0x81, (uint8_t []){0x00}, 1, 0},
-    {0x84, (uint8_t []){0x15}, 1, 0},
-    {0x85, (uint8_t []){0x16}, 1, 0},
-    {0x86, (uint8_t []){0x10}, 1, 0},
-    {0x87, (uint8_t []){0x0a}, 1, 0},
-    {0x88, (uint8_t []){0x0c}, 1, 0},
-    {0x89, (uint8_t []){0x0e}, 1, 0},
-    {0x8A, (uint8_t []){0x02}, 1, 0},
-    {0x97, (uint8_t []){0x00}, 1, 0},
-    {0x9A, (uint8_t []){0x17}, 1, 0},
-    {0x9B, (uint8_t []){0x18}, 1, 0},
-    {0x9C, (uint8_t []){0x0f}, 1, 0},
-    {0x9D, (uint8_t []){0x09}, 1, 0},
-    {0x9E, (uint8_t []){0x0b}, 1, 0},
-    {0x9F, (uint8_t []){0x0d}, 1, 0},
-    {0xA0, (uint8_t []){0x01}, 1, 0},
-    {0xFF, (uint8_t []){0x30}, 1, 0},
-    {0xFF, (uint8_t []){0x52}, 1, 0},
-    {0xFF, (uint8_t []){0x02}, 1, 0},
-    {0x01, (uint8_t []){0x01}, 1, 0},
-    {0x02, (uint8_t []){0xDA}, 1, 0},
-    {0x03, (uint8_t []){0xBA}, 1, 0},
-    {0x04, (uint8_t []){0xA8}, 1, 0},
-    {0x05, (uint8_t []){0x9A}, 1, 0},
-    {0x06, (uint8_t []){0x70}, 1, 0},
-    {0x07, (uint8_t []){0xFF}, 1, 0},
-    {0x08, (uint8_t []){0x91}, 1, 0},
-    {0x09, (uint8_t []){0x90}, 1, 0},
-    {0x0A, (uint8_t []){0xFF}, 1, 0},
-    {0x0B, (uint8_t []){0x8F}, 1, 0},
-    {0x0C, (uint8_t []){0x60}, 1, 0},
-    {0x0D, (uint8_t []){0x58}, 1, 0},
-    {0x0E, (uint8_t []){0x48}, 1, 0},
-    {0x0F, (uint8_t []){0x38}, 1, 0},
-    {0x10, (uint8_t []){0x2B}, 1, 0},
-    {0xFF, (uint8_t []){0x30}, 1, 0},
-    {0xFF, (uint8_t []){0x52}, 1, 0},
-    {0xFF, (uint8_t []){0x00}, 1, 0},
-    {0x3A, (uint8_t []){0x77}, 1, 0},//RGB 565 format
-    {0x36, (uint8_t []){0x0a}, 1, 0},
-
-    {0x11, (uint8_t []){0x00}, 0, 200},
-
-    {0x29, (uint8_t []){0x00}, 0, 20},
+static const uint8_t rgb_lcd_init_seq[] = {
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x30),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x52),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0xE3, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x40, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x03, 0, 0x40),
+    LCD_INIT_SEQ_CMD(0x04, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x05, 0, 0x03),
+    LCD_INIT_SEQ_CMD(0x08, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x09, 0, 0x07),
+    LCD_INIT_SEQ_CMD(0x0A, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0x0B, 0, 0x32),
+    LCD_INIT_SEQ_CMD(0x0C, 0, 0x32),
+    LCD_INIT_SEQ_CMD(0x0D, 0, 0x0B),
+    LCD_INIT_SEQ_CMD(0x0E, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x23, 0, 0xA2),
+    LCD_INIT_SEQ_CMD(0x24, 0, 0x0c),
+    LCD_INIT_SEQ_CMD(0x25, 0, 0x06),
+    LCD_INIT_SEQ_CMD(0x26, 0, 0x14),
+    LCD_INIT_SEQ_CMD(0x27, 0, 0x14),
+    LCD_INIT_SEQ_CMD(0x38, 0, 0x9C),
+    LCD_INIT_SEQ_CMD(0x39, 0, 0xA7),
+    LCD_INIT_SEQ_CMD(0x28, 0, 0x40),
+    LCD_INIT_SEQ_CMD(0x29, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0x2A, 0, 0xdf),
+    LCD_INIT_SEQ_CMD(0x49, 0, 0x3C),
+    LCD_INIT_SEQ_CMD(0x91, 0, 0x57),
+    LCD_INIT_SEQ_CMD(0x92, 0, 0x57),
+    LCD_INIT_SEQ_CMD(0xA0, 0, 0x55),
+    LCD_INIT_SEQ_CMD(0xA1, 0, 0x50),
+    LCD_INIT_SEQ_CMD(0xA4, 0, 0x9C),
+    LCD_INIT_SEQ_CMD(0xA7, 0, 0x02),
+    LCD_INIT_SEQ_CMD(0xA8, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0xA9, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0xAA, 0, 0xFC),
+    LCD_INIT_SEQ_CMD(0xAB, 0, 0x28),
+    LCD_INIT_SEQ_CMD(0xAC, 0, 0x06),
+    LCD_INIT_SEQ_CMD(0xAD, 0, 0x06),
+    LCD_INIT_SEQ_CMD(0xAE, 0, 0x06),
+    LCD_INIT_SEQ_CMD(0xAF, 0, 0x03),
+    LCD_INIT_SEQ_CMD(0xB0, 0, 0x08),
+    LCD_INIT_SEQ_CMD(0xB1, 0, 0x26),
+    LCD_INIT_SEQ_CMD(0xB2, 0, 0x28),
+    LCD_INIT_SEQ_CMD(0xB3, 0, 0x28),
+    LCD_INIT_SEQ_CMD(0xB4, 0, 0x03),
+    LCD_INIT_SEQ_CMD(0xB5, 0, 0x08),
+    LCD_INIT_SEQ_CMD(0xB6, 0, 0x26),
+    LCD_INIT_SEQ_CMD(0xB7, 0, 0x08),
+    LCD_INIT_SEQ_CMD(0xB8, 0, 0x26),
+    LCD_INIT_SEQ_CMD(0xF0, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0xF6, 0, 0xC0),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x30),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x52),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x02),
+    LCD_INIT_SEQ_CMD(0xB0, 0, 0x0B),
+    LCD_INIT_SEQ_CMD(0xB1, 0, 0x16),
+    LCD_INIT_SEQ_CMD(0xB2, 0, 0x17),
+    LCD_INIT_SEQ_CMD(0xB3, 0, 0x2C),
+    LCD_INIT_SEQ_CMD(0xB4, 0, 0x32),
+    LCD_INIT_SEQ_CMD(0xB5, 0, 0x3B),
+    LCD_INIT_SEQ_CMD(0xB6, 0, 0x29),
+    LCD_INIT_SEQ_CMD(0xB7, 0, 0x40),
+    LCD_INIT_SEQ_CMD(0xB8, 0, 0x0d),
+    LCD_INIT_SEQ_CMD(0xB9, 0, 0x05),
+    LCD_INIT_SEQ_CMD(0xBA, 0, 0x12),
+    LCD_INIT_SEQ_CMD(0xBB, 0, 0x10),
+    LCD_INIT_SEQ_CMD(0xBC, 0, 0x12),
+    LCD_INIT_SEQ_CMD(0xBD, 0, 0x15),
+    LCD_INIT_SEQ_CMD(0xBE, 0, 0x19),
+    LCD_INIT_SEQ_CMD(0xBF, 0, 0x0E),
+    LCD_INIT_SEQ_CMD(0xC0, 0, 0x16),
+    LCD_INIT_SEQ_CMD(0xC1, 0, 0x0A),
+    LCD_INIT_SEQ_CMD(0xD0, 0, 0x0C),
+    LCD_INIT_SEQ_CMD(0xD1, 0, 0x17),
+    LCD_INIT_SEQ_CMD(0xD2, 0, 0x14),
+    LCD_INIT_SEQ_CMD(0xD3, 0, 0x2E),
+    LCD_INIT_SEQ_CMD(0xD4, 0, 0x32),
+    LCD_INIT_SEQ_CMD(0xD5, 0, 0x3C),
+    LCD_INIT_SEQ_CMD(0xD6, 0, 0x22),
+    LCD_INIT_SEQ_CMD(0xD7, 0, 0x3D),
+    LCD_INIT_SEQ_CMD(0xD8, 0, 0x0D),
+    LCD_INIT_SEQ_CMD(0xD9, 0, 0x07),
+    LCD_INIT_SEQ_CMD(0xDA, 0, 0x13),
+    LCD_INIT_SEQ_CMD(0xDB, 0, 0x13),
+    LCD_INIT_SEQ_CMD(0xDC, 0, 0x11),
+    LCD_INIT_SEQ_CMD(0xDD, 0, 0x15),
+    LCD_INIT_SEQ_CMD(0xDE, 0, 0x19),
+    LCD_INIT_SEQ_CMD(0xDF, 0, 0x10),
+    LCD_INIT_SEQ_CMD(0xE0, 0, 0x17),
+    LCD_INIT_SEQ_CMD(0xE1, 0, 0x0A),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x30),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x52),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x03),
+    LCD_INIT_SEQ_CMD(0x00, 0, 0x2A),
+    LCD_INIT_SEQ_CMD(0x01, 0, 0x2A),
+    LCD_INIT_SEQ_CMD(0x02, 0, 0x2A),
+    LCD_INIT_SEQ_CMD(0x03, 0, 0x2A),
+    LCD_INIT_SEQ_CMD(0x04, 0, 0x61),
+    LCD_INIT_SEQ_CMD(0x05, 0, 0x80),
+    LCD_INIT_SEQ_CMD(0x06, 0, 0xc7),
+    LCD_INIT_SEQ_CMD(0x07, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0x08, 0, 0x03),
+    LCD_INIT_SEQ_CMD(0x09, 0, 0x04),
+    LCD_INIT_SEQ_CMD(0x70, 0, 0x22),
+    LCD_INIT_SEQ_CMD(0x71, 0, 0x80),
+    LCD_INIT_SEQ_CMD(0x30, 0, 0x2A),
+    LCD_INIT_SEQ_CMD(0x31, 0, 0x2A),
+    LCD_INIT_SEQ_CMD(0x32, 0, 0x2A),
+    LCD_INIT_SEQ_CMD(0x33, 0, 0x2A),
+    LCD_INIT_SEQ_CMD(0x34, 0, 0x61),
+    LCD_INIT_SEQ_CMD(0x35, 0, 0xc5),
+    LCD_INIT_SEQ_CMD(0x36, 0, 0x80),
+    LCD_INIT_SEQ_CMD(0x37, 0, 0x23),
+    LCD_INIT_SEQ_CMD(0x40, 0, 0x03),
+    LCD_INIT_SEQ_CMD(0x41, 0, 0x04),
+    LCD_INIT_SEQ_CMD(0x42, 0, 0x05),
+    LCD_INIT_SEQ_CMD(0x43, 0, 0x06),
+    LCD_INIT_SEQ_CMD(0x44, 0, 0x11),
+    LCD_INIT_SEQ_CMD(0x45, 0, 0xe8),
+    LCD_INIT_SEQ_CMD(0x46, 0, 0xe9),
+    LCD_INIT_SEQ_CMD(0x47, 0, 0x11),
+    LCD_INIT_SEQ_CMD(0x48, 0, 0xea),
+    LCD_INIT_SEQ_CMD(0x49, 0, 0xeb),
+    LCD_INIT_SEQ_CMD(0x50, 0, 0x07),
+    LCD_INIT_SEQ_CMD(0x51, 0, 0x08),
+    LCD_INIT_SEQ_CMD(0x52, 0, 0x09),
+    LCD_INIT_SEQ_CMD(0x53, 0, 0x0a),
+    LCD_INIT_SEQ_CMD(0x54, 0, 0x11),
+    LCD_INIT_SEQ_CMD(0x55, 0, 0xec),
+    LCD_INIT_SEQ_CMD(0x56, 0, 0xed),
+    LCD_INIT_SEQ_CMD(0x57, 0, 0x11),
+    LCD_INIT_SEQ_CMD(0x58, 0, 0xef),
+    LCD_INIT_SEQ_CMD(0x59, 0, 0xf0),
+    LCD_INIT_SEQ_CMD(0xB1, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0xB4, 0, 0x15),
+    LCD_INIT_SEQ_CMD(0xB5, 0, 0x16),
+    LCD_INIT_SEQ_CMD(0xB6, 0, 0x09),
+    LCD_INIT_SEQ_CMD(0xB7, 0, 0x0f),
+    LCD_INIT_SEQ_CMD(0xB8, 0, 0x0d),
+    LCD_INIT_SEQ_CMD(0xB9, 0, 0x0b),
+    LCD_INIT_SEQ_CMD(0xBA, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0xC7, 0, 0x02),
+    LCD_INIT_SEQ_CMD(0xCA, 0, 0x17),
+    LCD_INIT_SEQ_CMD(0xCB, 0, 0x18),
+    LCD_INIT_SEQ_CMD(0xCC, 0, 0x0a),
+    LCD_INIT_SEQ_CMD(0xCD, 0, 0x10),
+    LCD_INIT_SEQ_CMD(0xCE, 0, 0x0e),
+    LCD_INIT_SEQ_CMD(0xCF, 0, 0x0c),
+    LCD_INIT_SEQ_CMD(0xD0, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x81, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x84, 0, 0x15),
+    LCD_INIT_SEQ_CMD(0x85, 0, 0x16),
+    LCD_INIT_SEQ_CMD(0x86, 0, 0x10),
+    LCD_INIT_SEQ_CMD(0x87, 0, 0x0a),
+    LCD_INIT_SEQ_CMD(0x88, 0, 0x0c),
+    LCD_INIT_SEQ_CMD(0x89, 0, 0x0e),
+    LCD_INIT_SEQ_CMD(0x8A, 0, 0x02),
+    LCD_INIT_SEQ_CMD(0x97, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x9A, 0, 0x17),
+    LCD_INIT_SEQ_CMD(0x9B, 0, 0x18),
+    LCD_INIT_SEQ_CMD(0x9C, 0, 0x0f),
+    LCD_INIT_SEQ_CMD(0x9D, 0, 0x09),
+    LCD_INIT_SEQ_CMD(0x9E, 0, 0x0b),
+    LCD_INIT_SEQ_CMD(0x9F, 0, 0x0d),
+    LCD_INIT_SEQ_CMD(0xA0, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x30),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x52),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x02),
+    LCD_INIT_SEQ_CMD(0x01, 0, 0x01),
+    LCD_INIT_SEQ_CMD(0x02, 0, 0xDA),
+    LCD_INIT_SEQ_CMD(0x03, 0, 0xBA),
+    LCD_INIT_SEQ_CMD(0x04, 0, 0xA8),
+    LCD_INIT_SEQ_CMD(0x05, 0, 0x9A),
+    LCD_INIT_SEQ_CMD(0x06, 0, 0x70),
+    LCD_INIT_SEQ_CMD(0x07, 0, 0xFF),
+    LCD_INIT_SEQ_CMD(0x08, 0, 0x91),
+    LCD_INIT_SEQ_CMD(0x09, 0, 0x90),
+    LCD_INIT_SEQ_CMD(0x0A, 0, 0xFF),
+    LCD_INIT_SEQ_CMD(0x0B, 0, 0x8F),
+    LCD_INIT_SEQ_CMD(0x0C, 0, 0x60),
+    LCD_INIT_SEQ_CMD(0x0D, 0, 0x58),
+    LCD_INIT_SEQ_CMD(0x0E, 0, 0x48),
+    LCD_INIT_SEQ_CMD(0x0F, 0, 0x38),
+    LCD_INIT_SEQ_CMD(0x10, 0, 0x2B),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x30),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x52),
+    LCD_INIT_SEQ_CMD(0xFF, 0, 0x00),
+    LCD_INIT_SEQ_CMD(0x3A, 0, 0x77),//RGB 565 format
+    LCD_INIT_SEQ_CMD(0x36, 0, 0x0a),
+
+    LCD_INIT_SEQ_CMD(0x11, 200),
+
+    LCD_INIT_SEQ_CMD(0x29, 20),
 };
 
+static uint32_t panel_h035a17_init_seq_checksum(h035a17_panel_t *h035a17) {
+    if (h035a17->init_cmds) {
+        return lcd_init_seq_checksum(h035a17->init_cmds, h035a17->init_cmds_size);
+    }
+    return lcd_init_seq_checksum_packed(rgb_lcd_init_seq, sizeof(rgb_lcd_init_seq));
+}
+
 static esp_err_t panel_h035a17_send_init_cmds(h035a17_panel_t *h035a17) {
     esp_lcd_panel_io_handle_t io_handle = h035a17->io_handle;
-    const h035a17_lcd_init_cmd_t *init_cmds = NULL;
-    uint16_t init_cmds_size = 0;
 
+    /*  Send Initialization Commands, with real waits only where the sequence asks for them  */
     if (h035a17->init_cmds) {
-        init_cmds = h035a17->init_cmds;
-        init_cmds_size = h035a17->init_cmds_size;
+        ESP_RETURN_ON_ERROR(lcd_init_seq_send(io_handle, h035a17->init_cmds, h035a17->init_cmds_size, NULL), TAG, "send Initialization commands failed");
     } else {
-        init_cmds = rgb_lcd_init_cmds;
-        init_cmds_size = sizeof(rgb_lcd_init_cmds) / sizeof(h035a17_lcd_init_cmd_t);
-    }
-
-    for (int i = 0; i < init_cmds_size; i++) {
-        /*  Send Initialization Commands   */
-        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io_handle, init_cmds [i].cmd, init_cmds [i].data, init_cmds [i].data_bytes), TAG, "send Initialization commands failed");
-        vTaskDelay(pdMS_TO_TICKS(init_cmds [i].delay_ms));
-
-        // ESP_LOGW(TAG, "send commands %d/%d", i, init_cmds_size);
+        ESP_RETURN_ON_ERROR(lcd_init_seq_send_packed(io_handle, rgb_lcd_init_seq, sizeof(rgb_lcd_init_seq), NULL), TAG, "send Initialization commands failed");
     }
     ESP_LOGI(TAG, "send initialization cmds success");
 
@@ -339,11 +344,21 @@ static esp_err_t panel_h035a17_send_init_cmds(h035a17_panel_t *h035a17) {
 
 static esp_err_t panel_h035a17_init(esp_lcd_panel_t *panel) {
     h035a17_panel_t *h035a17 = (h035a17_panel_t *)panel->user_data;
-    if (!h035a17->flags.enable_io_multiplex) {
+    if (!h035a17->flags.enable_io_multiplex && !h035a17->flags.warm) {
+        if (h035a17->flags.warm_restart) {
+            lcd_init_seq_warm_invalidate();
+        }
         ESP_RETURN_ON_ERROR(panel_h035a17_send_init_cmds(h035a17), TAG, "send init cmds failed");
+        if (h035a17->flags.warm_restart) {
+            lcd_init_seq_warm_save(panel_h035a17_init_seq_checksum(h035a17), h035a17->madctl_val, h035a17->colmod_val);
+        }
     }
     /*  Init RGB panel  */
     ESP_RETURN_ON_ERROR(h035a17->init(panel), TAG, "init RGB panel failed");
+    if (h035a17->flags.warm_restart && h035a17->reset_gpio_num >= 0) {
+        // the pad keeps its level through the software reset, RST can't glitch while the chip restarts
+        gpio_hold_en(h035a17->reset_gpio_num);
+    }
 
     return ESP_OK;
 }
@@ -351,6 +366,7 @@ static esp_err_t panel_h035a17_del(esp_lcd_panel_t *panel) {
     h035a17_panel_t *h035a17 = (h035a17_panel_t *)panel->user_data;
 
     if (h035a17->reset_gpio_num >= 0) {
+        gpio_hold_dis(h035a17->reset_gpio_num);
         gpio_reset_pin(h035a17->reset_gpio_num);
     }
     /*  Delete RGB panel  */
@@ -363,8 +379,21 @@ static esp_err_t panel_h035a17_reset(esp_lcd_panel_t *panel) {
     h035a17_panel_t *h035a17 = (h035a17_panel_t *)panel->user_data;
     esp_lcd_panel_io_handle_t io_handle = h035a17->io_handle;
 
+    if (h035a17->flags.warm_restart) {
+        if (lcd_init_seq_warm_restore(panel_h035a17_init_seq_checksum(h035a17), &h035a17->madctl_val, &h035a17->colmod_val)) {
+            // the panel stayed powered and configured across a software reset
+            h035a17->flags.warm = 1;
+            ESP_LOGI(TAG, "panel kept its configuration, skip reset and init sequence");
+            return h035a17->reset(panel);
+        }
+        // a panel reset and not initialized again must never be trusted after the next restart
+        lcd_init_seq_warm_invalidate();
+    }
+
     /*  Perform hardware reset  */
     if (h035a17->reset_gpio_num >= 0) {
+        // held since the last init, a held pad ignores the level
+        gpio_hold_dis(h035a17->reset_gpio_num);
         gpio_set_level(h035a17->reset_gpio_num, h035a17->flags.reset_level);
         vTaskDelay(pdMS_TO_TICKS(10));
         gpio_set_level(h035a17->reset_gpio_num, !h035a17->flags.reset_level);
@@ -430,4 +459,47 @@ static esp_err_t panel_h035a17_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
     return ESP_OK;
 }
 
+static esp_err_t panel_h035a17_desc_new(esp_lcd_panel_io_handle_t io, const lcd_panel_new_config_t *config,
+                                        esp_lcd_panel_handle_t *ret_panel)
+{
+    h035a17_vendor_config_t vendor_config = {
+        .rgb_config = config->rgb_config,
+        .flags = {
+            .mirror_by_cmd = config->flags.mirror_by_cmd,
+            .warm_restart = config->flags.warm_restart,
+        },
+    };
+    esp_lcd_panel_dev_config_t panel_dev_config = {
+        .reset_gpio_num = config->reset_gpio_num,
+        .rgb_ele_order = LCD_RGB_ELEMENT_ORDER_RGB,
+        .bits_per_pixel = 16,
+        .vendor_config = &vendor_config,
+    };
+    return esp_lcd_new_panel_h035a17(io, &panel_dev_config, ret_panel);
+}
+
+const lcd_panel_desc_t h035a17_panel_desc = {
+    .name = "h035a17",
+    .timings = {
+        .pclk_hz = 20 * 1000 * 1000,
+        .h_res = 640,
+        .v_res = 480,
+        .hsync_pulse_width = 23,
+        .hsync_back_porch = 20,
+        .hsync_front_porch = 20,
+        .vsync_pulse_width = 2,
+        .vsync_back_porch = 6,
+        .vsync_front_porch = 12,
+        .flags.pclk_active_neg = true,
+    },
+    .io = {
+        .spi_mode = 0,
+        .cmd_bytes = 1,
+        .param_bytes = 1,
+    },
+    .init_seq = rgb_lcd_init_seq,
+    .init_seq_size = sizeof(rgb_lcd_init_seq),
+    .new_panel = panel_h035a17_desc_new,
+};
+
 #endif
@@ -0,0 +1,133 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_lcd_panel_io.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief One entry of a panel initialization sequence.
+ */
+typedef struct {
+    int cmd;                /*<! The specific LCD command */
+    const void *data;       /*<! Buffer that holds the command specific data */
+    size_t data_bytes;      /*<! Size of `data` in memory, in bytes */
+    unsigned int delay_ms;  /*<! Delay in milliseconds after this command */
+} lcd_init_seq_cmd_t;
+
+/**
+ * @brief One entry of a packed initialization sequence, `{cmd, len, delay_ms, data...}` in bytes.
+ *
+ * A sequence is a `static const uint8_t[]` of these entries, so it stays in flash and costs 3 bytes
+ * per command on top of its parameters:
+ *
+ *     static const uint8_t init_seq[] = {
+ *         LCD_INIT_SEQ_CMD(0xFF, 0, 0x30),   // command 0xFF with one parameter
+ *         LCD_INIT_SEQ_CMD(0x11, 120),       // command 0x11 without parameters, then wait 120 ms
+ *     };
+ *
+ * @param cmd      The specific LCD command, 0x00 to 0xFF
+ * @param delay_ms Delay in milliseconds after this command, 0 to 255
+ * @param ...      Command specific data, up to 255 bytes
+ */
+#define LCD_INIT_SEQ_CMD(cmd, delay_ms, ...)                                          \
+    (uint8_t)(cmd),                                                                   \
+    (uint8_t)(sizeof((const uint8_t[]){0, ##__VA_ARGS__}) - 1),                       \
+    (uint8_t)((delay_ms) + 0 * sizeof(char[(delay_ms) <= UINT8_MAX ? 1 : -1])),       \
+    ##__VA_ARGS__
+
+/**
+ * @brief What sending an initialization sequence took.
+ */
+typedef struct {
+    uint32_t cmds;          /*<! Commands sent */
+    uint32_t bytes;         /*<! Command and parameter bytes sent */
+    uint32_t delays;        /*<! Delays requested by the sequence */
+    uint32_t delay_ms;      /*<! Sum of the delays requested */
+    uint32_t duration_us;   /*<! Time from the first command to the end of the last delay */
+} lcd_init_seq_stats_t;
+
+/**
+ * @brief Send an initialization sequence.
+ *
+ * The commands are sent back to back, the task only sleeps where an entry asks for a delay, and
+ * never less than asked. One line with the duration is logged at the end.
+ *
+ * @param[in]  io    LCD panel IO handle
+ * @param[in]  cmds  Sequence to send
+ * @param[in]  count Number of entries in `cmds`
+ * @param[out] stats What sending the sequence took, can be NULL
+ * @return
+ *      - ESP_OK on success
+ *      - Otherwise the error of the first command that failed, the rest of the sequence is not sent
+ */
+esp_err_t lcd_init_seq_send(esp_lcd_panel_io_handle_t io, const lcd_init_seq_cmd_t *cmds, size_t count,
+                            lcd_init_seq_stats_t *stats);
+
+/**
+ * @brief Send a packed initialization sequence, built with `LCD_INIT_SEQ_CMD()`.
+ *
+ * Same as `lcd_init_seq_send()`, without the 16 bytes of metadata per command.
+ *
+ * @param[in]  io    LCD panel IO handle
+ * @param[in]  seq   Sequence to send
+ * @param[in]  size  Size of `seq` in bytes
+ * @param[out] stats What sending the sequence took, can be NULL
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_SIZE if the last entry is cut short, nothing is sent
+ *      - Otherwise the error of the first command that failed, the rest of the sequence is not sent
+ */
+esp_err_t lcd_init_seq_send_packed(esp_lcd_panel_io_handle_t io, const uint8_t *seq, size_t size,
+                                   lcd_init_seq_stats_t *stats);
+
+/**
+ * @brief Checksum of an initialization sequence, to tell whether a panel has it applied.
+ */
+uint32_t lcd_init_seq_checksum(const lcd_init_seq_cmd_t *cmds, size_t count);
+
+/**
+ * @brief Checksum of a packed initialization sequence.
+ */
+uint32_t lcd_init_seq_checksum_packed(const uint8_t *seq, size_t size);
+
+/**
+ * @brief Find out whether the panel kept its configuration across the restart.
+ *
+ * The state saved by `lcd_init_seq_warm_save()` is kept in RTC memory, it survives software resets only.
+ * The panel must have stayed powered, and its reset line inactive, while the chip restarted.
+ *
+ * @param[in]  checksum Checksum of the sequence the panel should have applied
+ * @param[out] madctl   MADCTL value the panel has, if restored
+ * @param[out] colmod   COLMOD value the panel has, if restored
+ * @return true if the last reset was a software reset and the panel has the sequence applied,
+ *         the reset and the sequence can be skipped
+ */
+bool lcd_init_seq_warm_restore(uint32_t checksum, uint8_t *madctl, uint8_t *colmod);
+
+/**
+ * @brief Record that the panel has a sequence applied, and its MADCTL and COLMOD values.
+ *
+ * @note  Call again whenever MADCTL or COLMOD change.
+ */
+void lcd_init_seq_warm_save(uint32_t checksum, uint8_t madctl, uint8_t colmod);
+
+/**
+ * @brief Forget the saved state, call before resetting the panel so a half initialized panel is never trusted.
+ */
+void lcd_init_seq_warm_invalidate(void);
+
+#ifdef __cplusplus
+}
+#endif
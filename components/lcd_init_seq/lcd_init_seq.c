@@ -0,0 +1,174 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_attr.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "lcd_init_seq.h"
+
+#define LCD_INIT_SEQ_WARM_MAGIC     0x4C434457 // "LCDW"
+
+static const char *TAG = "lcd_init_seq";
+
+// panel state kept across software resets, garbage after power on until checked against `check`
+typedef struct {
+    uint32_t magic;
+    uint32_t checksum;
+    uint8_t madctl;
+    uint8_t colmod;
+    uint8_t reserved[2];    // no padding in the checked bytes
+    uint32_t check;
+} lcd_init_seq_warm_t;
+
+#if CONFIG_IDF_TARGET_LINUX
+static lcd_init_seq_warm_t s_warm;
+#else
+static RTC_NOINIT_ATTR lcd_init_seq_warm_t s_warm;
+#endif
+
+static void lcd_init_seq_wait(unsigned int delay_ms)
+{
+    // round up to whole ticks, plus one as the current tick may be almost over.
+    // Never spin, other tasks run while the panel settles
+    TickType_t ticks = (delay_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+    vTaskDelay(ticks + 1);
+}
+
+// send one command, then wait as long as it asks
+static esp_err_t lcd_init_seq_tx(esp_lcd_panel_io_handle_t io, int cmd, const void *data, size_t data_bytes,
+                                 unsigned int delay_ms, lcd_init_seq_stats_t *s)
+{
+    // every register write needs its own command phase, the IO sends each entry as one transaction
+    esp_err_t ret = esp_lcd_panel_io_tx_param(io, cmd, data, data_bytes);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    s->cmds++;
+    s->bytes += 1 + data_bytes;
+    if (delay_ms) {
+        s->delays++;
+        s->delay_ms += delay_ms;
+        lcd_init_seq_wait(delay_ms);
+    }
+    return ESP_OK;
+}
+
+static void lcd_init_seq_report(int64_t start_us, lcd_init_seq_stats_t *s, lcd_init_seq_stats_t *stats)
+{
+    s->duration_us = esp_timer_get_time() - start_us;
+    ESP_LOGI(TAG, "sent %"PRIu32" commands (%"PRIu32" bytes) in %"PRIu32" us, %"PRIu32" ms of it in %"PRIu32" delays",
+             s->cmds, s->bytes, s->duration_us, s->delay_ms, s->delays);
+    if (stats) {
+        *stats = *s;
+    }
+}
+
+esp_err_t lcd_init_seq_send(esp_lcd_panel_io_handle_t io, const lcd_init_seq_cmd_t *cmds, size_t count,
+                            lcd_init_seq_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(io && (cmds || !count), ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    lcd_init_seq_stats_t s = {0};
+    int64_t start_us = esp_timer_get_time();
+
+    for (size_t i = 0; i < count; i++) {
+        ESP_RETURN_ON_ERROR(lcd_init_seq_tx(io, cmds[i].cmd, cmds[i].data, cmds[i].data_bytes, cmds[i].delay_ms, &s),
+                            TAG, "send command %d/%d (0x%02X) failed", (int)i, (int)count, cmds[i].cmd);
+    }
+
+    lcd_init_seq_report(start_us, &s, stats);
+    return ESP_OK;
+}
+
+esp_err_t lcd_init_seq_send_packed(esp_lcd_panel_io_handle_t io, const uint8_t *seq, size_t size,
+                                   lcd_init_seq_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(io && (seq || !size), ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    // check the whole sequence first, a panel left half initialized is harder to debug
+    size_t offset = 0;
+    while (offset < size) {
+        ESP_RETURN_ON_FALSE(offset + 3 <= size && offset + 3 + seq[offset + 1] <= size, ESP_ERR_INVALID_SIZE,
+                            TAG, "entry at byte %d cut short", (int)offset);
+        offset += 3 + seq[offset + 1];
+    }
+
+    lcd_init_seq_stats_t s = {0};
+    int64_t start_us = esp_timer_get_time();
+    for (offset = 0; offset < size; offset += 3 + seq[offset + 1]) {
+        const uint8_t *entry = seq + offset;
+        ESP_RETURN_ON_ERROR(lcd_init_seq_tx(io, entry[0], entry[1] ? entry + 3 : NULL, entry[1], entry[2], &s),
+                            TAG, "send command at byte %d (0x%02X) failed", (int)offset, entry[0]);
+    }
+
+    lcd_init_seq_report(start_us, &s, stats);
+    return ESP_OK;
+}
+
+uint32_t lcd_init_seq_checksum(const lcd_init_seq_cmd_t *cmds, size_t count)
+{
+    uint32_t crc = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t header[3] = {cmds[i].cmd, cmds[i].data_bytes, cmds[i].delay_ms};
+        crc = esp_rom_crc32_le(crc, (const uint8_t *)header, sizeof(header));
+        if (cmds[i].data_bytes) {
+            crc = esp_rom_crc32_le(crc, cmds[i].data, cmds[i].data_bytes);
+        }
+    }
+    return crc;
+}
+
+uint32_t lcd_init_seq_checksum_packed(const uint8_t *seq, size_t size)
+{
+    return esp_rom_crc32_le(0, seq, size);
+}
+
+static uint32_t lcd_init_seq_warm_check(const lcd_init_seq_warm_t *warm)
+{
+    return esp_rom_crc32_le(0, (const uint8_t *)warm, offsetof(lcd_init_seq_warm_t, check));
+}
+
+static bool lcd_init_seq_sw_reset(void)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    return false; // a host process keeps nothing across restarts
+#else
+    return esp_reset_reason() == ESP_RST_SW;
+#endif
+}
+
+bool lcd_init_seq_warm_restore(uint32_t checksum, uint8_t *madctl, uint8_t *colmod)
+{
+    // RTC memory is only retained, and the panel only kept powered, across a software reset
+    if (!lcd_init_seq_sw_reset() || s_warm.magic != LCD_INIT_SEQ_WARM_MAGIC ||
+            s_warm.check != lcd_init_seq_warm_check(&s_warm) || s_warm.checksum != checksum) {
+        return false;
+    }
+    *madctl = s_warm.madctl;
+    *colmod = s_warm.colmod;
+    return true;
+}
+
+void lcd_init_seq_warm_save(uint32_t checksum, uint8_t madctl, uint8_t colmod)
+{
+    lcd_init_seq_warm_t warm = {
+        .magic = LCD_INIT_SEQ_WARM_MAGIC,
+        .checksum = checksum,
+        .madctl = madctl,
+        .colmod = colmod,
+    };
+    warm.check = lcd_init_seq_warm_check(&warm);
+    s_warm = warm;
+}
+
+void lcd_init_seq_warm_invalidate(void)
+{
+    s_warm.magic = 0;
+}
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_lcd_types.h"
+#include "esp_lcd_panel_rgb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LCD_PANEL_REGISTRY_MAX  8   /*<! Panels one image can register */
+
+/**
+ * @brief What the board passes to a panel constructor.
+ */
+typedef struct {
+    const esp_lcd_rgb_panel_config_t *rgb_config;   /*<! RGB panel configuration, with the timings of the panel */
+    int reset_gpio_num;                             /*<! GPIO of the panel reset line, -1 if not used */
+    struct {
+        unsigned int mirror_by_cmd: 1;              /*<! Mirror by LCD command instead of by software */
+        unsigned int warm_restart: 1;               /*<! Skip the panel reset and initialization sequence after a software reset,
+                                                     *   ignored by the drivers that can't tell whether the panel kept its configuration
+                                                     */
+    } flags;
+} lcd_panel_new_config_t;
+
+/**
+ * @brief Everything needed to bring up one panel model, provided by its driver.
+ *
+ * The initialization sequence comes with the constructor, which sends the default one of the driver.
+ * That sequence is also given here, for tests and tools.
+ */
+typedef struct {
+    const char *name;                               /*<! Panel model, for logs */
+    esp_lcd_rgb_timing_t timings;                   /*<! RGB timings, including the resolution */
+    struct {
+        uint8_t spi_mode;                           /*<! SPI mode of the 3-wire panel IO */
+        uint8_t cmd_bytes;                          /*<! Bytes per command */
+        uint8_t param_bytes;                        /*<! Bytes per parameter */
+    } io;
+    const uint8_t *init_seq;                        /*<! Default initialization sequence, packed with `LCD_INIT_SEQ_CMD()`, NULL if unknown */
+    size_t init_seq_size;                           /*<! Size of `init_seq` in bytes */
+    /**
+     * @brief Create the panel, like the `esp_lcd_new_panel_*()` function of the driver.
+     */
+    esp_err_t (*new_panel)(esp_lcd_panel_io_handle_t io, const lcd_panel_new_config_t *config,
+                           esp_lcd_panel_handle_t *ret_panel);
+} lcd_panel_desc_t;
+
+/**
+ * @brief Register a panel under the ID the board reports for it.
+ *
+ * @param[in] id   Panel ID, as read from the board (ID pins, EEPROM, NVS...)
+ * @param[in] desc Panel descriptor, must stay valid, usually a `const` of the driver
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if `desc` misses its constructor
+ *      - ESP_ERR_INVALID_STATE if another panel has the same ID
+ *      - ESP_ERR_NO_MEM if `LCD_PANEL_REGISTRY_MAX` panels are registered already
+ */
+esp_err_t lcd_panel_registry_add(uint8_t id, const lcd_panel_desc_t *desc);
+
+/**
+ * @brief Find the panel registered under an ID.
+ *
+ * @return Panel descriptor, NULL if no panel has this ID
+ */
+const lcd_panel_desc_t *lcd_panel_registry_find(uint8_t id);
+
+/**
+ * @brief Number of panels registered.
+ */
+size_t lcd_panel_registry_count(void);
+
+/**
+ * @brief Panel registered in the given position, to list them.
+ *
+ * @param[in]  index  Position, from 0 to `lcd_panel_registry_count()` - 1
+ * @param[out] ret_id ID of the panel, can be NULL
+ * @return Panel descriptor, NULL if `index` is out of range
+ */
+const lcd_panel_desc_t *lcd_panel_registry_get(size_t index, uint8_t *ret_id);
+
+/**
+ * @brief Pixel clocks per line, including the horizontal blanking.
+ */
+static inline uint32_t lcd_panel_h_total(const esp_lcd_rgb_timing_t *timings)
+{
+    return timings->h_res + timings->hsync_pulse_width + timings->hsync_back_porch + timings->hsync_front_porch;
+}
+
+/**
+ * @brief Lines per frame, including the vertical blanking.
+ */
+static inline uint32_t lcd_panel_v_total(const esp_lcd_rgb_timing_t *timings)
+{
+    return timings->v_res + timings->vsync_pulse_width + timings->vsync_back_porch + timings->vsync_front_porch;
+}
+
+/**
+ * @brief Frames per second the panel is scanned out at.
+ */
+static inline float lcd_panel_refresh_hz(const esp_lcd_rgb_timing_t *timings)
+{
+    return (float)timings->pclk_hz / lcd_panel_h_total(timings) / lcd_panel_v_total(timings);
+}
+
+#ifdef __cplusplus
+}
+#endif
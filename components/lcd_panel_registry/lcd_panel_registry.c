@@ -0,0 +1,57 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_check.h"
+#include "esp_log.h"
+#include "lcd_panel_registry.h"
+
+static const char *TAG = "lcd_panel_registry";
+
+// filled once at startup, before any lookup
+static struct {
+    uint8_t ids[LCD_PANEL_REGISTRY_MAX];
+    const lcd_panel_desc_t *descs[LCD_PANEL_REGISTRY_MAX];
+    size_t count;
+} s_registry;
+
+esp_err_t lcd_panel_registry_add(uint8_t id, const lcd_panel_desc_t *desc)
+{
+    ESP_RETURN_ON_FALSE(desc && desc->new_panel, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    const lcd_panel_desc_t *other = lcd_panel_registry_find(id);
+    ESP_RETURN_ON_FALSE(!other, ESP_ERR_INVALID_STATE, TAG, "ID %u is taken by %s", id, other->name);
+    ESP_RETURN_ON_FALSE(s_registry.count < LCD_PANEL_REGISTRY_MAX, ESP_ERR_NO_MEM, TAG, "registry full");
+    s_registry.ids[s_registry.count] = id;
+    s_registry.descs[s_registry.count] = desc;
+    s_registry.count++;
+    ESP_LOGD(TAG, "panel %u: %s", id, desc->name);
+    return ESP_OK;
+}
+
+const lcd_panel_desc_t *lcd_panel_registry_find(uint8_t id)
+{
+    for (size_t i = 0; i < s_registry.count; i++) {
+        if (s_registry.ids[i] == id) {
+            return s_registry.descs[i];
+        }
+    }
+    return NULL;
+}
+
+size_t lcd_panel_registry_count(void)
+{
+    return s_registry.count;
+}
+
+const lcd_panel_desc_t *lcd_panel_registry_get(size_t index, uint8_t *ret_id)
+{
+    if (index >= s_registry.count) {
+        return NULL;
+    }
+    if (ret_id) {
+        *ret_id = s_registry.ids[index];
+    }
+    return s_registry.descs[index];
+}
@@ -7,15 +7,19 @@ extern "C"{
 //
 // Created by taxue on 2023/1/19.
 //
-#include "driver/i2c.h"
+#include <stdatomic.h>
+#include "driver/i2c_master.h"
 #include "string.h"
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
 /**指令定义**/
 
 #define GT911_ADDR1 (uint8_t)0x5D
 #define GT911_ADDR2 (uint8_t)0x14
 
+// 画面相对触摸板的方向：RIGHT顺时针90度，INVERTED 180度，LEFT顺时针270度
 #define ROTATION_LEFT      (uint8_t)0
 #define ROTATION_INVERTED  (uint8_t)1
 #define ROTATION_RIGHT     (uint8_t)2
@@ -141,6 +145,8 @@ extern "C"{
 #define GT911_POINT_4           (uint16_t)0X8167
 #define GT911_POINT_5           (uint16_t)0X816F
 #define TOUCH_POINT_TOTAL       5 //此芯片最多支持五点触控
+#define GT911_POINT_SIZE        8 //每个触控点占8字节：id,xl,xh,yl,yh,sl,sh,保留
+#define GT911_FRAME_SIZE        (1 + TOUCH_POINT_TOTAL * GT911_POINT_SIZE) //状态字节+全部触控点
 
 /**用于存放每一个触控点的id，坐标，大小**/
 typedef struct {
@@ -150,22 +156,53 @@ typedef struct {
     uint16_t size;
 }TP_point_info;
 
-/**类结构体**/
+/**触控快照，由触控任务写入，LVGL读取回调无锁读取**/
 typedef struct {
-    i2c_config_t gt911_i2c_config;
+    uint8_t touch_num;
+    int64_t timestamp_us; //读取该帧时的esp_timer时间
+    TP_point_info points_info[TOUCH_POINT_TOTAL];
+}GT911_snapshot;
+
+typedef struct Vernon_GT911 Vernon_GT911;
+
+/**读取完成回调，在触控任务中调用**/
+typedef void (*GT911_frame_cb_t)(Vernon_GT911 * VernonGt911, const GT911_snapshot *snapshot, void *user_ctx);
+
+/**类结构体**/
+struct Vernon_GT911 {
+    i2c_master_bus_handle_t bus; //I2C总线，可与其他设备共享
+    i2c_master_dev_handle_t dev;
+    bool own_bus; //总线由GT911_init创建时为true
     i2c_port_t i2c_num;
     uint8_t gt911_addr;
+    int8_t int_pin;
     uint16_t height;
     uint16_t width;
     uint8_t rotation;
+    uint8_t touch_num; //最近一帧的触点数量
+    int64_t timestamp_us; //最近一帧的读取时间
     TP_point_info points_info[TOUCH_POINT_TOTAL]; //用于存储五个触控点的坐标
-}Vernon_GT911;
+    uint8_t frame_buf[GT911_FRAME_SIZE]; //从GT911_POINT_INFO开始的连续读取缓冲，避免堆分配
+    TaskHandle_t touch_task; //后台触控任务，未启动时为NULL
+    GT911_frame_cb_t frame_cb;
+    void *frame_cb_ctx;
+    atomic_uint snapshot_seq; //快照序号，奇数表示正在写入
+    GT911_snapshot snapshot;
+};
 
 /**功能函数区**/
 
-//初始化函数
-void GT911_init(Vernon_GT911 * VernonGt911, int8_t SDA, int8_t SCL, int8_t INT, int8_t RES,
-                i2c_port_t i2c_num, uint8_t gt911_addr, uint16_t width, uint16_t height);
+//初始化函数，新建I2C总线
+esp_err_t GT911_init(Vernon_GT911 * VernonGt911, int8_t SDA, int8_t SCL, int8_t INT, int8_t RES,
+                     i2c_port_t i2c_num, uint8_t gt911_addr, uint32_t scl_speed_hz,
+                     uint16_t width, uint16_t height);
+
+//初始化函数，挂载到已有的I2C总线上
+esp_err_t GT911_init_on_bus(Vernon_GT911 * VernonGt911, i2c_master_bus_handle_t bus, int8_t INT, int8_t RES,
+                            uint8_t gt911_addr, uint32_t scl_speed_hz, uint16_t width, uint16_t height);
+
+//获取GT911所在的I2C总线，其他传感器可用i2c_master_bus_add_device()挂载到同一总线
+i2c_master_bus_handle_t GT911_get_bus(Vernon_GT911 * VernonGt911);
 
 //设置方向
 void GT911_setRotation(Vernon_GT911 * VernonGt911, uint8_t rot);
@@ -176,6 +213,21 @@ bool GT911_touched(Vernon_GT911 * VernonGt911);
 //获取触控点触碰位置
 void GT911_read_pos(Vernon_GT911 * VernonGt911, uint16_t *x, uint16_t *y, uint8_t index);
 
+//启动后台触控任务，读取结果发布到快照，并调用读取完成回调
+esp_err_t GT911_start_task(Vernon_GT911 * VernonGt911, UBaseType_t task_priority);
+
+//注册读取完成回调
+void GT911_register_frame_callback(Vernon_GT911 * VernonGt911, GT911_frame_cb_t cb, void *user_ctx);
+
+//异步请求读取一帧，立即返回，不阻塞调用者
+void GT911_request_read(Vernon_GT911 * VernonGt911);
+
+//开启中断模式：INT引脚触发后由触控任务读取，并发布到快照
+esp_err_t GT911_enable_interrupt(Vernon_GT911 * VernonGt911, UBaseType_t task_priority);
+
+//无锁读取最新的触控快照，有触点按下返回true
+bool GT911_read_snapshot(Vernon_GT911 * VernonGt911, GT911_snapshot *snapshot);
+
 #ifdef __cpluscplus
 }
 #endif
@@ -1,4 +1,8 @@
 #include <stdio.h>
+#include "driver/gpio.h"
+#include "esp_attr.h"
+#include "esp_check.h"
+#include "esp_timer.h"
 #include "vernon_gt911.h"
 
 //
@@ -6,7 +10,11 @@
 //
 
 #define I2C_MASTER_FREQ_HZ          100000
-#define I2C_MASTER_TIMEOUT_MS       1000
+#define I2C_MASTER_TIMEOUT_MS       50
+#define GT911_WRITE_MAX_LEN         188 //配置区0x8047~0x8100，加上寄存器地址
+#define GT911_TOUCH_TASK_STACK_SIZE (3 * 1024)
+
+static const char *TAG = "GT911";
 
 /**
  * @brief GT911 写入数据包
@@ -18,22 +26,17 @@
  */
 int GT911_write_regs(Vernon_GT911 * VernonGt911, uint16_t reg, uint8_t *data, uint8_t len)
 {
-    esp_err_t i2c_err;
-
-    uint8_t regl = reg & 0xff;
-    uint8_t regh = (reg>>8) & 0xff;
-    uint8_t * write_package = malloc((len + 2) * sizeof(uint8_t));
-    memcpy(write_package, &regh, 1);
-    memcpy(write_package + 1, &regl, 1);
+    // 寄存器地址和数据需在同一个事务中发送，使用栈上缓冲，不经过堆
+    uint8_t write_package[GT911_WRITE_MAX_LEN];
+    if (len + 2 > GT911_WRITE_MAX_LEN) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    write_package[0] = (reg >> 8) & 0xff;
+    write_package[1] = reg & 0xff;
     memcpy(write_package + 2, data, len);
 
-    i2c_err = i2c_master_write_to_device(VernonGt911->i2c_num,
-                                         VernonGt911->gt911_addr,
-                                         write_package, len + 2,
-                                         I2C_MASTER_TIMEOUT_MS / portTICK_PERIOD_MS);
-
-    free(write_package);
-    return i2c_err;
+    // 总线锁只在单个事务内持有，共享总线的其他设备可以在两次事务之间访问
+    return i2c_master_transmit(VernonGt911->dev, write_package, len + 2, I2C_MASTER_TIMEOUT_MS);
 }
 
 /**
@@ -50,46 +53,115 @@ int GT911_read_regs(Vernon_GT911 * VernonGt911, uint16_t reg, uint8_t *data, uin
     uint8_t regh = (reg>>8)&0xff;
     uint8_t rbuf[2] = {regh, regl};
 
-    return i2c_master_write_read_device(VernonGt911->i2c_num, VernonGt911->gt911_addr,
-                                        rbuf, 2, data, len,
-                                        I2C_MASTER_TIMEOUT_MS / portTICK_PERIOD_MS);
+    return i2c_master_transmit_receive(VernonGt911->dev, rbuf, 2, data, len, I2C_MASTER_TIMEOUT_MS);
 }
 
 /**
- * @brief GT911 初始化函数
+ * @brief GT911 初始化函数，挂载到已有的I2C总线
  * @param VernonGt911 类实例
- * @param SDA SDA引脚
- * @param SCL SCL引脚
+ * @param bus I2C总线句柄
  * @param INT 中断引脚，没有赋值-1
  * @param RES 重置引脚，没有赋值-1
- * @param i2c_num I2C端口号
  * @param gt911_addr GT911地址
+ * @param scl_speed_hz SCL频率，0为默认100kHz，GT911最高支持400kHz
  * @param width 屏幕宽度
  * @param height 屏幕高度
+ * @return esp_err_t
  */
-void GT911_init(Vernon_GT911 * VernonGt911, int8_t SDA, int8_t SCL, int8_t INT, int8_t RES,
-                i2c_port_t i2c_num, uint8_t gt911_addr, uint16_t width, uint16_t height)
+esp_err_t GT911_init_on_bus(Vernon_GT911 * VernonGt911, i2c_master_bus_handle_t bus, int8_t INT, int8_t RES,
+                            uint8_t gt911_addr, uint32_t scl_speed_hz, uint16_t width, uint16_t height)
 {
-    VernonGt911->gt911_i2c_config.mode = I2C_MODE_MASTER;
-    VernonGt911->gt911_i2c_config.sda_io_num = SDA;
-    VernonGt911->gt911_i2c_config.sda_pullup_en = GPIO_PULLUP_ENABLE;
-    VernonGt911->gt911_i2c_config.scl_io_num = SCL;
-    VernonGt911->gt911_i2c_config.scl_pullup_en = GPIO_PULLUP_ENABLE;
-    VernonGt911->gt911_i2c_config.master.clk_speed = I2C_MASTER_FREQ_HZ;
-
-    VernonGt911->i2c_num = i2c_num;
+    VernonGt911->bus = bus;
+    VernonGt911->own_bus = false;
+    VernonGt911->i2c_num = -1; //共享总线的端口号未知，由GT911_init填入
+    VernonGt911->rotation = ROTATION_NORMAL;
     VernonGt911->gt911_addr = gt911_addr;
+    VernonGt911->int_pin = INT;
+    VernonGt911->touch_num = 0;
+    VernonGt911->touch_task = NULL;
+    VernonGt911->frame_cb = NULL;
+    VernonGt911->frame_cb_ctx = NULL;
+    atomic_init(&VernonGt911->snapshot_seq, 0);
+    memset(&VernonGt911->snapshot, 0, sizeof(VernonGt911->snapshot));
     VernonGt911->height = height;
     VernonGt911->width = width;
 
-    i2c_param_config(i2c_num, &VernonGt911->gt911_i2c_config);
-
-    i2c_driver_install(i2c_num, VernonGt911->gt911_i2c_config.mode, 0,
-                       0, 0);
+    i2c_device_config_t dev_config = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address = gt911_addr,
+        .scl_speed_hz = scl_speed_hz ? scl_speed_hz : I2C_MASTER_FREQ_HZ,
+    };
+    esp_err_t err = i2c_master_bus_add_device(bus, &dev_config, &VernonGt911->dev);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "add GT911 to I2C bus failed");
+        return err;
+    }
 
     uint8_t buf[5] = {0};
-    GT911_read_regs(VernonGt911, GT911_PRODUCT_ID, buf, 4);
+    err = GT911_read_regs(VernonGt911, GT911_PRODUCT_ID, buf, 4);
+    if (err != ESP_OK) {
+        // 不响应的设备不留在总线上
+        ESP_LOGE(TAG, "read GT911 product ID failed");
+        i2c_master_bus_rm_device(VernonGt911->dev);
+        VernonGt911->dev = NULL;
+        return err;
+    }
     printf("GT911 PRODUCT ID: %s\n", buf);
+    return ESP_OK;
+}
+
+/**
+ * @brief GT911 初始化函数，新建I2C总线
+ * @param VernonGt911 类实例
+ * @param SDA SDA引脚
+ * @param SCL SCL引脚
+ * @param INT 中断引脚，没有赋值-1
+ * @param RES 重置引脚，没有赋值-1
+ * @param i2c_num I2C端口号
+ * @param gt911_addr GT911地址
+ * @param scl_speed_hz SCL频率，0为默认100kHz，GT911最高支持400kHz
+ * @param width 屏幕宽度
+ * @param height 屏幕高度
+ * @return esp_err_t
+ */
+esp_err_t GT911_init(Vernon_GT911 * VernonGt911, int8_t SDA, int8_t SCL, int8_t INT, int8_t RES,
+                     i2c_port_t i2c_num, uint8_t gt911_addr, uint32_t scl_speed_hz,
+                     uint16_t width, uint16_t height)
+{
+    i2c_master_bus_config_t bus_config = {
+        .clk_source = I2C_CLK_SRC_DEFAULT,
+        .i2c_port = i2c_num,
+        .sda_io_num = SDA,
+        .scl_io_num = SCL,
+        .glitch_ignore_cnt = 7,
+        .flags.enable_internal_pullup = true,
+    };
+    i2c_master_bus_handle_t bus = NULL;
+    esp_err_t err = i2c_new_master_bus(&bus_config, &bus);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "create I2C bus failed");
+        return err;
+    }
+
+    err = GT911_init_on_bus(VernonGt911, bus, INT, RES, gt911_addr, scl_speed_hz, width, height);
+    if (err != ESP_OK) {
+        i2c_del_master_bus(bus);
+        VernonGt911->bus = NULL;
+        return err;
+    }
+    VernonGt911->i2c_num = i2c_num;
+    VernonGt911->own_bus = true;
+    return ESP_OK;
+}
+
+/**
+ * @brief 获取GT911所在的I2C总线
+ * @param VernonGt911 类实例
+ * @return 总线句柄，其他传感器可用i2c_master_bus_add_device()挂载
+ */
+i2c_master_bus_handle_t GT911_get_bus(Vernon_GT911 * VernonGt911)
+{
+    return VernonGt911->bus;
 }
 
 /**
@@ -102,6 +174,88 @@ void GT911_setRotation(Vernon_GT911 * VernonGt911, uint8_t rot)
     VernonGt911->rotation = rot;
 }
 
+/**
+ * @brief 清除GT911_POINT_INFO状态，GT911收到后才会准备下一帧并产生INT脉冲
+ * @param VernonGt911 类实例
+ */
+static void GT911_clear_status(Vernon_GT911 * VernonGt911)
+{
+    uint8_t temp = 0;
+    //必须给GT911_POINT_INFO缓冲区置0,不然读取的数据一直为128！！！！
+    GT911_write_regs(VernonGt911, GT911_POINT_INFO, &temp, 1);
+}
+
+/**
+ * @brief 读取一帧触控数据
+ * @param VernonGt911 类实例
+ * @return 帧未就绪返回-1，否则返回触点数量
+ */
+static int GT911_read_frame(Vernon_GT911 * VernonGt911)
+{
+    uint8_t *frame = VernonGt911->frame_buf;
+    uint8_t touch_num, buffer_status;
+    // 一次读取状态字节和第一个触控点，单指触摸只需这一次读取
+    if (GT911_read_regs(VernonGt911, GT911_POINT_INFO, frame, 1 + GT911_POINT_SIZE) != ESP_OK) {
+        return -1;
+    }
+    int64_t timestamp_us = esp_timer_get_time();
+    touch_num = frame[0] & 0xf; //触点数量
+    buffer_status = (frame[0] >> 7) & 1; // 帧状态
+
+    if (buffer_status == 0) {
+        return -1;
+    }
+    if (touch_num > TOUCH_POINT_TOTAL) {
+        touch_num = 0;
+    }
+    if (touch_num > 1) {
+        // 其余触控点紧随其后，连续读取
+        if (GT911_read_regs(VernonGt911, GT911_POINT_2, frame + 1 + GT911_POINT_SIZE,
+                            (touch_num - 1) * GT911_POINT_SIZE) != ESP_OK) {
+            // 状态字节已读到，读取失败也要清除，否则中断模式下INT不再触发，触控卡死
+            GT911_clear_status(VernonGt911);
+            return -1;
+        }
+    }
+
+    // 只解析实际上报的触控点
+    for (int i = 0; i < touch_num; ++i) {
+        const uint8_t *point_info_p = frame + 1 + i * GT911_POINT_SIZE;
+        TP_point_info *point = &VernonGt911->points_info[i];
+        point->id = point_info_p[0];
+        point->x = point_info_p[1] + (point_info_p[2] << 8);
+        point->y = point_info_p[3] + (point_info_p[4] << 8);
+        point->size = point_info_p[5] + (point_info_p[6] << 8);
+
+        //旋转方向，width/height为触摸板未旋转时的尺寸
+        uint16_t temp;
+        switch (VernonGt911->rotation){
+            case ROTATION_INVERTED:
+                point->x = VernonGt911->width - 1 - point->x;
+                point->y = VernonGt911->height - 1 - point->y;
+                break;
+            case ROTATION_LEFT:
+                temp = point->x;
+                point->x = VernonGt911->height - 1 - point->y;
+                point->y = temp;
+                break;
+            case ROTATION_RIGHT:
+                temp = point->x;
+                point->x = point->y;
+                point->y = VernonGt911->width - 1 - temp;
+                break;
+            case ROTATION_NORMAL:
+            default:
+                break;
+        }
+    }
+    VernonGt911->touch_num = touch_num;
+    VernonGt911->timestamp_us = timestamp_us;
+
+    GT911_clear_status(VernonGt911);
+    return touch_num;
+}
+
 /**
  * @brief 检测是否被触摸并且获取相关值
  * @param VernonGt911
@@ -109,59 +263,190 @@ void GT911_setRotation(Vernon_GT911 * VernonGt911, uint8_t rot)
  */
 bool GT911_touched(Vernon_GT911 * VernonGt911)
 {
-    uint8_t touched_state, touch_num, buffer_status;
-    GT911_read_regs(VernonGt911, GT911_POINT_INFO, &touched_state, 1);
-    touch_num = touched_state & 0xf; //触点数量
-    buffer_status = (touched_state >> 7) & 1; // 帧状态
-
-    if(buffer_status == 1 && (touch_num <= TOUCH_POINT_TOTAL) && (touch_num > 0)){
-        uint16_t POINTERS_REGS[TOUCH_POINT_TOTAL] = {GT911_POINT_1, GT911_POINT_2, GT911_POINT_3, GT911_POINT_4, GT911_POINT_5};
-        // 获取每个触控点的坐标值并保存
-        for (int i = 0; i < TOUCH_POINT_TOTAL; ++i) {
-            uint8_t point_info_per_size = 7;
-            uint8_t * point_info_p = malloc(point_info_per_size * sizeof(uint8_t ));
-            GT911_read_regs(VernonGt911, POINTERS_REGS[i], point_info_p, point_info_per_size);
-
-            VernonGt911->points_info[i].id = point_info_p[0];
-            VernonGt911->points_info[i].x = point_info_p[1] + (point_info_p[2] << 8);
-            VernonGt911->points_info[i].y = point_info_p[3] + (point_info_p[4] << 8);
-            VernonGt911->points_info[i].size = point_info_p[5] + (point_info_p[6] << 8);
-
-            free(point_info_p);
-
-            //旋转方向
-            uint16_t temp;
-            switch (VernonGt911->rotation){
-                case ROTATION_INVERTED:
-                    VernonGt911->points_info[i].x = VernonGt911->width - VernonGt911->points_info[i].x;
-                    VernonGt911->points_info[i].y = VernonGt911->height - VernonGt911->points_info[i].y;
-                    break;
-                case ROTATION_LEFT:
-                    temp = VernonGt911->points_info[i].x;
-                    VernonGt911->points_info[i].x = VernonGt911->width - VernonGt911->points_info[i].y;
-                    VernonGt911->points_info[i].y = temp;
-                    break;
-                case ROTATION_NORMAL:
-                    VernonGt911->points_info[i].x = VernonGt911->points_info[i].x;
-                    VernonGt911->points_info[i].y = VernonGt911->points_info[i].y;
-                    break;
-                case ROTATION_RIGHT:
-                    temp = VernonGt911->points_info[i].x;
-                    VernonGt911->points_info[i].x = VernonGt911->points_info[i].y;
-                    VernonGt911->points_info[i].y = VernonGt911->height - temp;
-                    break;
-                default:
-                    break;
-            }
-        }
+    int touch_num = GT911_read_frame(VernonGt911);
+    if (touch_num < 0) {
         uint8_t temp = 0;
         GT911_write_regs(VernonGt911, GT911_POINT_INFO, &temp, 1);
-        return true;
+        return false;
     }
-    uint8_t temp = 0;
-    //必须给GT911_POINT_INFO缓冲区置0,不然读取的数据一直为128！！！！
-    GT911_write_regs(VernonGt911, GT911_POINT_INFO, &temp, 1);
-    return false;
+    return touch_num > 0;
+}
+
+/**
+ * @brief 发布快照（单写者顺序锁），读者无需加锁
+ * @param VernonGt911 类实例
+ */
+static void GT911_publish_snapshot(Vernon_GT911 * VernonGt911)
+{
+    unsigned seq = atomic_load_explicit(&VernonGt911->snapshot_seq, memory_order_relaxed);
+    atomic_store_explicit(&VernonGt911->snapshot_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    VernonGt911->snapshot.touch_num = VernonGt911->touch_num;
+    VernonGt911->snapshot.timestamp_us = VernonGt911->timestamp_us;
+    memcpy(VernonGt911->snapshot.points_info, VernonGt911->points_info, sizeof(VernonGt911->points_info));
+
+    atomic_store_explicit(&VernonGt911->snapshot_seq, seq + 2, memory_order_release);
+}
+
+/**
+ * @brief 无锁读取最新的触控快照
+ * @param VernonGt911 类实例
+ * @param snapshot 输出的快照
+ * @return 有触点按下为true，反之
+ */
+bool GT911_read_snapshot(Vernon_GT911 * VernonGt911, GT911_snapshot *snapshot)
+{
+    unsigned seq_begin, seq_end;
+    do {
+        seq_begin = atomic_load_explicit(&VernonGt911->snapshot_seq, memory_order_acquire);
+        if (seq_begin & 1) {
+            continue; //写入中，重试
+        }
+        memcpy(snapshot, &VernonGt911->snapshot, sizeof(GT911_snapshot));
+        atomic_thread_fence(memory_order_acquire);
+        seq_end = atomic_load_explicit(&VernonGt911->snapshot_seq, memory_order_relaxed);
+    } while ((seq_begin & 1) || seq_begin != seq_end);
+
+    return snapshot->touch_num > 0;
+}
+
+static void IRAM_ATTR GT911_isr_handler(void *arg)
+{
+    Vernon_GT911 *VernonGt911 = (Vernon_GT911 *)arg;
+    BaseType_t need_yield = pdFALSE;
+    vTaskNotifyGiveFromISR(VernonGt911->touch_task, &need_yield);
+    if (need_yield) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void GT911_touch_task(void *arg)
+{
+    Vernon_GT911 *VernonGt911 = (Vernon_GT911 *)arg;
+    GT911_snapshot snapshot;
+    while (1) {
+        // 等待INT引脚或GT911_request_read()的通知，空闲时不占用I2C总线
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (GT911_read_frame(VernonGt911) >= 0) {
+            GT911_publish_snapshot(VernonGt911);
+            ESP_LOGD(TAG, "frame: %d point(s), x: %d, y: %d", VernonGt911->touch_num,
+                     VernonGt911->points_info[0].x, VernonGt911->points_info[0].y);
+            if (VernonGt911->frame_cb) {
+                GT911_read_snapshot(VernonGt911, &snapshot);
+                VernonGt911->frame_cb(VernonGt911, &snapshot, VernonGt911->frame_cb_ctx);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 启动后台触控任务
+ * @param VernonGt911 类实例
+ * @param task_priority 触控任务优先级
+ * @return esp_err_t
+ */
+esp_err_t GT911_start_task(Vernon_GT911 * VernonGt911, UBaseType_t task_priority)
+{
+    if (VernonGt911->touch_task) {
+        return ESP_OK;
+    }
+    if (xTaskCreate(GT911_touch_task, "gt911", GT911_TOUCH_TASK_STACK_SIZE, VernonGt911,
+                    task_priority, &VernonGt911->touch_task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief 注册读取完成回调，回调在触控任务中执行
+ * @param VernonGt911 类实例
+ * @param cb 回调函数，NULL取消注册
+ * @param user_ctx 用户数据
+ */
+void GT911_register_frame_callback(Vernon_GT911 * VernonGt911, GT911_frame_cb_t cb, void *user_ctx)
+{
+    VernonGt911->frame_cb_ctx = user_ctx;
+    VernonGt911->frame_cb = cb;
+}
+
+/**
+ * @brief 异步请求读取一帧，结果通过快照和读取完成回调返回
+ * @param VernonGt911 类实例
+ */
+void GT911_request_read(Vernon_GT911 * VernonGt911)
+{
+    if (VernonGt911->touch_task) {
+        xTaskNotifyGive(VernonGt911->touch_task);
+    }
+}
+
+/**
+ * @brief 开启中断模式
+ * @param VernonGt911 类实例
+ * @param task_priority 触控任务优先级
+ * @return esp_err_t
+ */
+esp_err_t GT911_enable_interrupt(Vernon_GT911 * VernonGt911, UBaseType_t task_priority)
+{
+    if (VernonGt911->int_pin < 0) {
+        ESP_LOGE(TAG, "INT pin is not assigned");
+        return ESP_ERR_INVALID_ARG;
+    }
+    // MODULE_SWITCH_1[1:0]决定INT触发方式：0上升沿 1下降沿 2低电平 3高电平
+    uint8_t module_switch = 0;
+    ESP_RETURN_ON_ERROR(GT911_read_regs(VernonGt911, GT911_MODULE_SWITCH_1, &module_switch, 1), TAG,
+                        "read MODULE_SWITCH_1 failed");
+    gpio_int_type_t intr_type;
+    switch (module_switch & 0x03) {
+        case 0:
+            intr_type = GPIO_INTR_POSEDGE;
+            break;
+        case 1:
+            intr_type = GPIO_INTR_NEGEDGE;
+            break;
+        case 2:
+            intr_type = GPIO_INTR_LOW_LEVEL;
+            break;
+        default:
+            intr_type = GPIO_INTR_HIGH_LEVEL;
+            break;
+    }
+    if (intr_type == GPIO_INTR_LOW_LEVEL || intr_type == GPIO_INTR_HIGH_LEVEL) {
+        // 电平触发会在读取前反复进入中断，统一改为对应的边沿触发
+        intr_type = (intr_type == GPIO_INTR_LOW_LEVEL) ? GPIO_INTR_NEGEDGE : GPIO_INTR_POSEDGE;
+    }
+
+    esp_err_t err = GT911_start_task(VernonGt911, task_priority);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    gpio_config_t int_conf = {
+        .mode = GPIO_MODE_INPUT,
+        .pin_bit_mask = 1ULL << VernonGt911->int_pin,
+        .pull_up_en = GPIO_PULLUP_DISABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = intr_type,
+    };
+    err = gpio_config(&int_conf);
+    if (err == ESP_OK) {
+        err = gpio_install_isr_service(0);
+        if (err == ESP_ERR_INVALID_STATE) { //ISR服务已被其他模块安装
+            err = ESP_OK;
+        }
+    }
+    if (err == ESP_OK) {
+        err = gpio_isr_handler_add(VernonGt911->int_pin, GT911_isr_handler, VernonGt911);
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    // 清除可能已挂起的帧，保证下一次触摸能产生中断
+    GT911_request_read(VernonGt911);
+    ESP_LOGI(TAG, "interrupt mode on INT pin %d", VernonGt911->int_pin);
+    return ESP_OK;
 }
 
 /**
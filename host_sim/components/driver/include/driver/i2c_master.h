@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    I2C_NUM_0,
+    I2C_NUM_1,
+    I2C_NUM_MAX,
+} i2c_port_t;
+
+typedef enum {
+    I2C_CLK_SRC_DEFAULT,
+} i2c_clock_source_t;
+
+typedef enum {
+    I2C_ADDR_BIT_LEN_7,
+    I2C_ADDR_BIT_LEN_10,
+} i2c_addr_bit_len_t;
+
+typedef struct i2c_master_bus_t *i2c_master_bus_handle_t;
+typedef struct i2c_master_dev_t *i2c_master_dev_handle_t;
+
+/**
+ * @brief I2C master bus specific configurations
+ */
+typedef struct {
+    i2c_port_t i2c_port;            /*!< I2C port number, `-1` for auto selecting */
+    gpio_num_t sda_io_num;          /*!< GPIO number of I2C SDA signal, pulled-up */
+    gpio_num_t scl_io_num;          /*!< GPIO number of I2C SCL signal, pulled-up */
+    i2c_clock_source_t clk_source;  /*!< Clock source of I2C master bus */
+    uint8_t glitch_ignore_cnt;      /*!< If the glitch period on the line is less than this value, it can be filtered out */
+    int intr_priority;              /*!< I2C interrupt priority */
+    size_t trans_queue_depth;       /*!< Depth of internal transfer queue */
+    struct {
+        uint32_t enable_internal_pullup: 1; /*!< Enable internal pullups */
+    } flags;
+} i2c_master_bus_config_t;
+
+/**
+ * @brief I2C device configuration
+ */
+typedef struct {
+    i2c_addr_bit_len_t dev_addr_length; /*!< Select the address length of the slave device */
+    uint16_t device_address;            /*!< I2C device raw address (the 7/10 bit address without read/write bit) */
+    uint32_t scl_speed_hz;              /*!< I2C SCL line frequency */
+    uint32_t scl_wait_us;               /*!< Timeout value, in us */
+    struct {
+        uint32_t disable_ack_check: 1;  /*!< Disable ACK check */
+    } flags;
+} i2c_device_config_t;
+
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t *bus_config, i2c_master_bus_handle_t *ret_bus_handle);
+esp_err_t i2c_del_master_bus(i2c_master_bus_handle_t bus_handle);
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus_handle, const i2c_device_config_t *dev_config, i2c_master_dev_handle_t *ret_handle);
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle);
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size, int xfer_timeout_ms);
+esp_err_t i2c_master_receive(i2c_master_dev_handle_t i2c_dev, uint8_t *read_buffer, size_t read_size, int xfer_timeout_ms);
+esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size,
+                                      uint8_t *read_buffer, size_t read_size, int xfer_timeout_ms);
+esp_err_t i2c_master_probe(i2c_master_bus_handle_t bus_handle, uint16_t address, int xfer_timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,33 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "driver/gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Drive an input from outside the chip, runs the ISR handler if the edge matches the interrupt type
+ */
+void gpio_sim_drive_input(gpio_num_t gpio_num, uint32_t level);
+
+/**
+ * @brief Pulse an input to `level` and back to the opposite one, as a device signals an event on its interrupt line
+ */
+void gpio_sim_pulse_input(gpio_num_t gpio_num, uint32_t level);
+
+/**
+ * @brief Number of level changes of an output since it was configured, e.g. to spot a reset pulse
+ */
+uint32_t gpio_sim_get_transitions(gpio_num_t gpio_num);
+
+#ifdef __cplusplus
+}
+#endif
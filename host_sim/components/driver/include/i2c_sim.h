@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/i2c_master.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Simulated I2C device
+ */
+typedef struct {
+    /**
+     * @brief Handle one transaction: `write_size` bytes written, then `read_size` bytes read after a repeated start
+     *
+     * @return ESP_OK, or an error the master sees, e.g. ESP_ERR_TIMEOUT for a NACK
+     */
+    esp_err_t (*transfer)(void *ctx, const uint8_t *write_buf, size_t write_size, uint8_t *read_buf, size_t read_size);
+    void *ctx;  /*!< Passed to `transfer` */
+} i2c_sim_responder_t;
+
+/**
+ * @brief Traffic on a simulated I2C port
+ */
+typedef struct {
+    uint32_t transactions;  /*!< Transactions addressed to a responder */
+    uint32_t nacks;         /*!< Transactions nobody answered */
+    uint32_t bytes;         /*!< Data bytes written and read */
+    uint32_t bus_time_us;   /*!< Time on the wire at the device clock, 9 clocks per byte including the address bytes */
+} i2c_sim_stats_t;
+
+/**
+ * @brief Answer transactions to `address` on `port`, before or after the bus is created
+ */
+esp_err_t i2c_sim_attach(i2c_port_t port, uint16_t address, const i2c_sim_responder_t *responder);
+
+/**
+ * @brief Get the traffic statistics of a port, optionally clearing them
+ */
+void i2c_sim_get_stats(i2c_port_t port, i2c_sim_stats_t *stats, bool clear);
+
+#ifdef __cplusplus
+}
+#endif
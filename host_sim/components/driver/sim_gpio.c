@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdbool.h>
+#include "esp_check.h"
+#include "gpio_sim.h"
+
+static const char *TAG = "gpio_sim";
+
+static struct {
+    struct {
+        gpio_mode_t mode;
+        gpio_int_type_t intr_type;
+        uint8_t level;
+        bool hold;
+        uint32_t transitions;
+        gpio_isr_t isr;
+        void *isr_arg;
+    } pins[GPIO_NUM_MAX];
+    bool isr_service;
+} s_gpio;
+
+#define GPIO_SIM_CHECK_PIN(gpio_num) \
+    ESP_RETURN_ON_FALSE((gpio_num) >= 0 && (gpio_num) < GPIO_NUM_MAX, ESP_ERR_INVALID_ARG, TAG, "GPIO number error")
+
+esp_err_t gpio_config(const gpio_config_t *pGPIOConfig)
+{
+    ESP_RETURN_ON_FALSE(pGPIOConfig && pGPIOConfig->pin_bit_mask, ESP_ERR_INVALID_ARG, TAG, "GPIO_PIN mask error");
+    for (int i = 0; i < GPIO_NUM_MAX; i++) {
+        if (pGPIOConfig->pin_bit_mask & (1ULL << i)) {
+            // the output latch keeps a level set before, like the GPIO matrix does
+            s_gpio.pins[i].mode = pGPIOConfig->mode;
+            s_gpio.pins[i].intr_type = pGPIOConfig->intr_type;
+            s_gpio.pins[i].transitions = 0;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num)
+{
+    GPIO_SIM_CHECK_PIN(gpio_num);
+    s_gpio.pins[gpio_num].mode = GPIO_MODE_DISABLE;
+    s_gpio.pins[gpio_num].intr_type = GPIO_INTR_DISABLE;
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    GPIO_SIM_CHECK_PIN(gpio_num);
+    level = level ? 1 : 0;
+    if (s_gpio.pins[gpio_num].hold) {
+        return ESP_OK; // a held pad keeps its level
+    }
+    if (s_gpio.pins[gpio_num].level != level && s_gpio.pins[gpio_num].mode >= GPIO_MODE_OUTPUT) {
+        s_gpio.pins[gpio_num].transitions++;
+    }
+    s_gpio.pins[gpio_num].level = level;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    if (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) {
+        return 0;
+    }
+    return s_gpio.pins[gpio_num].level;
+}
+
+esp_err_t gpio_hold_en(gpio_num_t gpio_num)
+{
+    GPIO_SIM_CHECK_PIN(gpio_num);
+    s_gpio.pins[gpio_num].hold = true;
+    return ESP_OK;
+}
+
+esp_err_t gpio_hold_dis(gpio_num_t gpio_num)
+{
+    GPIO_SIM_CHECK_PIN(gpio_num);
+    s_gpio.pins[gpio_num].hold = false;
+    return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags)
+{
+    ESP_RETURN_ON_FALSE(!s_gpio.isr_service, ESP_ERR_INVALID_STATE, TAG, "GPIO isr service already installed");
+    s_gpio.isr_service = true;
+    return ESP_OK;
+}
+
+void gpio_uninstall_isr_service(void)
+{
+    s_gpio.isr_service = false;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args)
+{
+    GPIO_SIM_CHECK_PIN(gpio_num);
+    ESP_RETURN_ON_FALSE(s_gpio.isr_service, ESP_ERR_INVALID_STATE, TAG, "GPIO isr service is not installed");
+    s_gpio.pins[gpio_num].isr = isr_handler;
+    s_gpio.pins[gpio_num].isr_arg = args;
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num)
+{
+    GPIO_SIM_CHECK_PIN(gpio_num);
+    s_gpio.pins[gpio_num].isr = NULL;
+    return ESP_OK;
+}
+
+void gpio_sim_drive_input(gpio_num_t gpio_num, uint32_t level)
+{
+    if (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) {
+        return;
+    }
+    level = level ? 1 : 0;
+    uint8_t prev = s_gpio.pins[gpio_num].level;
+    s_gpio.pins[gpio_num].level = level;
+    bool fire;
+    switch (s_gpio.pins[gpio_num].intr_type) {
+    case GPIO_INTR_POSEDGE:
+        fire = !prev && level;
+        break;
+    case GPIO_INTR_NEGEDGE:
+        fire = prev && !level;
+        break;
+    case GPIO_INTR_ANYEDGE:
+        fire = prev != level;
+        break;
+    case GPIO_INTR_LOW_LEVEL:
+        fire = !level;
+        break;
+    case GPIO_INTR_HIGH_LEVEL:
+        fire = level;
+        break;
+    default:
+        fire = false;
+        break;
+    }
+    if (fire && s_gpio.isr_service && s_gpio.pins[gpio_num].isr) {
+        s_gpio.pins[gpio_num].isr(s_gpio.pins[gpio_num].isr_arg);
+    }
+}
+
+void gpio_sim_pulse_input(gpio_num_t gpio_num, uint32_t level)
+{
+    // from the idle level to `level` and back, the ISR handler runs for the edges the pin is configured for
+    level = level ? 1 : 0;
+    gpio_sim_drive_input(gpio_num, !level);
+    gpio_sim_drive_input(gpio_num, level);
+    gpio_sim_drive_input(gpio_num, !level);
+}
+
+uint32_t gpio_sim_get_transitions(gpio_num_t gpio_num)
+{
+    if (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) {
+        return 0;
+    }
+    return s_gpio.pins[gpio_num].transitions;
+}
@@ -0,0 +1,147 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "esp_check.h"
+#include "i2c_sim.h"
+
+#define I2C_SIM_MAX_RESPONDERS  8
+#define I2C_SIM_DEFAULT_SCL_HZ  100000
+#define I2C_SIM_CLOCKS_PER_BYTE 9 // 8 data bits and the ACK
+
+static const char *TAG = "i2c_sim";
+
+struct i2c_master_bus_t {
+    i2c_port_t port;
+};
+
+struct i2c_master_dev_t {
+    i2c_master_bus_handle_t bus;
+    uint16_t address;
+    uint32_t scl_speed_hz;
+};
+
+static struct {
+    struct {
+        i2c_port_t port;
+        uint16_t address;
+        i2c_sim_responder_t responder;
+    } responders[I2C_SIM_MAX_RESPONDERS];
+    size_t num_responders;
+    i2c_master_bus_handle_t buses[I2C_NUM_MAX];
+    i2c_sim_stats_t stats[I2C_NUM_MAX];
+} s_i2c;
+
+static const i2c_sim_responder_t *i2c_sim_find(i2c_port_t port, uint16_t address)
+{
+    for (size_t i = 0; i < s_i2c.num_responders; i++) {
+        if (s_i2c.responders[i].port == port && s_i2c.responders[i].address == address) {
+            return &s_i2c.responders[i].responder;
+        }
+    }
+    return NULL;
+}
+
+esp_err_t i2c_sim_attach(i2c_port_t port, uint16_t address, const i2c_sim_responder_t *responder)
+{
+    ESP_RETURN_ON_FALSE(port >= 0 && port < I2C_NUM_MAX && responder && responder->transfer, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!i2c_sim_find(port, address), ESP_ERR_INVALID_STATE, TAG, "address 0x%02x is taken", address);
+    ESP_RETURN_ON_FALSE(s_i2c.num_responders < I2C_SIM_MAX_RESPONDERS, ESP_ERR_NO_MEM, TAG, "too many responders");
+    s_i2c.responders[s_i2c.num_responders].port = port;
+    s_i2c.responders[s_i2c.num_responders].address = address;
+    s_i2c.responders[s_i2c.num_responders].responder = *responder;
+    s_i2c.num_responders++;
+    return ESP_OK;
+}
+
+void i2c_sim_get_stats(i2c_port_t port, i2c_sim_stats_t *stats, bool clear)
+{
+    *stats = s_i2c.stats[port];
+    if (clear) {
+        memset(&s_i2c.stats[port], 0, sizeof(s_i2c.stats[port]));
+    }
+}
+
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t *bus_config, i2c_master_bus_handle_t *ret_bus_handle)
+{
+    ESP_RETURN_ON_FALSE(bus_config && ret_bus_handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    i2c_port_t port = bus_config->i2c_port;
+    if ((int)port == -1) {
+        for (port = I2C_NUM_0; port < I2C_NUM_MAX && s_i2c.buses[port]; port++) {
+        }
+    }
+    ESP_RETURN_ON_FALSE(port >= 0 && port < I2C_NUM_MAX, ESP_ERR_NOT_FOUND, TAG, "no free bus");
+    ESP_RETURN_ON_FALSE(!s_i2c.buses[port], ESP_ERR_INVALID_STATE, TAG, "I2C bus id(%d) has already been acquired", port);
+    i2c_master_bus_handle_t bus = calloc(1, sizeof(struct i2c_master_bus_t));
+    ESP_RETURN_ON_FALSE(bus, ESP_ERR_NO_MEM, TAG, "no memory for i2c master bus");
+    bus->port = port;
+    s_i2c.buses[port] = bus;
+    *ret_bus_handle = bus;
+    return ESP_OK;
+}
+
+esp_err_t i2c_del_master_bus(i2c_master_bus_handle_t bus_handle)
+{
+    ESP_RETURN_ON_FALSE(bus_handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    s_i2c.buses[bus_handle->port] = NULL;
+    free(bus_handle);
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus_handle, const i2c_device_config_t *dev_config, i2c_master_dev_handle_t *ret_handle)
+{
+    ESP_RETURN_ON_FALSE(bus_handle && dev_config && ret_handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    i2c_master_dev_handle_t dev = calloc(1, sizeof(struct i2c_master_dev_t));
+    ESP_RETURN_ON_FALSE(dev, ESP_ERR_NO_MEM, TAG, "no memory for i2c master device");
+    dev->bus = bus_handle;
+    dev->address = dev_config->device_address;
+    dev->scl_speed_hz = dev_config->scl_speed_hz ? dev_config->scl_speed_hz : I2C_SIM_DEFAULT_SCL_HZ;
+    *ret_handle = dev;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(handle);
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size,
+                                      uint8_t *read_buffer, size_t read_size, int xfer_timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(i2c_dev, ESP_ERR_INVALID_ARG, TAG, "i2c handle not initialized");
+    i2c_port_t port = i2c_dev->bus->port;
+    i2c_sim_stats_t *stats = &s_i2c.stats[port];
+    // address byte of each phase, then the data
+    uint32_t bytes = (write_size ? 1 : 0) + (read_size ? 1 : 0) + write_size + read_size;
+    stats->bus_time_us += (uint32_t)((uint64_t)bytes * I2C_SIM_CLOCKS_PER_BYTE * 1000000 / i2c_dev->scl_speed_hz);
+
+    const i2c_sim_responder_t *responder = i2c_sim_find(port, i2c_dev->address);
+    if (!responder) {
+        stats->nacks++;
+        return ESP_ERR_INVALID_STATE;
+    }
+    stats->transactions++;
+    stats->bytes += write_size + read_size;
+    return responder->transfer(responder->ctx, write_buffer, write_size, read_buffer, read_size);
+}
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size, int xfer_timeout_ms)
+{
+    return i2c_master_transmit_receive(i2c_dev, write_buffer, write_size, NULL, 0, xfer_timeout_ms);
+}
+
+esp_err_t i2c_master_receive(i2c_master_dev_handle_t i2c_dev, uint8_t *read_buffer, size_t read_size, int xfer_timeout_ms)
+{
+    return i2c_master_transmit_receive(i2c_dev, NULL, 0, read_buffer, read_size, xfer_timeout_ms);
+}
+
+esp_err_t i2c_master_probe(i2c_master_bus_handle_t bus_handle, uint16_t address, int xfer_timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(bus_handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    return i2c_sim_find(bus_handle->port, address) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
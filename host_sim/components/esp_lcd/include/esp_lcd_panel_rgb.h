@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_lcd_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_LCD_RGB_BUS_WIDTH_MAX 24 /*!< Widest data bus the panel accepts */
+
+/**
+ * @brief LCD RGB timing structure
+ */
+typedef struct {
+    uint32_t pclk_hz;           /*!< Frequency of pixel clock */
+    uint32_t h_res;             /*!< Horizontal resolution, i.e. the number of pixels in a line */
+    uint32_t v_res;             /*!< Vertical resolution, i.e. the number of lines in the frame  */
+    uint32_t hsync_pulse_width; /*!< Horizontal sync width, unit: PCLK period */
+    uint32_t hsync_back_porch;  /*!< Horizontal back porch, number of PCLK between hsync and start of line active data */
+    uint32_t hsync_front_porch; /*!< Horizontal front porch, number of PCLK between the end of active data and the next hsync */
+    uint32_t vsync_pulse_width; /*!< Vertical sync width, unit: number of lines */
+    uint32_t vsync_back_porch;  /*!< Vertical back porch, number of invalid lines between vsync and start of frame */
+    uint32_t vsync_front_porch; /*!< Vertical front porch, number of invalid lines between the end of frame and the next vsync */
+    struct {
+        uint32_t hsync_idle_low: 1;  /*!< The hsync signal is low in IDLE state */
+        uint32_t vsync_idle_low: 1;  /*!< The vsync signal is low in IDLE state */
+        uint32_t de_idle_high: 1;    /*!< The de signal is high in IDLE state */
+        uint32_t pclk_active_neg: 1; /*!< Whether the display data is clocked out on the falling edge of PCLK */
+        uint32_t pclk_idle_high: 1;  /*!< The PCLK stays at high level in IDLE phase */
+    } flags;                         /*!< LCD RGB timing flags */
+} esp_lcd_rgb_timing_t;
+
+/**
+ * @brief Type of RGB LCD panel event data, nothing is reported yet
+ */
+typedef struct {
+} esp_lcd_rgb_panel_event_data_t;
+
+/**
+ * @brief RGB LCD VSYNC event callback prototype
+ *
+ * @return Whether a high priority task has been waken up by this function
+ */
+typedef bool (*esp_lcd_rgb_panel_vsync_cb_t)(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_data_t *edata, void *user_ctx);
+
+/**
+ * @brief Prototype for function to re-fill a bounce buffer, rather than copying from the frame buffer
+ *
+ * @return Whether a high priority task has been waken up by this function
+ */
+typedef bool (*esp_lcd_rgb_panel_bounce_buf_fill_cb_t)(esp_lcd_panel_handle_t panel, void *bounce_buf, int pos_px, int len_bytes, void *user_ctx);
+
+/**
+ * @brief Prototype for the function to be called when the bounce buffer finish copying the entire frame
+ */
+typedef bool (*esp_lcd_rgb_panel_frame_buf_complete_cb_t)(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_data_t *edata, void *user_ctx);
+
+/**
+ * @brief Group of supported RGB LCD panel callbacks
+ */
+typedef struct {
+    esp_lcd_rgb_panel_vsync_cb_t on_color_trans_done;              /*!< A draw_bitmap() copy into the frame buffer is done */
+    esp_lcd_rgb_panel_vsync_cb_t on_vsync;                         /*!< VSYNC event callback */
+    esp_lcd_rgb_panel_bounce_buf_fill_cb_t on_bounce_empty;        /*!< Bounce buffer empty callback */
+    esp_lcd_rgb_panel_frame_buf_complete_cb_t on_bounce_frame_finish; /*!< The bounce buffers finished the whole frame */
+} esp_lcd_rgb_panel_event_callbacks_t;
+
+/**
+ * @brief LCD RGB panel configuration structure
+ */
+typedef struct {
+    lcd_clock_source_t clk_src;   /*!< Clock source for the RGB LCD peripheral */
+    esp_lcd_rgb_timing_t timings; /*!< RGB timing parameters, including the screen resolution */
+    size_t data_width;            /*!< Number of data lines */
+    size_t bits_per_pixel;        /*!< Frame buffer color depth, in bpp, defaults to `data_width` */
+    size_t num_fbs;               /*!< Number of screen-sized frame buffers that allocated by the driver, 1 if left 0 */
+    size_t bounce_buffer_size_px; /*!< If it's non-zero, the driver allocates two DRAM bounce buffers for DMA use */
+    size_t sram_trans_align;      /*!< Alignment of buffers (frame buffer or bounce buffer) that allocated in SRAM */
+    union {
+        size_t psram_trans_align; /*!< Alignment of buffers (frame buffer) that allocated in PSRAM */
+        size_t dma_burst_size;    /*!< DMA burst size, in bytes */
+    };
+    int hsync_gpio_num;           /*!< GPIO used for HSYNC signal */
+    int vsync_gpio_num;           /*!< GPIO used for VSYNC signal */
+    int de_gpio_num;              /*!< GPIO used for DE signal, set to -1 if it's not used */
+    int pclk_gpio_num;            /*!< GPIO used for PCLK signal, set to -1 if it's not used */
+    int disp_gpio_num;            /*!< GPIO used for display control signal, set to -1 if it's not used */
+    int data_gpio_nums[ESP_LCD_RGB_BUS_WIDTH_MAX]; /*!< GPIOs used for data lines */
+    struct {
+        uint32_t disp_active_low: 1;     /*!< If this flag is enabled, a low level of display control signal can turn the screen on */
+        uint32_t refresh_on_demand: 1;   /*!< The frame is only scanned out by `esp_lcd_rgb_panel_refresh()` */
+        uint32_t fb_in_psram: 1;         /*!< If this flag is enabled, the frame buffer will be allocated from PSRAM, preferentially */
+        uint32_t double_fb: 1;           /*!< If this flag is enabled, the driver will allocate two screen sized frame buffer, same as num_fbs=2 */
+        uint32_t no_fb: 1;               /*!< If this flag is enabled, the driver won't allocate frame buffer. Instead, user should fill in the bounce buffer manually in the `on_bounce_empty` callback */
+        uint32_t bb_invalidate_cache: 1; /*!< If this flag is enabled, in bounce back mode we'll do a cache invalidate on the read data, freeing the cache */
+    } flags;                             /*!< LCD RGB panel configuration flags */
+} esp_lcd_rgb_panel_config_t;
+
+/**
+ * @brief Create RGB LCD panel, the frame buffers live in host memory.
+ *
+ * From the first `esp_lcd_panel_init()` on, a task scans them out at the refresh rate of the timings, unless
+ * `refresh_on_demand` is set, then only `esp_lcd_rgb_panel_refresh()` or `esp_lcd_sim_rgb_panel_scan_out()` do
+ */
+esp_err_t esp_lcd_new_rgb_panel(const esp_lcd_rgb_panel_config_t *rgb_panel_config, esp_lcd_panel_handle_t *ret_panel);
+
+/**
+ * @brief Register LCD RGB panel event callbacks
+ */
+esp_err_t esp_lcd_rgb_panel_register_event_callbacks(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_callbacks_t *callbacks, void *user_ctx);
+
+/**
+ * @brief Get the address of the frame buffer(s) that allocated by the driver
+ */
+esp_err_t esp_lcd_rgb_panel_get_frame_buffer(esp_lcd_panel_handle_t panel, uint32_t fb_num, void **fb0, ...);
+
+/**
+ * @brief Manually trigger once transmission of the frame buffer to the LCD panel
+ */
+esp_err_t esp_lcd_rgb_panel_refresh(esp_lcd_panel_handle_t panel);
+
+/**
+ * @brief Restart the LCD transmission
+ */
+esp_err_t esp_lcd_rgb_panel_restart(esp_lcd_panel_handle_t panel);
+
+#ifdef __cplusplus
+}
+#endif
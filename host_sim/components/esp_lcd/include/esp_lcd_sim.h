@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_lcd_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Command sent through a recording panel IO
+ */
+typedef struct {
+    int cmd;                /*!< Command */
+    uint32_t param_offset;  /*!< Offset of the parameters in the parameter log */
+    uint32_t param_size;    /*!< Number of parameter bytes */
+    int64_t time_us;        /*!< When the command was sent (esp_timer time) */
+} esp_lcd_sim_io_record_t;
+
+/**
+ * @brief Recording 3-wire SPI panel IO configuration
+ */
+typedef struct {
+    size_t max_records;     /*!< Commands kept, later ones are only counted */
+    size_t max_param_bytes; /*!< Parameter bytes kept */
+    uint32_t scl_hz;        /*!< SPI clock the bus time is estimated with */
+} esp_lcd_sim_panel_io_config_t;
+
+/**
+ * @brief Traffic through a recording panel IO
+ */
+typedef struct {
+    uint32_t cmds;          /*!< Commands sent */
+    uint32_t param_bytes;   /*!< Parameter bytes sent */
+    uint32_t dropped;       /*!< Commands not recorded, the log was full */
+    uint64_t bus_bits;      /*!< Bits on the wire, every byte goes out as a 9-bit word with its D/C bit */
+    uint32_t bus_time_us;   /*!< Time the bits take at `scl_hz` */
+} esp_lcd_sim_panel_io_stats_t;
+
+/**
+ * @brief Frames and writes seen by a simulated RGB panel
+ */
+typedef struct {
+    uint32_t frames;        /*!< Frames scanned out */
+    uint32_t frame_us;      /*!< Refresh period of the timings, the scan-out task runs at it rounded to the tick */
+    uint32_t draw_bitmaps;  /*!< draw_bitmap() calls */
+    uint64_t draw_bytes;    /*!< Bytes copied into the frame buffer by draw_bitmap() */
+    uint32_t fb_switches;   /*!< draw_bitmap() calls that switched the frame buffer being scanned out */
+    uint32_t bounce_fills;  /*!< Bounce buffer refills */
+    uint64_t scan_out_us;   /*!< Time in the scan-out, the bounce buffer refills and the VSYNC callback included */
+    size_t buffer_bytes;    /*!< Frame and bounce buffers the driver allocates on the chip, the screen image is not counted */
+} esp_lcd_sim_rgb_panel_stats_t;
+
+/**
+ * @brief Create a panel IO that records every command instead of driving a 3-wire SPI bus
+ */
+esp_err_t esp_lcd_sim_new_panel_io_3wire(const esp_lcd_sim_panel_io_config_t *config, esp_lcd_panel_io_handle_t *ret_io);
+
+/**
+ * @brief Get the commands recorded so far
+ *
+ * @param[in]  io      Panel IO created by `esp_lcd_sim_new_panel_io_3wire()`
+ * @param[out] records Recorded commands
+ * @param[out] params  Parameter log the records point into
+ * @return Number of records
+ */
+size_t esp_lcd_sim_panel_io_get_records(esp_lcd_panel_io_handle_t io, const esp_lcd_sim_io_record_t **records, const uint8_t **params);
+
+/**
+ * @brief Make one command fail, as a bus error would
+ *
+ * @param[in] io   Panel IO created by `esp_lcd_sim_new_panel_io_3wire()`
+ * @param[in] cmds Commands sent normally before the failing one
+ * @param[in] err  Error the failing command returns, ESP_OK to cancel. The command is neither counted nor recorded
+ */
+void esp_lcd_sim_panel_io_fail_at(esp_lcd_panel_io_handle_t io, uint32_t cmds, esp_err_t err);
+
+/**
+ * @brief Get the traffic statistics, optionally forgetting the records
+ */
+void esp_lcd_sim_panel_io_get_stats(esp_lcd_panel_io_handle_t io, esp_lcd_sim_panel_io_stats_t *stats, bool clear);
+
+/**
+ * @brief Scan out one frame: refill the bounce buffers or read the current frame buffer, then report VSYNC
+ *
+ * @return ESP_ERR_INVALID_STATE if the panel is not initialized yet
+ */
+esp_err_t esp_lcd_sim_rgb_panel_scan_out(esp_lcd_panel_handle_t panel);
+
+/**
+ * @brief Called by the scan-out task of a simulated RGB panel after each frame
+ *
+ * @note Weak and empty, the board of a simulation overrides it to drive its inputs along the frames
+ *
+ * @param[in] panel Panel created by `esp_lcd_new_rgb_panel()`
+ * @param[in] frame Frames scanned out so far, this one included
+ */
+void esp_lcd_sim_rgb_panel_on_frame(esp_lcd_panel_handle_t panel, uint32_t frame);
+
+/**
+ * @brief Get the last frame scanned out, as the panel would show it
+ *
+ * @param[in]  panel          Panel created by `esp_lcd_new_rgb_panel()`
+ * @param[out] h_res          Optional, pixels per line
+ * @param[out] v_res          Optional, lines
+ * @param[out] bits_per_pixel Optional, pixel format of the frame
+ * @return The frame, packed lines
+ */
+const void *esp_lcd_sim_rgb_panel_get_screen(esp_lcd_panel_handle_t panel, uint32_t *h_res, uint32_t *v_res, uint32_t *bits_per_pixel);
+
+/**
+ * @brief Get the statistics of a simulated RGB panel
+ */
+void esp_lcd_sim_rgb_panel_get_stats(esp_lcd_panel_handle_t panel, esp_lcd_sim_rgb_panel_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief RGB element order
+ */
+typedef enum {
+    LCD_RGB_ELEMENT_ORDER_RGB, /*!< RGB element order: RGB */
+    LCD_RGB_ELEMENT_ORDER_BGR, /*!< RGB element order: BGR */
+} lcd_rgb_element_order_t;
+
+/**
+ * @brief RGB data endian
+ */
+typedef enum {
+    LCD_RGB_DATA_ENDIAN_BIG,    /*!< RGB data endian: MSB first */
+    LCD_RGB_DATA_ENDIAN_LITTLE, /*!< RGB data endian: LSB first */
+} lcd_rgb_data_endian_t;
+
+/**
+ * @brief LCD clock source, the simulated panel has a single one
+ */
+typedef enum {
+    LCD_CLK_SRC_DEFAULT,
+} lcd_clock_source_t;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <sys/cdefs.h>
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_lcd_panel_io.h"
+#include "esp_lcd_sim.h"
+
+#define SIM_3WIRE_BITS_PER_BYTE 9 // D/C bit, then the byte
+
+static const char *TAG = "lcd_sim_io";
+
+typedef struct {
+    esp_lcd_panel_io_t base;
+    esp_lcd_sim_panel_io_config_t config;
+    esp_lcd_sim_io_record_t *records;
+    uint8_t *params;
+    size_t num_records;
+    size_t num_param_bytes;
+    esp_lcd_sim_panel_io_stats_t stats;
+    uint32_t fail_at;       // commands to send before the failing one
+    esp_err_t fail_err;     // ESP_OK when no failure is set
+} sim_panel_io_t;
+
+static esp_err_t sim_io_tx_param(esp_lcd_panel_io_t *io, int lcd_cmd, const void *param, size_t param_size)
+{
+    sim_panel_io_t *sim = __containerof(io, sim_panel_io_t, base);
+    ESP_RETURN_ON_FALSE(param || !param_size, ESP_ERR_INVALID_ARG, TAG, "invalid parameters");
+    if (sim->fail_err != ESP_OK && sim->stats.cmds == sim->fail_at) {
+        // nothing goes on the wire, once
+        esp_err_t err = sim->fail_err;
+        sim->fail_err = ESP_OK;
+        return err;
+    }
+
+    sim->stats.cmds++;
+    sim->stats.param_bytes += param_size;
+    sim->stats.bus_bits += (1 + param_size) * SIM_3WIRE_BITS_PER_BYTE;
+    if (sim->num_records == sim->config.max_records || sim->num_param_bytes + param_size > sim->config.max_param_bytes) {
+        sim->stats.dropped++;
+        return ESP_OK;
+    }
+    esp_lcd_sim_io_record_t *record = &sim->records[sim->num_records++];
+    record->cmd = lcd_cmd;
+    record->param_offset = sim->num_param_bytes;
+    record->param_size = param_size;
+    record->time_us = esp_timer_get_time();
+    if (param_size) {
+        memcpy(sim->params + sim->num_param_bytes, param, param_size);
+        sim->num_param_bytes += param_size;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t sim_io_tx_color(esp_lcd_panel_io_t *io, int lcd_cmd, const void *color, size_t color_size)
+{
+    // a 3-wire SPI panel IO only configures the panel, pixels go through the RGB interface
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static esp_err_t sim_io_del(esp_lcd_panel_io_t *io)
+{
+    sim_panel_io_t *sim = __containerof(io, sim_panel_io_t, base);
+    free(sim->records);
+    free(sim->params);
+    free(sim);
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_sim_new_panel_io_3wire(const esp_lcd_sim_panel_io_config_t *config, esp_lcd_panel_io_handle_t *ret_io)
+{
+    ESP_RETURN_ON_FALSE(config && ret_io && config->scl_hz, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    sim_panel_io_t *sim = calloc(1, sizeof(sim_panel_io_t));
+    ESP_RETURN_ON_FALSE(sim, ESP_ERR_NO_MEM, TAG, "no mem for panel io");
+    sim->records = calloc(config->max_records ? config->max_records : 1, sizeof(esp_lcd_sim_io_record_t));
+    sim->params = malloc(config->max_param_bytes ? config->max_param_bytes : 1);
+    if (!sim->records || !sim->params) {
+        sim_io_del(&sim->base);
+        return ESP_ERR_NO_MEM;
+    }
+    sim->config = *config;
+    sim->base.tx_param = sim_io_tx_param;
+    sim->base.tx_color = sim_io_tx_color;
+    sim->base.del = sim_io_del;
+    *ret_io = &sim->base;
+    return ESP_OK;
+}
+
+size_t esp_lcd_sim_panel_io_get_records(esp_lcd_panel_io_handle_t io, const esp_lcd_sim_io_record_t **records, const uint8_t **params)
+{
+    sim_panel_io_t *sim = __containerof(io, sim_panel_io_t, base);
+    *records = sim->records;
+    *params = sim->params;
+    return sim->num_records;
+}
+
+void esp_lcd_sim_panel_io_fail_at(esp_lcd_panel_io_handle_t io, uint32_t cmds, esp_err_t err)
+{
+    sim_panel_io_t *sim = __containerof(io, sim_panel_io_t, base);
+    sim->fail_at = sim->stats.cmds + cmds;
+    sim->fail_err = err;
+}
+
+void esp_lcd_sim_panel_io_get_stats(esp_lcd_panel_io_handle_t io, esp_lcd_sim_panel_io_stats_t *stats, bool clear)
+{
+    sim_panel_io_t *sim = __containerof(io, sim_panel_io_t, base);
+    *stats = sim->stats;
+    stats->bus_time_us = (uint32_t)(sim->stats.bus_bits * 1000000 / sim->config.scl_hz);
+    if (clear) {
+        memset(&sim->stats, 0, sizeof(sim->stats));
+        sim->num_records = 0;
+        sim->num_param_bytes = 0;
+    }
+}
@@ -0,0 +1,341 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/cdefs.h>
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_lcd_panel_interface.h"
+#include "esp_lcd_panel_rgb.h"
+#include "esp_lcd_sim.h"
+
+#define SIM_RGB_MAX_FBS             3
+#define SIM_RGB_SCAN_TASK_STACK     4096
+#define SIM_RGB_SCAN_TASK_PRIORITY  (configMAX_PRIORITIES - 1) // the callbacks run from ISRs on the chip
+
+static const char *TAG = "lcd_sim_rgb";
+
+typedef struct {
+    esp_lcd_panel_t base;
+    uint32_t h_res;
+    uint32_t v_res;
+    uint32_t bits_per_pixel;
+    size_t fb_size;
+    size_t num_fbs;
+    uint8_t *fbs[SIM_RGB_MAX_FBS];
+    uint8_t *cur_fb;                // frame buffer being scanned out, NULL in no_fb mode
+    uint8_t *screen;                // last frame scanned out
+    uint8_t *bounce_buf;
+    size_t bounce_size;
+    uint32_t frame_us;              // refresh period, from the timings
+    TaskHandle_t scan_task;         // scans out at the refresh rate, NULL with refresh_on_demand
+    esp_lcd_rgb_panel_event_callbacks_t cbs;
+    void *user_ctx;
+    struct {
+        unsigned int initialized: 1;
+        unsigned int disp_on: 1;
+        unsigned int mirror_x: 1;
+        unsigned int mirror_y: 1;
+        unsigned int refresh_on_demand: 1;
+    } flags;
+    esp_lcd_sim_rgb_panel_stats_t stats;
+} sim_rgb_panel_t;
+
+static esp_err_t sim_rgb_panel_reset(esp_lcd_panel_t *panel)
+{
+    sim_rgb_panel_t *sim = __containerof(panel, sim_rgb_panel_t, base);
+    sim->flags.initialized = 0;
+    return ESP_OK;
+}
+
+__attribute__((weak)) void esp_lcd_sim_rgb_panel_on_frame(esp_lcd_panel_handle_t panel, uint32_t frame)
+{
+}
+
+static void sim_rgb_panel_scan_task(void *arg)
+{
+    sim_rgb_panel_t *sim = arg;
+    // to the tick, a faster tick gets closer to the refresh rate of the timings
+    TickType_t period = pdMS_TO_TICKS(sim->frame_us / 1000);
+    if (!period) {
+        period = 1;
+    }
+    TickType_t wake = xTaskGetTickCount();
+    while (1) {
+        vTaskDelayUntil(&wake, period);
+        // a reset stops the scan-out until the panel is initialized again
+        if (sim->flags.initialized && esp_lcd_sim_rgb_panel_scan_out(&sim->base) == ESP_OK) {
+            esp_lcd_sim_rgb_panel_on_frame(&sim->base, sim->stats.frames);
+        }
+    }
+}
+
+static esp_err_t sim_rgb_panel_init(esp_lcd_panel_t *panel)
+{
+    sim_rgb_panel_t *sim = __containerof(panel, sim_rgb_panel_t, base);
+    sim->flags.initialized = 1;
+    // like the LCD_CAM, the scan-out runs on its own from the first init on
+    if (!sim->flags.refresh_on_demand && !sim->scan_task) {
+        ESP_RETURN_ON_FALSE(xTaskCreate(sim_rgb_panel_scan_task, "lcd_sim_scan", SIM_RGB_SCAN_TASK_STACK, sim,
+                                        SIM_RGB_SCAN_TASK_PRIORITY, &sim->scan_task) == pdPASS,
+                            ESP_ERR_NO_MEM, TAG, "create scan-out task failed");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t sim_rgb_panel_del(esp_lcd_panel_t *panel)
+{
+    sim_rgb_panel_t *sim = __containerof(panel, sim_rgb_panel_t, base);
+    if (sim->scan_task) {
+        vTaskDelete(sim->scan_task);
+    }
+    for (size_t i = 0; i < sim->num_fbs; i++) {
+        free(sim->fbs[i]);
+    }
+    free(sim->bounce_buf);
+    free(sim->screen);
+    free(sim);
+    return ESP_OK;
+}
+
+static esp_err_t sim_rgb_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, int y_start, int x_end, int y_end, const void *color_data)
+{
+    sim_rgb_panel_t *sim = __containerof(panel, sim_rgb_panel_t, base);
+    ESP_RETURN_ON_FALSE(sim->num_fbs, ESP_ERR_NOT_SUPPORTED, TAG, "no frame buffer installed");
+    ESP_RETURN_ON_FALSE(x_start < x_end && y_start < y_end, ESP_ERR_INVALID_ARG, TAG, "start position must be smaller than end position");
+    sim->stats.draw_bitmaps++;
+
+    // a whole frame buffer of the driver is switched to, not copied
+    for (size_t i = 0; i < sim->num_fbs; i++) {
+        if (color_data == sim->fbs[i]) {
+            if (sim->cur_fb != sim->fbs[i]) {
+                sim->cur_fb = sim->fbs[i];
+                sim->stats.fb_switches++;
+            }
+            return ESP_OK;
+        }
+    }
+
+    x_end = x_end > (int)sim->h_res ? (int)sim->h_res : x_end;
+    y_end = y_end > (int)sim->v_res ? (int)sim->v_res : y_end;
+    const size_t px_size = sim->bits_per_pixel / 8;
+    const size_t src_stride = (x_end - x_start) * px_size;
+    const uint8_t *src = color_data;
+    for (int y = y_start; y < y_end; y++) {
+        memcpy(sim->cur_fb + (y * sim->h_res + x_start) * px_size, src, src_stride);
+        src += src_stride;
+    }
+    sim->stats.draw_bytes += (uint64_t)src_stride * (y_end - y_start);
+    if (sim->cbs.on_color_trans_done) {
+        sim->cbs.on_color_trans_done(panel, NULL, sim->user_ctx);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t sim_rgb_panel_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool mirror_y)
+{
+    sim_rgb_panel_t *sim = __containerof(panel, sim_rgb_panel_t, base);
+    sim->flags.mirror_x = mirror_x;
+    sim->flags.mirror_y = mirror_y;
+    return ESP_OK;
+}
+
+static esp_err_t sim_rgb_panel_swap_xy(esp_lcd_panel_t *panel, bool swap_axes)
+{
+    // same as the LCD_CAM driver, a swap needs a frame buffer rotated in software
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static esp_err_t sim_rgb_panel_set_gap(esp_lcd_panel_t *panel, int x_gap, int y_gap)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static esp_err_t sim_rgb_panel_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
+{
+    sim_rgb_panel_t *sim = __containerof(panel, sim_rgb_panel_t, base);
+    sim->flags.disp_on = on_off;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_new_rgb_panel(const esp_lcd_rgb_panel_config_t *rgb_panel_config, esp_lcd_panel_handle_t *ret_panel)
+{
+    ESP_RETURN_ON_FALSE(rgb_panel_config && ret_panel, ESP_ERR_INVALID_ARG, TAG, "invalid parameter");
+    const esp_lcd_rgb_timing_t *timings = &rgb_panel_config->timings;
+    ESP_RETURN_ON_FALSE(timings->h_res && timings->v_res, ESP_ERR_INVALID_ARG, TAG, "invalid resolution");
+    size_t bits_per_pixel = rgb_panel_config->bits_per_pixel ? rgb_panel_config->bits_per_pixel : rgb_panel_config->data_width;
+    ESP_RETURN_ON_FALSE(bits_per_pixel == 16 || bits_per_pixel == 24, ESP_ERR_NOT_SUPPORTED, TAG, "unsupported pixel format");
+    size_t num_fbs = rgb_panel_config->flags.double_fb ? 2 : (rgb_panel_config->num_fbs ? rgb_panel_config->num_fbs : 1);
+    if (rgb_panel_config->flags.no_fb) {
+        ESP_RETURN_ON_FALSE(rgb_panel_config->bounce_buffer_size_px, ESP_ERR_INVALID_ARG, TAG, "must set bounce buffer if there's no frame buffer");
+        num_fbs = 0;
+    }
+    ESP_RETURN_ON_FALSE(num_fbs <= SIM_RGB_MAX_FBS, ESP_ERR_INVALID_ARG, TAG, "too many frame buffers");
+    ESP_RETURN_ON_FALSE(timings->pclk_hz, ESP_ERR_INVALID_ARG, TAG, "invalid pixel clock");
+
+    esp_err_t ret = ESP_OK;
+    sim_rgb_panel_t *sim = calloc(1, sizeof(sim_rgb_panel_t));
+    ESP_RETURN_ON_FALSE(sim, ESP_ERR_NO_MEM, TAG, "no mem for rgb panel");
+    sim->h_res = timings->h_res;
+    sim->v_res = timings->v_res;
+    sim->bits_per_pixel = bits_per_pixel;
+    sim->fb_size = (size_t)timings->h_res * timings->v_res * bits_per_pixel / 8;
+    sim->num_fbs = num_fbs;
+    for (size_t i = 0; i < num_fbs; i++) {
+        sim->fbs[i] = calloc(1, sim->fb_size);
+        ESP_GOTO_ON_FALSE(sim->fbs[i], ESP_ERR_NO_MEM, err, TAG, "no mem for frame buffer");
+    }
+    sim->cur_fb = sim->fbs[0];
+    if (rgb_panel_config->bounce_buffer_size_px) {
+        sim->bounce_size = rgb_panel_config->bounce_buffer_size_px * bits_per_pixel / 8;
+        ESP_GOTO_ON_FALSE(sim->fb_size % sim->bounce_size == 0, ESP_ERR_INVALID_ARG, err, TAG,
+                          "frame buffer size must be a multiple of the bounce buffer size");
+        sim->bounce_buf = calloc(1, sim->bounce_size);
+        ESP_GOTO_ON_FALSE(sim->bounce_buf, ESP_ERR_NO_MEM, err, TAG, "no mem for bounce buffer");
+    }
+    // two bounce buffers on the chip, the simulation refills one at a time
+    sim->stats.buffer_bytes = sim->fb_size * num_fbs + sim->bounce_size * 2;
+    sim->screen = calloc(1, sim->fb_size);
+    ESP_GOTO_ON_FALSE(sim->screen, ESP_ERR_NO_MEM, err, TAG, "no mem for screen");
+    sim->flags.disp_on = 1;
+    sim->flags.refresh_on_demand = rgb_panel_config->flags.refresh_on_demand;
+    const uint64_t h_total = timings->hsync_pulse_width + timings->hsync_back_porch + timings->h_res + timings->hsync_front_porch;
+    const uint64_t v_total = timings->vsync_pulse_width + timings->vsync_back_porch + timings->v_res + timings->vsync_front_porch;
+    sim->frame_us = (uint32_t)(h_total * v_total * 1000000 / timings->pclk_hz);
+    sim->stats.frame_us = sim->frame_us;
+
+    sim->base.reset = sim_rgb_panel_reset;
+    sim->base.init = sim_rgb_panel_init;
+    sim->base.del = sim_rgb_panel_del;
+    sim->base.draw_bitmap = sim_rgb_panel_draw_bitmap;
+    sim->base.mirror = sim_rgb_panel_mirror;
+    sim->base.swap_xy = sim_rgb_panel_swap_xy;
+    sim->base.set_gap = sim_rgb_panel_set_gap;
+    sim->base.disp_on_off = sim_rgb_panel_disp_on_off;
+    *ret_panel = &sim->base;
+    ESP_LOGD(TAG, "new rgb panel @%p, %"PRIu32"x%"PRIu32", %zu frame buffers", sim, sim->h_res, sim->v_res, num_fbs);
+    return ESP_OK;
+
+err:
+    sim_rgb_panel_del(&sim->base);
+    return ret;
+}
+
+esp_err_t esp_lcd_rgb_panel_register_event_callbacks(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_callbacks_t *callbacks, void *user_ctx)
+{
+    ESP_RETURN_ON_FALSE(panel && callbacks, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    sim_rgb_panel_t *sim = __containerof(panel, sim_rgb_panel_t, base);
+    sim->cbs = *callbacks;
+    sim->user_ctx = user_ctx;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_rgb_panel_get_frame_buffer(esp_lcd_panel_handle_t panel, uint32_t fb_num, void **fb0, ...)
+{
+    ESP_RETURN_ON_FALSE(panel, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    sim_rgb_panel_t *sim = __containerof(panel, sim_rgb_panel_t, base);
+    ESP_RETURN_ON_FALSE(fb_num && fb_num <= sim->num_fbs, ESP_ERR_INVALID_ARG, TAG, "invalid frame buffer number");
+    *fb0 = sim->fbs[0];
+    va_list args;
+    va_start(args, fb0);
+    for (uint32_t i = 1; i < fb_num; i++) {
+        void **fb_itor = va_arg(args, void **);
+        *fb_itor = sim->fbs[i];
+    }
+    va_end(args);
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_rgb_panel_refresh(esp_lcd_panel_handle_t panel)
+{
+    return esp_lcd_sim_rgb_panel_scan_out(panel);
+}
+
+esp_err_t esp_lcd_rgb_panel_restart(esp_lcd_panel_handle_t panel)
+{
+    ESP_RETURN_ON_FALSE(panel, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    return ESP_OK;
+}
+
+// copy lines into the screen the way the panel shows them
+static void sim_rgb_panel_show(sim_rgb_panel_t *sim, size_t offset, const uint8_t *src, size_t size)
+{
+    const size_t px_size = sim->bits_per_pixel / 8;
+    const size_t stride = sim->h_res * px_size;
+    if (!sim->flags.mirror_x && !sim->flags.mirror_y) {
+        memcpy(sim->screen + offset, src, size);
+        return;
+    }
+    for (size_t pos = offset; pos < offset + size; pos += px_size, src += px_size) {
+        size_t x = (pos % stride) / px_size;
+        size_t y = pos / stride;
+        x = sim->flags.mirror_x ? sim->h_res - 1 - x : x;
+        y = sim->flags.mirror_y ? sim->v_res - 1 - y : y;
+        memcpy(sim->screen + y * stride + x * px_size, src, px_size);
+    }
+}
+
+esp_err_t esp_lcd_sim_rgb_panel_scan_out(esp_lcd_panel_handle_t panel)
+{
+    ESP_RETURN_ON_FALSE(panel, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    sim_rgb_panel_t *sim = __containerof(panel, sim_rgb_panel_t, base);
+    ESP_RETURN_ON_FALSE(sim->flags.initialized, ESP_ERR_INVALID_STATE, TAG, "panel not initialized");
+    esp_lcd_rgb_panel_event_data_t edata = {};
+    const int64_t start_us = esp_timer_get_time();
+
+    if (sim->bounce_buf) {
+        const size_t px_size = sim->bits_per_pixel / 8;
+        for (size_t offset = 0; offset < sim->fb_size; offset += sim->bounce_size) {
+            if (sim->cbs.on_bounce_empty) {
+                sim->cbs.on_bounce_empty(panel, sim->bounce_buf, offset / px_size, sim->bounce_size, sim->user_ctx);
+            } else if (sim->cur_fb) {
+                memcpy(sim->bounce_buf, sim->cur_fb + offset, sim->bounce_size);
+            }
+            sim->stats.bounce_fills++;
+            sim_rgb_panel_show(sim, offset, sim->bounce_buf, sim->bounce_size);
+        }
+        if (sim->cbs.on_bounce_frame_finish) {
+            sim->cbs.on_bounce_frame_finish(panel, &edata, sim->user_ctx);
+        }
+    } else {
+        sim_rgb_panel_show(sim, 0, sim->cur_fb, sim->fb_size);
+    }
+    if (!sim->flags.disp_on) {
+        memset(sim->screen, 0, sim->fb_size);
+    }
+    sim->stats.frames++;
+    if (sim->cbs.on_vsync) {
+        sim->cbs.on_vsync(panel, &edata, sim->user_ctx);
+    }
+    sim->stats.scan_out_us += esp_timer_get_time() - start_us;
+    return ESP_OK;
+}
+
+const void *esp_lcd_sim_rgb_panel_get_screen(esp_lcd_panel_handle_t panel, uint32_t *h_res, uint32_t *v_res, uint32_t *bits_per_pixel)
+{
+    sim_rgb_panel_t *sim = __containerof(panel, sim_rgb_panel_t, base);
+    if (h_res) {
+        *h_res = sim->h_res;
+    }
+    if (v_res) {
+        *v_res = sim->v_res;
+    }
+    if (bits_per_pixel) {
+        *bits_per_pixel = sim->bits_per_pixel;
+    }
+    return sim->screen;
+}
+
+void esp_lcd_sim_rgb_panel_get_stats(esp_lcd_panel_handle_t panel, esp_lcd_sim_rgb_panel_stats_t *stats)
+{
+    sim_rgb_panel_t *sim = __containerof(panel, sim_rgb_panel_t, base);
+    *stats = sim->stats;
+}
@@ -0,0 +1,20 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief IO expander handle, no expander is simulated, the lines are GPIOs
+ */
+typedef struct esp_io_expander_s *esp_io_expander_handle_t;
+
+#ifdef __cplusplus
+}
+#endif
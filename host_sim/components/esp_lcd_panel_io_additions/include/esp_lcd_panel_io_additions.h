@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_lcd_panel_io.h"
+#include "esp_io_expander.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PANEL_IO_3WIRE_SPI_CLK_MAX  (500 * 1000UL)
+
+/**
+ * @brief Where a line of the 3-wire SPI is connected
+ */
+typedef enum {
+    IO_TYPE_GPIO = 0,
+    IO_TYPE_EXPANDER,
+} io_type_t;
+
+/**
+ * @brief Lines of the 3-wire SPI, as in the managed component
+ */
+typedef struct {
+    io_type_t cs_io_type;
+    union {
+        int cs_gpio_num;
+        int cs_expander_pin;
+    };
+    io_type_t scl_io_type;
+    union {
+        int scl_gpio_num;
+        int scl_expander_pin;
+    };
+    io_type_t sda_io_type;
+    union {
+        int sda_gpio_num;
+        int sda_expander_pin;
+    };
+    esp_io_expander_handle_t io_expander;
+} spi_line_config_t;
+
+/**
+ * @brief 3-wire SPI panel IO configuration, as in the managed component
+ */
+typedef struct {
+    spi_line_config_t line_config;  /*!< Only recorded, the simulated IO has no lines */
+    uint32_t expect_clk_speed;      /*!< SCL frequency the bus time is estimated with */
+    uint32_t spi_mode;
+    uint32_t lcd_cmd_bytes;
+    uint32_t lcd_param_bytes;
+    struct {
+        uint32_t use_dc_bit: 1;
+        uint32_t dc_zero_on_data: 1;
+        uint32_t lsb_first: 1;
+        uint32_t cs_high_active: 1;
+        uint32_t del_keep_cs_inactive: 1;
+    } flags;
+} esp_lcd_panel_io_3wire_spi_config_t;
+
+/**
+ * @brief Create a 3-wire SPI panel IO, a recording one on the linux target
+ *
+ * @param[in]  io_config  Panel IO configuration
+ * @param[out] ret_io     Returned panel IO handle
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_NO_MEM: No memory for the command log
+ */
+esp_err_t esp_lcd_new_panel_io_3wire_spi(const esp_lcd_panel_io_3wire_spi_config_t *io_config, esp_lcd_panel_io_handle_t *ret_io);
+
+#ifdef __cplusplus
+}
+#endif
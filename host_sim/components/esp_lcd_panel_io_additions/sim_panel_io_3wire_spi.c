@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include "esp_check.h"
+#include "esp_lcd_sim.h"
+#include "esp_lcd_panel_io_additions.h"
+
+#define SIM_3WIRE_MAX_RECORDS       256
+#define SIM_3WIRE_MAX_PARAM_BYTES   2048
+
+static const char *TAG = "lcd_panel.io.3wire_spi";
+
+esp_err_t esp_lcd_new_panel_io_3wire_spi(const esp_lcd_panel_io_3wire_spi_config_t *io_config, esp_lcd_panel_io_handle_t *ret_io)
+{
+    ESP_RETURN_ON_FALSE(io_config && ret_io, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    const spi_line_config_t *line = &io_config->line_config;
+    const bool on_expander = line->cs_io_type == IO_TYPE_EXPANDER || line->scl_io_type == IO_TYPE_EXPANDER ||
+                             line->sda_io_type == IO_TYPE_EXPANDER;
+    ESP_RETURN_ON_FALSE(!on_expander || line->io_expander, ESP_ERR_INVALID_ARG, TAG, "no IO expander for the expander lines");
+    ESP_RETURN_ON_FALSE(io_config->expect_clk_speed && io_config->expect_clk_speed <= PANEL_IO_3WIRE_SPI_CLK_MAX,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid clock speed");
+    const esp_lcd_sim_panel_io_config_t sim_config = {
+        .max_records = SIM_3WIRE_MAX_RECORDS,
+        .max_param_bytes = SIM_3WIRE_MAX_PARAM_BYTES,
+        .scl_hz = io_config->expect_clk_speed,
+    };
+    return esp_lcd_sim_new_panel_io_3wire(&sim_config, ret_io);
+}
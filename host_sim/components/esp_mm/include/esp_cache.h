@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_CACHE_MSYNC_FLAG_INVALIDATE    (1 << 0)    /*!< Invalidate the cache lines */
+#define ESP_CACHE_MSYNC_FLAG_UNALIGNED     (1 << 1)    /*!< Allow an address and size not aligned to the cache line */
+#define ESP_CACHE_MSYNC_FLAG_DIR_C2M       (1 << 2)    /*!< Cache to memory, the default */
+#define ESP_CACHE_MSYNC_FLAG_DIR_M2C       (1 << 3)    /*!< Memory to cache */
+#define ESP_CACHE_MSYNC_FLAG_TYPE_DATA     (1 << 4)    /*!< Data cache, the default */
+#define ESP_CACHE_MSYNC_FLAG_TYPE_INST     (1 << 5)    /*!< Instruction cache */
+
+/**
+ * @brief Synchronize the cache with memory, nothing to do on the host
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ */
+esp_err_t esp_cache_msync(void *addr, size_t size, int flags);
+
+/**
+ * @brief Get the cache line size for memory with the given heap caps, the one of the PSRAM cache of the ESP32-S3
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ */
+esp_err_t esp_cache_get_alignment(uint32_t heap_caps, size_t *out_alignment);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,28 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_check.h"
+#include "esp_cache.h"
+
+#define SIM_CACHE_LINE_SIZE 32
+
+static const char *TAG = "cache";
+
+esp_err_t esp_cache_msync(void *addr, size_t size, int flags)
+{
+    ESP_RETURN_ON_FALSE(addr, ESP_ERR_INVALID_ARG, TAG, "null address");
+    ESP_RETURN_ON_FALSE((flags & ESP_CACHE_MSYNC_FLAG_UNALIGNED) ||
+                        ((uintptr_t)addr % SIM_CACHE_LINE_SIZE == 0 && size % SIM_CACHE_LINE_SIZE == 0),
+                        ESP_ERR_INVALID_ARG, TAG, "start address or size not aligned to the cache line");
+    return ESP_OK;
+}
+
+esp_err_t esp_cache_get_alignment(uint32_t heap_caps, size_t *out_alignment)
+{
+    ESP_RETURN_ON_FALSE(out_alignment, ESP_ERR_INVALID_ARG, TAG, "null pointer");
+    *out_alignment = SIM_CACHE_LINE_SIZE;
+    return ESP_OK;
+}
@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include "bench_report.h"
+
+void example_bench_print_json(const example_bench_result_t *r)
+{
+    uint32_t frames = r->frames ? r->frames : 1;
+    // one line, so it can be picked out of the log and parsed as it is
+    printf("BENCH {\"mode\": \"%s\", \"panel\": \"%s\", \"h_res\": %"PRIu32", \"v_res\": %"PRIu32", \"pixel_size\": %"PRIu32
+           ", \"frames\": %"PRIu32", \"rendered_frames\": %"PRIu32
+           ", \"render_us_avg\": %"PRIu64", \"render_us_max\": %"PRIu32
+           ", \"flush_calls\": %"PRIu32", \"flush_bytes\": %"PRIu64", \"flush_us\": %"PRIu64", \"scan_out_us\": %"PRIu64
+           ", \"invalidated_px\": %"PRIu64", \"rendered_px\": %"PRIu64
+           ", \"fb_switches\": %"PRIu32", \"bounce_fills\": %"PRIu32
+           ", \"buffer_bytes\": %"PRIu32", \"lvgl_heap_max_bytes\": %"PRIu32", \"peak_heap_bytes\": %"PRIu32
+           ", \"screen_crc32\": \"%08"PRIx32"\"}\n",
+           r->mode, r->panel, r->h_res, r->v_res, r->pixel_size,
+           r->frames, r->rendered_frames,
+           r->render_us / frames, r->render_max_us,
+           r->flush_calls, r->flush_bytes, r->flush_us, r->scan_out_us,
+           r->invalidated_px, r->rendered_px,
+           r->fb_switches, r->bounce_fills,
+           r->buffer_bytes, r->lvgl_heap_max_bytes, r->buffer_bytes + r->lvgl_heap_max_bytes,
+           r->screen_crc32);
+    fflush(stdout);
+}
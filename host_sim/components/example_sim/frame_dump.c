@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_check.h"
+#include "esp_rom_crc.h"
+#include "frame_dump.h"
+
+#define PNG_STORED_BLOCK_MAX    65535   // longest deflate block without compression
+#define PNG_ADLER_MOD           65521
+
+static const char *TAG = "frame_dump";
+
+static void png_put_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static void png_write_chunk(FILE *f, const char *type, const uint8_t *data, uint32_t size)
+{
+    uint8_t head[8];
+    png_put_be32(head, size);
+    memcpy(head + 4, type, 4);
+    // the CRC covers the type and the data
+    uint32_t crc = esp_rom_crc32_le(0, head + 4, 4);
+    if (size) {
+        crc = esp_rom_crc32_le(crc, data, size);
+    }
+    uint8_t tail[4];
+    png_put_be32(tail, crc);
+    fwrite(head, 1, sizeof(head), f);
+    if (size) {
+        fwrite(data, 1, size, f);
+    }
+    fwrite(tail, 1, sizeof(tail), f);
+}
+
+// one line of the frame, as 8-bit R, G, B
+static void png_convert_line(uint8_t *rgb, const uint8_t *src, uint32_t h_res, uint32_t bits_per_pixel)
+{
+    for (uint32_t x = 0; x < h_res; x++, rgb += 3) {
+        if (bits_per_pixel == 16) {
+            uint16_t px = src[2 * x] | (src[2 * x + 1] << 8);
+            uint8_t r = px >> 11, g = (px >> 5) & 0x3f, b = px & 0x1f;
+            rgb[0] = (r << 3) | (r >> 2);
+            rgb[1] = (g << 2) | (g >> 4);
+            rgb[2] = (b << 3) | (b >> 2);
+        } else {
+            rgb[0] = src[3 * x + 2];
+            rgb[1] = src[3 * x + 1];
+            rgb[2] = src[3 * x];
+        }
+    }
+}
+
+esp_err_t example_frame_dump_png(const char *path, const void *pixels, uint32_t h_res, uint32_t v_res, uint32_t bits_per_pixel)
+{
+    ESP_RETURN_ON_FALSE(bits_per_pixel == 16 || bits_per_pixel == 24, ESP_ERR_NOT_SUPPORTED, TAG, "unsupported pixel format");
+    // filtered image data: each line starts with filter type 0 (none)
+    const size_t line_size = 1 + h_res * 3;
+    const size_t raw_size = line_size * v_res;
+    const size_t blocks = (raw_size + PNG_STORED_BLOCK_MAX - 1) / PNG_STORED_BLOCK_MAX;
+    // zlib header, stored blocks with a 5 byte header each, Adler-32
+    const size_t zlib_size = 2 + raw_size + blocks * 5 + 4;
+    uint8_t *raw = malloc(raw_size);
+    uint8_t *zlib = malloc(zlib_size);
+    FILE *f = fopen(path, "wb");
+    esp_err_t ret = ESP_OK;
+    ESP_GOTO_ON_FALSE(raw && zlib, ESP_ERR_NO_MEM, err, TAG, "no mem for PNG image data");
+    ESP_GOTO_ON_FALSE(f, ESP_FAIL, err, TAG, "open %s failed", path);
+
+    const uint8_t *src = pixels;
+    for (uint32_t y = 0; y < v_res; y++) {
+        raw[y * line_size] = 0;
+        png_convert_line(raw + y * line_size + 1, src + y * h_res * (bits_per_pixel / 8), h_res, bits_per_pixel);
+    }
+
+    uint8_t *p = zlib;
+    *p++ = 0x78; // deflate, 32K window
+    *p++ = 0x01; // no preset dictionary, check bits
+    uint32_t s1 = 1, s2 = 0;
+    for (size_t offset = 0; offset < raw_size; offset += PNG_STORED_BLOCK_MAX) {
+        uint16_t len = raw_size - offset > PNG_STORED_BLOCK_MAX ? PNG_STORED_BLOCK_MAX : raw_size - offset;
+        *p++ = offset + len == raw_size; // BFINAL on the last block, BTYPE 00
+        *p++ = len;
+        *p++ = len >> 8;
+        *p++ = ~len;
+        *p++ = (uint16_t)~len >> 8;
+        memcpy(p, raw + offset, len);
+        p += len;
+        for (size_t i = 0; i < len; i++) {
+            s1 = (s1 + raw[offset + i]) % PNG_ADLER_MOD;
+            s2 = (s2 + s1) % PNG_ADLER_MOD;
+        }
+    }
+    png_put_be32(p, (s2 << 16) | s1);
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    uint8_t ihdr[13];
+    png_put_be32(ihdr, h_res);
+    png_put_be32(ihdr + 4, v_res);
+    ihdr[8] = 8;    // bit depth
+    ihdr[9] = 2;    // truecolor
+    ihdr[10] = 0;   // deflate
+    ihdr[11] = 0;   // adaptive filtering
+    ihdr[12] = 0;   // no interlace
+    fwrite(signature, 1, sizeof(signature), f);
+    png_write_chunk(f, "IHDR", ihdr, sizeof(ihdr));
+    png_write_chunk(f, "IDAT", zlib, zlib_size);
+    png_write_chunk(f, "IEND", NULL, 0);
+    ESP_GOTO_ON_FALSE(!ferror(f), ESP_FAIL, err, TAG, "write %s failed", path);
+
+err:
+    if (f) {
+        fclose(f);
+    }
+    free(zlib);
+    free(raw);
+    return ret;
+}
+
+esp_err_t example_frame_dump_raw(const char *path, const void *pixels, uint32_t h_res, uint32_t v_res, uint32_t bits_per_pixel)
+{
+    FILE *f = fopen(path, "wb");
+    ESP_RETURN_ON_FALSE(f, ESP_FAIL, TAG, "open %s failed", path);
+    size_t size = (size_t)h_res * v_res * (bits_per_pixel / 8);
+    size_t written = fwrite(pixels, 1, size, f);
+    fclose(f);
+    ESP_RETURN_ON_FALSE(written == size, ESP_FAIL, TAG, "write %s failed", path);
+    return ESP_OK;
+}
@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <string.h>
+#include "esp_check.h"
+#include "gpio_sim.h"
+#include "i2c_sim.h"
+#include "vernon_gt911.h"
+#include "gt911_sim.h"
+
+#define GT911_SIM_REG_BASE      0x8000
+#define GT911_SIM_REG_SIZE      0x200
+#define GT911_SIM_BUFFER_STATUS 0x80    // frame ready bit of GT911_POINT_INFO
+
+static const char *TAG = "gt911_sim";
+
+static struct {
+    uint8_t regs[GT911_SIM_REG_SIZE];
+    uint16_t pointer;   // register address the next read starts at
+    gpio_num_t int_pin;
+} s_gt911;
+
+static esp_err_t gt911_sim_transfer(void *ctx, const uint8_t *write_buf, size_t write_size, uint8_t *read_buf, size_t read_size)
+{
+    // a write sets the register pointer, the bytes after it are written from there on
+    if (write_size >= 2) {
+        s_gt911.pointer = (write_buf[0] << 8) | write_buf[1];
+    }
+    for (size_t i = 2; i < write_size; i++, s_gt911.pointer++) {
+        if (s_gt911.pointer >= GT911_SIM_REG_BASE && s_gt911.pointer < GT911_SIM_REG_BASE + GT911_SIM_REG_SIZE) {
+            s_gt911.regs[s_gt911.pointer - GT911_SIM_REG_BASE] = write_buf[i];
+        }
+    }
+    for (size_t i = 0; i < read_size; i++, s_gt911.pointer++) {
+        bool mapped = s_gt911.pointer >= GT911_SIM_REG_BASE && s_gt911.pointer < GT911_SIM_REG_BASE + GT911_SIM_REG_SIZE;
+        read_buf[i] = mapped ? s_gt911.regs[s_gt911.pointer - GT911_SIM_REG_BASE] : 0;
+    }
+    return ESP_OK;
+}
+
+esp_err_t example_gt911_sim_init(i2c_port_t port, uint16_t address, gpio_num_t int_pin, uint16_t width, uint16_t height)
+{
+    memset(&s_gt911, 0, sizeof(s_gt911));
+    s_gt911.int_pin = int_pin;
+    memcpy(&s_gt911.regs[GT911_PRODUCT_ID - GT911_SIM_REG_BASE], "911", 4);
+    // X/Y output maximum in the configuration area
+    s_gt911.regs[GT911_X_OUTPUT_MAX_LOW - GT911_SIM_REG_BASE] = width & 0xff;
+    s_gt911.regs[GT911_X_OUTPUT_MAX_HIGH - GT911_SIM_REG_BASE] = width >> 8;
+    s_gt911.regs[GT911_Y_OUTPUT_MAX_LOW - GT911_SIM_REG_BASE] = height & 0xff;
+    s_gt911.regs[GT911_Y_OUTPUT_MAX_HIGH - GT911_SIM_REG_BASE] = height >> 8;
+    const i2c_sim_responder_t responder = {
+        .transfer = gt911_sim_transfer,
+    };
+    ESP_RETURN_ON_ERROR(i2c_sim_attach(port, address, &responder), TAG, "attach to I2C failed");
+    return ESP_OK;
+}
+
+void example_gt911_sim_touch(const example_gt911_sim_point_t *points, uint8_t num)
+{
+    if (num > TOUCH_POINT_TOTAL) {
+        num = TOUCH_POINT_TOTAL;
+    }
+    uint8_t *frame = &s_gt911.regs[GT911_POINT_INFO - GT911_SIM_REG_BASE];
+    memset(frame, 0, GT911_FRAME_SIZE);
+    for (int i = 0; i < num; i++) {
+        uint8_t *point = frame + 1 + i * GT911_POINT_SIZE;
+        point[0] = points[i].id;
+        point[1] = points[i].x & 0xff;
+        point[2] = points[i].x >> 8;
+        point[3] = points[i].y & 0xff;
+        point[4] = points[i].y >> 8;
+        point[5] = points[i].size & 0xff;
+        point[6] = points[i].size >> 8;
+    }
+    // the host clears the status byte once it has read the frame
+    frame[0] = GT911_SIM_BUFFER_STATUS | num;
+    if (s_gt911.int_pin != GPIO_NUM_NC) {
+        // MODULE_SWITCH_1[1:0] selects the INT trigger: 0 rising, 1 falling, 2 low level, 3 high level
+        uint8_t trigger = s_gt911.regs[GT911_MODULE_SWITCH_1 - GT911_SIM_REG_BASE] & 0x03;
+        gpio_sim_pulse_input(s_gt911.int_pin, trigger == 0 || trigger == 3);
+    }
+}
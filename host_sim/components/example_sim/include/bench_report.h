@@ -0,0 +1,51 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Results of one simulated run.
+ *
+ * LVGL runs on a virtual clock, one refresh period per frame scanned out, so the counters repeat from run to run as
+ * long as LVGL keeps up with the scan-out. The times are measured on the host's clock and vary with its load.
+ */
+typedef struct {
+    const char *mode;           /*!< Buffer mode */
+    const char *panel;          /*!< Panel driver */
+    uint32_t h_res;             /*!< Panel resolution */
+    uint32_t v_res;
+    uint32_t pixel_size;        /*!< Bytes per pixel */
+    uint32_t frames;            /*!< Frames scanned out */
+    uint32_t rendered_frames;   /*!< Frames LVGL rendered meanwhile */
+    uint64_t render_us;         /*!< Render start to render ready, summed over the rendered frames */
+    uint32_t render_max_us;     /*!< Longest render */
+    uint32_t flush_calls;       /*!< Areas handed to the flush callback */
+    uint64_t flush_bytes;       /*!< Bytes of those areas */
+    uint64_t flush_us;          /*!< Flush callback to flush done, summed over the rendered frames */
+    uint64_t scan_out_us;       /*!< Time in the simulated scan-out, including the bounce buffer refills */
+    uint64_t invalidated_px;    /*!< Pixels invalidated by LVGL, before snapping and merging */
+    uint64_t rendered_px;       /*!< Pixels left to render after snapping and merging */
+    uint32_t fb_switches;       /*!< Frame buffer swaps */
+    uint32_t bounce_fills;      /*!< Bounce buffer refills */
+    uint32_t buffer_bytes;      /*!< Frame, bounce and draw buffers */
+    uint32_t lvgl_heap_max_bytes; /*!< Peak LVGL heap use, 0 when LVGL uses the C library heap */
+    uint32_t screen_crc32;      /*!< CRC32 of the last frame scanned out */
+} example_bench_result_t;
+
+/**
+ * @brief Print the results as one line, `BENCH ` followed by a JSON object.
+ */
+void example_bench_print_json(const example_bench_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
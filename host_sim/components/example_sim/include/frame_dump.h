@@ -0,0 +1,34 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Write a frame as an RGB PNG, without compression so no zlib is needed.
+ *
+ * @param[in] path           File to write
+ * @param[in] pixels         Frame, in the LVGL layout: RGB565 little endian, or RGB888 stored as B, G, R
+ * @param[in] h_res          Width in pixels
+ * @param[in] v_res          Height in pixels
+ * @param[in] bits_per_pixel 16 or 24
+ */
+esp_err_t example_frame_dump_png(const char *path, const void *pixels, uint32_t h_res, uint32_t v_res, uint32_t bits_per_pixel);
+
+/**
+ * @brief Write a frame as it is in memory.
+ */
+esp_err_t example_frame_dump_raw(const char *path, const void *pixels, uint32_t h_res, uint32_t v_res, uint32_t bits_per_pixel);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/gpio.h"
+#include "driver/i2c_master.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint8_t id;     /*!< Track ID, kept while the finger stays down */
+    uint16_t x;     /*!< Coordinates on the touch pad, before any rotation */
+    uint16_t y;
+    uint16_t size;
+} example_gt911_sim_point_t;
+
+/**
+ * @brief Answer as a GT911 at `address` on `port`, with an empty frame and the product ID "911".
+ *
+ * @note  New frames are signalled on `int_pin`, GPIO_NUM_NC when the INT line is not wired.
+ */
+esp_err_t example_gt911_sim_init(i2c_port_t port, uint16_t address, gpio_num_t int_pin, uint16_t width, uint16_t height);
+
+/**
+ * @brief Latch a new touch frame and pulse INT, `num` 0 reports all fingers lifted.
+ */
+void example_gt911_sim_touch(const example_gt911_sim_point_t *points, uint8_t num);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,30 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <assert.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+// The newlib locks of the chip, which the C library of the linux target doesn't have. A FreeRTOS mutex, created
+// on first use like on the chip: the first lock is taken before any other task that uses it runs
+
+typedef SemaphoreHandle_t _lock_t;
+
+static inline void _lock_acquire(_lock_t *lock)
+{
+    if (!*lock) {
+        *lock = xSemaphoreCreateMutex();
+        assert(*lock);
+    }
+    xSemaphoreTake(*lock, portMAX_DELAY);
+}
+
+static inline void _lock_release(_lock_t *lock)
+{
+    xSemaphoreGive(*lock);
+}
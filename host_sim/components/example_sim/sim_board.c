@@ -0,0 +1,358 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_check.h"
+#include "esp_rom_crc.h"
+#include "esp_lcd_sim.h"
+#include "esp_log.h"
+#include "lvgl.h"
+#include "lcd_defines.h"
+#include "display_telemetry.h"
+#include "dirty_region.h"
+#include "panel_select.h"
+#include "bench_report.h"
+#include "frame_dump.h"
+#include "gt911_sim.h"
+
+#if !CONFIG_EXAMPLE_ENABLE_DISPLAY_TELEMETRY
+#error "the host simulation reports the run from the display telemetry, enable EXAMPLE_ENABLE_DISPLAY_TELEMETRY"
+#endif
+
+#if CONFIG_EXAMPLE_BOUNCE_INDEXED_FB
+#define EXAMPLE_SIM_MODE                "bounce_buffer_indexed"
+#elif CONFIG_EXAMPLE_USE_BOUNCE_BUFFER
+#define EXAMPLE_SIM_MODE                "bounce_buffer"
+#elif EXAMPLE_LCD_NUM_FB == 3
+#define EXAMPLE_SIM_MODE                "triple_fb"
+#elif EXAMPLE_LCD_NUM_FB == 2
+#define EXAMPLE_SIM_MODE                "double_fb"
+#else
+#define EXAMPLE_SIM_MODE                "single_fb"
+#endif
+
+#define EXAMPLE_SIM_TOUCH_FIRST_FRAME   30  // the scripted drag starts here
+#define EXAMPLE_SIM_TOUCH_FRAMES        60  // and lasts this many frames
+
+// the example's modules, wrapped at link time so the board sees the calls from its main file
+esp_err_t __real_example_panel_select(const lcd_panel_desc_t **ret_panel, uint8_t *ret_id);
+void __real_example_telemetry_flush_start(const lv_area_t *area);
+void __real_example_telemetry_lock_released(void);
+void __real_example_dirty_init(const example_dirty_config_t *config);
+void __real_example_dirty_snap(example_dirty_rect_t *rect);
+void __real_example_dirty_merge(example_dirty_rect_t *rects, uint8_t *joined, uint32_t count);
+void __real_lv_tick_set_cb(lv_tick_get_cb_t cb);
+uint32_t __real_lv_timer_handler(void);
+
+static example_bench_result_t example_bench = {
+    .mode = EXAMPLE_SIM_MODE,
+    .pixel_size = EXAMPLE_PIXEL_SIZE,
+};
+// the last frame scanned out, copied by the scan-out task so the panel can keep running meanwhile
+static esp_lcd_panel_handle_t example_sim_panel;
+static uint8_t *example_sim_screen;
+static uint32_t example_sim_screen_bpp;
+static volatile bool example_sim_done;
+// LVGL's clock: one refresh period per frame scanned out, so the demo animates the same in every run
+static uint64_t example_sim_tick_us;
+static uint32_t example_sim_frame_us;
+static _Atomic uint32_t example_sim_frames_pending;
+static uint32_t example_sim_frames;
+static TaskHandle_t volatile example_sim_lvgl_task;
+
+#if CONFIG_EXAMPLE_SIM_DIRTY_TRACE
+static example_dirty_config_t example_dirty_trace_config;
+static FILE *example_dirty_trace;
+static FILE *example_dirty_trace_merges;    // the second table, appended once the run is over
+static uint32_t example_dirty_trace_refresh;
+// what the example's merging made of the refreshes recorded, the invalidated areas of each one included once merged
+static struct {
+    uint32_t pending_px;
+    uint32_t invalidated_px;
+    uint32_t rects_in;
+    uint32_t rects_out;
+    uint32_t rendered_px;
+} example_dirty_trace_totals;
+
+static void example_dirty_trace_open(void)
+{
+    example_dirty_trace = fopen(CONFIG_EXAMPLE_SIM_DIRTY_TRACE_PATH, "w");
+    assert(example_dirty_trace);
+    example_dirty_trace_merges = tmpfile();
+    assert(example_dirty_trace_merges);
+    // the format of test_apps/main/demo_dirty_trace.h
+    fprintf(example_dirty_trace, "// Areas LVGL invalidates running the demo on the %s, %d frames, and what the example's dirty area\n"
+            "// coalescing made of them. Recorded by host_sim with EXAMPLE_SIM_DIRTY_TRACE.\n\n"
+            "#pragma once\n\n#include <stdint.h>\n#include \"dirty_region.h\"\n\n"
+            "#define DEMO_DIRTY_TRACE_H_RES          %"PRId32"\n#define DEMO_DIRTY_TRACE_V_RES          %"PRId32"\n"
+            "#define DEMO_DIRTY_TRACE_TILE_W         %"PRIu32"\n#define DEMO_DIRTY_TRACE_TILE_H         %"PRIu32"\n"
+            "#define DEMO_DIRTY_TRACE_RECT_COST_PX   %"PRIu32"\n\n"
+            "typedef struct {\n    uint32_t refresh;\n    example_dirty_rect_t area;\n} demo_dirty_trace_area_t;\n\n"
+            "typedef struct {\n    uint32_t refresh;\n    uint8_t joined;\n    example_dirty_rect_t area;\n} demo_dirty_trace_merge_t;\n\n"
+            "// every area invalidated, before snapping, with the refresh rendering it\n"
+            "static const demo_dirty_trace_area_t s_demo_dirty_trace[] = {\n",
+            example_bench.panel, CONFIG_EXAMPLE_SIM_FRAMES, example_dirty_trace_config.h_res, example_dirty_trace_config.v_res,
+            example_dirty_trace_config.tile_w, example_dirty_trace_config.tile_h, example_dirty_trace_config.rect_cost_px);
+}
+
+static void example_dirty_trace_close(void)
+{
+    fprintf(example_dirty_trace, "};\n\n// the areas of each refresh as they were handed to the merging, snapped and joined by LVGL\n"
+            "static const demo_dirty_trace_merge_t s_demo_dirty_merges[] = {\n");
+    rewind(example_dirty_trace_merges);
+    char line[96];
+    while (fgets(line, sizeof(line), example_dirty_trace_merges)) {
+        fputs(line, example_dirty_trace);
+    }
+    fclose(example_dirty_trace_merges);
+    fprintf(example_dirty_trace, "};\n\n#define DEMO_DIRTY_TRACE_REFRESHES       %"PRIu32"\n"
+            "#define DEMO_DIRTY_TRACE_INVALIDATED_PX  %"PRIu32"\n#define DEMO_DIRTY_TRACE_RECTS_IN        %"PRIu32"\n"
+            "#define DEMO_DIRTY_TRACE_RECTS_OUT       %"PRIu32"\n#define DEMO_DIRTY_TRACE_RENDERED_PX     %"PRIu32"\n",
+            example_dirty_trace_refresh, example_dirty_trace_totals.invalidated_px, example_dirty_trace_totals.rects_in,
+            example_dirty_trace_totals.rects_out, example_dirty_trace_totals.rendered_px);
+    fclose(example_dirty_trace);
+    ESP_LOGI(TAG, "%"PRIu32" refreshes of invalidated areas written to %s", example_dirty_trace_refresh,
+             CONFIG_EXAMPLE_SIM_DIRTY_TRACE_PATH);
+}
+#endif
+
+esp_err_t __wrap_example_panel_select(const lcd_panel_desc_t **ret_panel, uint8_t *ret_id)
+{
+    ESP_RETURN_ON_ERROR(__real_example_panel_select(ret_panel, ret_id), TAG, "select panel failed");
+    example_bench.panel = (*ret_panel)->name;
+    example_bench.h_res = (*ret_panel)->timings.h_res;
+    example_bench.v_res = (*ret_panel)->timings.v_res;
+#if CONFIG_EXAMPLE_LCD_USE_TOUCH_ENABLED
+    // the touch pad covers the selected panel, and answers before the example probes it
+#if CONFIG_EXAMPLE_LCD_TOUCH_USE_INTERRUPT
+    const gpio_num_t int_pin = TOUCH_PIN_INT;
+#else
+    const gpio_num_t int_pin = GPIO_NUM_NC;
+#endif
+    ESP_RETURN_ON_ERROR(example_gt911_sim_init(I2C_NUM_0, GT911_ADDR1, int_pin, example_bench.h_res, example_bench.v_res),
+                        TAG, "attach GT911 failed");
+#endif
+    return ESP_OK;
+}
+
+void __wrap_example_telemetry_flush_start(const lv_area_t *area)
+{
+    example_bench.flush_calls++;
+    example_bench.flush_bytes += lv_area_get_size(area) * EXAMPLE_PIXEL_SIZE;
+    __real_example_telemetry_flush_start(area);
+}
+
+#if CONFIG_EXAMPLE_DIRTY_COALESCE
+void __wrap_example_dirty_init(const example_dirty_config_t *config)
+{
+#if CONFIG_EXAMPLE_SIM_DIRTY_TRACE
+    example_dirty_trace_config = *config;
+#endif
+    __real_example_dirty_init(config);
+}
+
+void __wrap_example_dirty_snap(example_dirty_rect_t *rect)
+{
+#if CONFIG_EXAMPLE_SIM_DIRTY_TRACE
+    if (!example_dirty_trace) {
+        example_dirty_trace_open();
+    }
+    fprintf(example_dirty_trace, "    {%"PRIu32", {%"PRId32", %"PRId32", %"PRId32", %"PRId32"}},\n", example_dirty_trace_refresh,
+            rect->x1, rect->y1, rect->x2, rect->y2);
+    example_dirty_trace_totals.pending_px += (uint32_t)(rect->x2 - rect->x1 + 1) * (uint32_t)(rect->y2 - rect->y1 + 1);
+#endif
+    __real_example_dirty_snap(rect);
+}
+
+void __wrap_example_dirty_merge(example_dirty_rect_t *rects, uint8_t *joined, uint32_t count)
+{
+#if CONFIG_EXAMPLE_SIM_DIRTY_TRACE
+    // a refresh without areas renders nothing, it's not recorded
+    const bool traced = example_dirty_trace && count;
+    if (traced) {
+        for (uint32_t i = 0; i < count; i++) {
+            fprintf(example_dirty_trace_merges, "    {%"PRIu32", %d, {%"PRId32", %"PRId32", %"PRId32", %"PRId32"}},\n",
+                    example_dirty_trace_refresh, joined[i], rects[i].x1, rects[i].y1, rects[i].x2, rects[i].y2);
+            example_dirty_trace_totals.rects_in += !joined[i];
+        }
+    }
+#endif
+    __real_example_dirty_merge(rects, joined, count);
+#if CONFIG_EXAMPLE_SIM_DIRTY_TRACE
+    if (traced) {
+        for (uint32_t i = 0; i < count; i++) {
+            if (!joined[i]) {
+                example_dirty_trace_totals.rects_out++;
+                example_dirty_trace_totals.rendered_px += (uint32_t)(rects[i].x2 - rects[i].x1 + 1) *
+                                                          (uint32_t)(rects[i].y2 - rects[i].y1 + 1);
+            }
+        }
+        example_dirty_trace_totals.invalidated_px += example_dirty_trace_totals.pending_px;
+        example_dirty_trace_totals.pending_px = 0;
+        // the areas invalidated from now on are rendered by the next refresh
+        example_dirty_trace_refresh++;
+    }
+#endif
+}
+#endif
+
+static uint32_t example_sim_tick_get(void)
+{
+    return (uint32_t)(example_sim_tick_us / 1000);
+}
+
+void __wrap_lv_tick_set_cb(lv_tick_get_cb_t cb)
+{
+    // the example reads esp_timer, which runs with the host's load
+    (void)cb;
+    __real_lv_tick_set_cb(example_sim_tick_get);
+}
+
+uint32_t __wrap_lv_timer_handler(void)
+{
+    example_sim_lvgl_task = xTaskGetCurrentTaskHandle();
+    // the clock only moves between two runs of the timers, by the frames scanned out meanwhile, so every
+    // run of the timers sees one time throughout
+    example_sim_tick_us += (uint64_t)atomic_exchange(&example_sim_frames_pending, 0) * example_sim_frame_us;
+    uint32_t time_till_next_ms = __real_lv_timer_handler();
+    // a timer due later is due on a later frame, which wakes the LVGL task up
+    return time_till_next_ms ? LV_NO_TIMER_READY : 0;
+}
+
+#if CONFIG_EXAMPLE_SIM_TOUCH_SCRIPT
+static void example_sim_touch_script(uint32_t frame)
+{
+    if (frame < EXAMPLE_SIM_TOUCH_FIRST_FRAME || frame > EXAMPLE_SIM_TOUCH_FIRST_FRAME + EXAMPLE_SIM_TOUCH_FRAMES) {
+        return;
+    }
+    uint32_t step = frame - EXAMPLE_SIM_TOUCH_FIRST_FRAME;
+    if (step == EXAMPLE_SIM_TOUCH_FRAMES) {
+        example_gt911_sim_touch(NULL, 0);
+        return;
+    }
+    // one finger across the middle of the pad, left to right
+    example_gt911_sim_point_t point = {
+        .id = 1,
+        .x = example_bench.h_res / 8 + step * (example_bench.h_res * 3 / 4) / EXAMPLE_SIM_TOUCH_FRAMES,
+        .y = example_bench.v_res / 2,
+        .size = 24,
+    };
+    example_gt911_sim_touch(&point, 1);
+}
+#endif
+
+void esp_lcd_sim_rgb_panel_on_frame(esp_lcd_panel_handle_t panel, uint32_t frame)
+{
+    // the frames before LVGL runs depend on how long the panel init takes, they are not counted
+    TaskHandle_t lvgl_task = example_sim_lvgl_task;
+    if (example_sim_done || !lvgl_task) {
+        return;
+    }
+    if (!example_sim_frame_us) {
+        esp_lcd_sim_rgb_panel_stats_t panel_stats;
+        esp_lcd_sim_rgb_panel_get_stats(panel, &panel_stats);
+        example_sim_frame_us = panel_stats.frame_us;
+    }
+    example_sim_frames++;
+#if CONFIG_EXAMPLE_SIM_TOUCH_SCRIPT
+    example_sim_touch_script(example_sim_frames);
+#endif
+    atomic_fetch_add(&example_sim_frames_pending, 1);
+    xTaskNotify(lvgl_task, 0, eNoAction);
+    if (example_sim_frames < CONFIG_EXAMPLE_SIM_FRAMES) {
+        return;
+    }
+    uint32_t h_res, v_res;
+    const void *screen = esp_lcd_sim_rgb_panel_get_screen(panel, &h_res, &v_res, &example_sim_screen_bpp);
+    const size_t screen_size = h_res * v_res * example_sim_screen_bpp / 8;
+    example_sim_screen = malloc(screen_size);
+    assert(example_sim_screen);
+    memcpy(example_sim_screen, screen, screen_size);
+    example_sim_panel = panel;
+    // LVGL is busy elsewhere, the report is written by the next task to release the LVGL lock
+    example_sim_done = true;
+}
+
+// runs with the LVGL lock held, nothing else renders meanwhile
+static void example_sim_finish(void)
+{
+    example_telemetry_report_t report;
+    example_telemetry_get_report(&report, false);
+    example_bench.rendered_frames = report.frames;
+    example_bench.render_us = (uint64_t)report.render_avg_us * report.frames;
+    example_bench.render_max_us = report.render_max_us;
+    example_bench.flush_us = (uint64_t)report.flush_avg_us * report.frames;
+#if CONFIG_EXAMPLE_DIRTY_COALESCE
+    example_dirty_stats_t dirty_stats;
+    example_dirty_get_stats(&dirty_stats, false);
+    example_bench.invalidated_px = dirty_stats.invalidated_px;
+    example_bench.rendered_px = dirty_stats.rendered_px;
+#endif
+#if CONFIG_EXAMPLE_SIM_DIRTY_TRACE
+    if (example_dirty_trace) {
+        example_dirty_trace_close();
+    }
+#endif
+
+    esp_lcd_sim_rgb_panel_stats_t panel_stats;
+    esp_lcd_sim_rgb_panel_get_stats(example_sim_panel, &panel_stats);
+    example_bench.frames = CONFIG_EXAMPLE_SIM_FRAMES;
+    example_bench.scan_out_us = panel_stats.scan_out_us;
+    example_bench.fb_switches = panel_stats.fb_switches;
+    example_bench.bounce_fills = panel_stats.bounce_fills;
+    example_bench.buffer_bytes = panel_stats.buffer_bytes;
+#if CONFIG_EXAMPLE_USE_BOUNCE_BUFFER
+    // the frame buffer the bounce buffers are refilled from is the example's
+    example_bench.buffer_bytes += example_bench.h_res * example_bench.v_res * EXAMPLE_FB_PIXEL_SIZE;
+#endif
+#if EXAMPLE_LCD_NUM_FB == 1
+    const bool ui_transposed = EXAMPLE_DISPLAY_ROTATION == 1 || EXAMPLE_DISPLAY_ROTATION == 3;
+    example_bench.buffer_bytes += 2 * (ui_transposed ? example_bench.v_res : example_bench.h_res) *
+                                  EXAMPLE_LVGL_DRAW_BUF_LINES * EXAMPLE_PIXEL_SIZE;
+#endif
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_mem_monitor_t mem_monitor;
+    lv_mem_monitor(&mem_monitor);
+    example_bench.lvgl_heap_max_bytes = mem_monitor.max_used;
+#endif
+    ESP_LOGI(TAG, "Frames %"PRIu32", %"PRIu32" rendered, render %"PRIu32" us avg %"PRIu32" us max, %"PRIu32" flushes",
+             example_bench.frames, example_bench.rendered_frames, report.render_avg_us, report.render_max_us,
+             example_bench.flush_calls);
+
+    const uint32_t h_res = example_bench.h_res;
+    const uint32_t v_res = example_bench.v_res;
+    example_bench.screen_crc32 = esp_rom_crc32_le(0, example_sim_screen, h_res * v_res * example_sim_screen_bpp / 8);
+    ESP_LOGI(TAG, "Screen CRC32: %08"PRIx32, example_bench.screen_crc32);
+    example_bench_print_json(&example_bench);
+#if CONFIG_EXAMPLE_SIM_DUMP_PNG
+    ESP_ERROR_CHECK(example_frame_dump_png(CONFIG_EXAMPLE_SIM_DUMP_PATH, example_sim_screen, h_res, v_res, example_sim_screen_bpp));
+#elif CONFIG_EXAMPLE_SIM_DUMP_RAW
+    ESP_ERROR_CHECK(example_frame_dump_raw(CONFIG_EXAMPLE_SIM_DUMP_PATH, example_sim_screen, h_res, v_res, example_sim_screen_bpp));
+#endif
+#if !CONFIG_EXAMPLE_SIM_DUMP_NONE
+    ESP_LOGI(TAG, "Last frame written to %s", CONFIG_EXAMPLE_SIM_DUMP_PATH);
+#endif
+    ESP_LOGI(TAG, "Simulation done");
+    fflush(stdout);
+    exit(0);
+}
+
+void __wrap_example_telemetry_lock_released(void)
+{
+    __real_example_telemetry_lock_released();
+    if (example_sim_done) {
+        example_sim_finish();
+    }
+}
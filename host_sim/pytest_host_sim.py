@@ -0,0 +1,88 @@
+# SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: CC0-1.0
+import json
+import logging
+import os
+
+import pytest
+from pytest_embedded import Dut
+
+BENCH_CONFIGS = [
+    'bench_single_fb_no_bb',
+    'bench_single_fb_with_bb',
+    'bench_double_fb',
+    'bench_h035a17_single_fb_no_bb',
+    'bench_indexed_bb',
+]
+
+
+# LVGL runs on a virtual clock, one refresh period per frame scanned out, so the demo renders the same frames in
+# every run. The counters are ratios, per frame or per area, the margin lets a change move them a little without a
+# new baseline
+BENCH_MARGIN = 0.05
+
+
+def bench_measure(result: dict) -> dict:
+    screen_bytes = result['h_res'] * result['v_res'] * result['pixel_size']
+    # only counters, normalized so they compare across panels. Times depend on the load of the CI runner,
+    # they are reported but never fail the test
+    return {
+        'flush_screens_per_frame': result['flush_bytes'] / screen_bytes / result['frames'],
+        'rendered_per_invalidated': result['rendered_px'] / max(result['invalidated_px'], 1),
+        'flush_calls_per_rendered_frame': result['flush_calls'] / max(result['rendered_frames'], 1),
+        'peak_heap_bytes': result['peak_heap_bytes'],
+    }
+
+
+def bench_violations(config: str, result: dict) -> list:
+    path = os.path.join(os.path.dirname(__file__), 'bench_baseline.json')
+    with open(path) as f:
+        baseline = json.load(f)
+    measured = bench_measure(result)
+    if os.environ.get('HOST_SIM_RECORD_BENCH_BASELINE') == '1':
+        baseline[config] = measured
+        with open(path, 'w') as f:
+            json.dump(baseline, f, indent=4, sort_keys=True)
+            f.write('\n')
+        return []
+    if config not in baseline:
+        return ['no baseline recorded, record it with HOST_SIM_RECORD_BENCH_BASELINE=1']
+    violations = []
+    for metric, base in sorted(baseline[config].items()):
+        limit = base * (1 + BENCH_MARGIN)
+        if measured[metric] > limit:
+            violations.append('{} = {:.3f} > {:.3f} (baseline {:.3f})'.format(metric, measured[metric], limit, base))
+    return violations
+
+
+@pytest.mark.linux
+@pytest.mark.host_test
+def test_rgb_lcd_host_sim(dut: Dut, config: str) -> None:
+    # the example's own log, up to the point its tasks take over
+    dut.expect_exact('example: Select RGB LCD panel')
+    dut.expect(r'panel: \w+, ID \d+ from default, \d+x\d+ at [\d.]+ Hz')
+    dut.expect_exact('example: Initialize 3-Wire SPI Panel IO')
+    dut.expect(r'timing: [\d.]+ Hz refresh, [\d.]+ us per line')
+    dut.expect(r'timing: highest pixel clock keeping \d+% free: \d+ Hz from the frame buffer')
+    dut.expect_exact('example: Install RGB LCD panel driver')
+    dut.expect_exact('example: Blit self test: pass')
+    dut.expect_exact('example: Initialize LVGL library')
+    dut.expect_exact('example: Display LVGL UI')
+    # the last frame is taken by the scan-out, which can catch LVGL halfway through a frame: its CRC32 is only logged
+    crc = dut.expect(r'example: Screen CRC32: ([0-9a-f]{8})').group(1).decode()
+    dut.expect_exact('example: Simulation done')
+    logging.info('%s: screen CRC32 %s', config, crc)
+
+
+@pytest.mark.linux
+@pytest.mark.host_test
+@pytest.mark.parametrize('config', BENCH_CONFIGS, indirect=True)
+def test_rgb_lcd_host_bench(dut: Dut, config: str) -> None:
+    result = json.loads(dut.expect(r'BENCH (\{.*\})').group(1).decode())
+    dut.expect_exact('example: Simulation done')
+    # kept with the logs, to compare runs
+    with open(os.path.join(dut.logdir, 'bench_{}.json'.format(config)), 'w') as f:
+        json.dump(result, f, indent=4)
+    logging.info('%s: render %d us avg, %d us max', config, result['render_us_avg'], result['render_us_max'])
+    violations = bench_violations(config, result)
+    assert not violations, 'benchmark regression in {}: {}'.format(config, ', '.join(violations))
@@ -0,0 +1,219 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "unity.h"
+#include "async_flush.h"
+
+#define TEST_DMA_ALIGN          32  // destination alignment, as the PSRAM cache line
+#define TEST_DMA_SRC_ALIGN      4
+#define TEST_DMA_MIN_BYTES      64
+#define TEST_DMA_MAX_COPIES     64
+#define TEST_BUF_SIZE           (16 * 1024)
+#define TEST_UNTOUCHED          0xA5
+
+typedef struct {
+    uint8_t *dst;
+    const uint8_t *src;
+    size_t size;
+} test_dma_copy_t;
+
+// a DMA engine that queues the copies, and only moves the data when the test completes them
+static struct {
+    uint32_t backlog;           // copies the engine takes before refusing
+    bool complete_at_once;      // report the completion from within dma_copy(), before it returns
+    test_dma_copy_t queue[TEST_DMA_MAX_COPIES];
+    uint32_t head;
+    uint32_t tail;
+    test_dma_copy_t started[TEST_DMA_MAX_COPIES];
+    uint32_t num_started;
+    uint32_t refused;
+    uint32_t syncs_misaligned;
+    uint32_t done_calls;
+} s_dma;
+
+static uint8_t s_src[TEST_BUF_SIZE] __attribute__((aligned(64)));
+static uint8_t s_dst[TEST_BUF_SIZE] __attribute__((aligned(64)));
+static uint8_t s_ref[TEST_BUF_SIZE] __attribute__((aligned(64)));
+
+static void test_dma_complete(uint32_t count)
+{
+    while (count-- && s_dma.tail != s_dma.head) {
+        test_dma_copy_t *copy = &s_dma.queue[s_dma.tail++ % TEST_DMA_MAX_COPIES];
+        memcpy(copy->dst, copy->src, copy->size);
+        example_async_flush_dma_done();
+    }
+}
+
+static bool test_dma_copy(void *dst, const void *src, size_t size, void *ctx)
+{
+    if (s_dma.head - s_dma.tail >= s_dma.backlog) {
+        s_dma.refused++;
+        return false;
+    }
+    TEST_ASSERT_LESS_THAN(TEST_DMA_MAX_COPIES, s_dma.num_started);
+    test_dma_copy_t copy = {dst, src, size};
+    s_dma.started[s_dma.num_started++] = copy;
+    s_dma.queue[s_dma.head++ % TEST_DMA_MAX_COPIES] = copy;
+    if (s_dma.complete_at_once) {
+        test_dma_complete(1);
+    }
+    return true;
+}
+
+static void test_dma_sync_cache(void *addr, size_t size, bool writeback, void *ctx)
+{
+    // the cache works on whole lines, a partial one would clobber its neighbours
+    if (((uintptr_t)addr | size) & (TEST_DMA_ALIGN - 1)) {
+        s_dma.syncs_misaligned++;
+    }
+}
+
+static bool test_flush_done(void *user_ctx)
+{
+    s_dma.done_calls++;
+    return false;
+}
+
+static void test_flush_setup(uint32_t backlog, bool complete_at_once)
+{
+    memset(&s_dma, 0, sizeof(s_dma));
+    s_dma.backlog = backlog;
+    s_dma.complete_at_once = complete_at_once;
+    example_async_flush_ops_t ops = {
+        .dst_align = TEST_DMA_ALIGN,
+        .src_align = TEST_DMA_SRC_ALIGN,
+        .min_dma_bytes = TEST_DMA_MIN_BYTES,
+        .dma_copy = test_dma_copy,
+        .sync_cache = test_dma_sync_cache,
+    };
+    example_async_flush_init(&ops, test_flush_done, NULL);
+    for (uint32_t i = 0; i < TEST_BUF_SIZE; i++) {
+        s_src[i] = (uint8_t)(i * 7 + 3);
+    }
+    memset(s_dst, TEST_UNTOUCHED, sizeof(s_dst));
+    memset(s_ref, TEST_UNTOUCHED, sizeof(s_ref));
+}
+
+// start a rectangle, and what the destination must look like once it's done
+static void test_flush_start(uint32_t dst_off, uint32_t dst_stride, uint32_t src_off, uint32_t src_stride,
+                             uint32_t width_bytes, uint32_t h)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        memcpy(s_ref + dst_off + y * dst_stride, s_src + src_off + y * src_stride, width_bytes);
+    }
+    example_async_flush_start(s_dst + dst_off, dst_stride, s_src + src_off, src_stride, width_bytes, h);
+}
+
+TEST_CASE("async flush: DMA takes the aligned middle, the CPU the head and tail", "[async_flush]")
+{
+    test_flush_setup(TEST_DMA_MAX_COPIES, false);
+    const uint32_t dst_off = 1000, dst_stride = 1600, src_off = 8, src_stride = 400, width = 300, h = 6;
+    test_flush_start(dst_off, dst_stride, src_off, src_stride, width, h);
+
+    // one copy per line, whole cache lines of the destination, the source is as misaligned as the destination
+    TEST_ASSERT_EQUAL_UINT32(h, s_dma.num_started);
+    TEST_ASSERT_EQUAL_UINT32(0, s_dma.done_calls);
+    for (uint32_t y = 0; y < h; y++) {
+        uintptr_t line = (uintptr_t)(s_dst + dst_off + y * dst_stride);
+        uintptr_t start = (line + TEST_DMA_ALIGN - 1) & ~(uintptr_t)(TEST_DMA_ALIGN - 1);
+        uintptr_t end = (line + width) & ~(uintptr_t)(TEST_DMA_ALIGN - 1);
+        const test_dma_copy_t *copy = &s_dma.started[y];
+        TEST_ASSERT_EQUAL_UINT32(start, (uintptr_t)copy->dst);
+        TEST_ASSERT_EQUAL_UINT32(end - start, copy->size);
+        TEST_ASSERT_EQUAL_UINT32((uintptr_t)(s_src + src_off + y * src_stride + (start - line)), (uintptr_t)copy->src);
+
+        // the head and tail are there before the DMA runs, the middle is not
+        uint32_t head = start - line;
+        uint32_t tail = line + width - end;
+        const uint8_t *d = s_dst + dst_off + y * dst_stride;
+        const uint8_t *r = s_ref + dst_off + y * dst_stride;
+        TEST_ASSERT_EQUAL_MEMORY(r, d, head);
+        TEST_ASSERT_EQUAL_MEMORY(r + width - tail, d + width - tail, tail);
+        TEST_ASSERT_EQUAL_UINT8(TEST_UNTOUCHED, d[head]);
+        TEST_ASSERT_EQUAL_UINT8(TEST_UNTOUCHED, d[width - tail - 1]);
+    }
+
+    test_dma_complete(h - 1);
+    TEST_ASSERT_EQUAL_UINT32(0, s_dma.done_calls);
+    test_dma_complete(1);
+    TEST_ASSERT_EQUAL_UINT32(1, s_dma.done_calls);
+    // nothing written outside the rectangle either
+    TEST_ASSERT_EQUAL_MEMORY(s_ref, s_dst, TEST_BUF_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(0, s_dma.syncs_misaligned);
+}
+
+TEST_CASE("async flush: lines the DMA can't take are copied by the CPU", "[async_flush]")
+{
+    // the source is 2 bytes off the destination alignment, the DMA would read unaligned words
+    test_flush_setup(TEST_DMA_MAX_COPIES, false);
+    test_flush_start(64, 1600, 2, 400, 300, 4);
+    TEST_ASSERT_EQUAL_UINT32(0, s_dma.num_started);
+    TEST_ASSERT_EQUAL_UINT32(1, s_dma.done_calls);
+    TEST_ASSERT_EQUAL_MEMORY(s_ref, s_dst, TEST_BUF_SIZE);
+
+    // too short for the DMA once the head and tail are cut off
+    test_flush_setup(TEST_DMA_MAX_COPIES, false);
+    test_flush_start(1, 1600, 1, 400, TEST_DMA_MIN_BYTES + 2, 4);
+    TEST_ASSERT_EQUAL_UINT32(0, s_dma.num_started);
+    TEST_ASSERT_EQUAL_UINT32(1, s_dma.done_calls);
+    TEST_ASSERT_EQUAL_MEMORY(s_ref, s_dst, TEST_BUF_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(0, s_dma.syncs_misaligned);
+}
+
+TEST_CASE("async flush: a contiguous rectangle is one copy", "[async_flush]")
+{
+    test_flush_setup(TEST_DMA_MAX_COPIES, false);
+    test_flush_start(4, 800, 4, 800, 800, 10);
+    TEST_ASSERT_EQUAL_UINT32(1, s_dma.num_started);
+    TEST_ASSERT_EQUAL_UINT32(800 * 10 - TEST_DMA_ALIGN, s_dma.started[0].size);
+    test_dma_complete(1);
+    TEST_ASSERT_EQUAL_UINT32(1, s_dma.done_calls);
+    TEST_ASSERT_EQUAL_MEMORY(s_ref, s_dst, TEST_BUF_SIZE);
+}
+
+TEST_CASE("async flush: lines beyond the DMA backlog wait for completions", "[async_flush]")
+{
+    const uint32_t backlog = 4, h = 20;
+    test_flush_setup(backlog, false);
+    test_flush_start(0, 512, 0, 256, 256, h);
+    TEST_ASSERT_EQUAL_UINT32(backlog, s_dma.num_started);
+    TEST_ASSERT_EQUAL_UINT32(1, s_dma.refused);
+
+    // every completion makes room for one more line
+    for (uint32_t done = 1; done < h; done++) {
+        test_dma_complete(1);
+        TEST_ASSERT_EQUAL_UINT32(done + backlog < h ? done + backlog : h, s_dma.num_started);
+        TEST_ASSERT_EQUAL_UINT32(0, s_dma.done_calls);
+    }
+    test_dma_complete(1);
+    TEST_ASSERT_EQUAL_UINT32(h, s_dma.num_started);
+    TEST_ASSERT_EQUAL_UINT32(1, s_dma.done_calls);
+    TEST_ASSERT_EQUAL_MEMORY(s_ref, s_dst, TEST_BUF_SIZE);
+}
+
+TEST_CASE("async flush: a full DMA with nothing in flight falls back to the CPU", "[async_flush]")
+{
+    // no completion would ever retry the line, it must not wait
+    test_flush_setup(0, false);
+    test_flush_start(0, 512, 0, 256, 256, 3);
+    TEST_ASSERT_EQUAL_UINT32(0, s_dma.num_started);
+    TEST_ASSERT_EQUAL_UINT32(3, s_dma.refused);
+    TEST_ASSERT_EQUAL_UINT32(1, s_dma.done_calls);
+    TEST_ASSERT_EQUAL_MEMORY(s_ref, s_dst, TEST_BUF_SIZE);
+}
+
+TEST_CASE("async flush: completions before dma_copy() returns", "[async_flush]")
+{
+    // a fast DMA finishes every copy while the lines are still being queued, done must fire once, at the end
+    test_flush_setup(1, true);
+    test_flush_start(0, 512, 0, 256, 256, 8);
+    TEST_ASSERT_EQUAL_UINT32(8, s_dma.num_started);
+    TEST_ASSERT_EQUAL_UINT32(1, s_dma.done_calls);
+    TEST_ASSERT_EQUAL_MEMORY(s_ref, s_dst, TEST_BUF_SIZE);
+}
@@ -0,0 +1,220 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "unity.h"
+#include "beam_race.h"
+
+#define TEST_BEAM_MARGIN_LINES  4           // as EXAMPLE_BEAM_MARGIN_LINES
+#define TEST_PIXEL_SIZE         2
+#define TEST_VSYNC_US           0xFFFFF000  // 4 ms before the 32-bit time wraps around, within the first frame
+#define TEST_FAST_NS_PER_BYTE   25          // CPU copy, faster than the scan-out on every panel
+#define TEST_SLOW_NS_PER_BYTE   100         // slower than the scan-out on every panel
+
+// timings of the four panels, as in their descriptors
+typedef struct {
+    const char *name;
+    uint32_t pclk_hz;
+    uint32_t h_res;
+    uint32_t v_res;
+    uint32_t h_blank;       // sync pulse and porches
+    uint32_t vsync_pulse;
+    uint32_t vsync_back_porch;
+    uint32_t vsync_front_porch;
+} test_panel_t;
+
+static const test_panel_t s_panels[] = {
+    {"nv3052c", 15 * 1000 * 1000, 720, 720, 2 + 44 + 46, 5, 15, 16},
+    {"h040a18", 20 * 1000 * 1000, 400, 960, 8 + 50 + 50, 8, 20, 20},
+    {"h035a17", 20 * 1000 * 1000, 640, 480, 23 + 20 + 20, 2, 6, 12},
+    {"st7701s", 20 * 1000 * 1000, 480, 854, 80 + 40 + 40, 4, 20, 20},
+};
+
+static const test_panel_t *s_panel;
+static example_beam_config_t s_config;
+static double s_line_us;
+static uint32_t s_writes;   // writes scheduled by the last test_beam_check_writes()
+
+static void test_beam_setup(const test_panel_t *panel, uint32_t ns_per_byte)
+{
+    s_panel = panel;
+    s_config = (example_beam_config_t) {
+        .pclk_hz = panel->pclk_hz,
+        .h_total = panel->h_res + panel->h_blank,
+        .v_res = panel->v_res,
+        .v_total = panel->v_res + panel->vsync_pulse + panel->vsync_back_porch + panel->vsync_front_porch,
+        .vsync_to_active_lines = panel->vsync_pulse + panel->vsync_back_porch,
+        .margin_lines = TEST_BEAM_MARGIN_LINES,
+    };
+    example_beam_init(&s_config);
+    s_line_us = (double)s_config.h_total * 1e6 / s_config.pclk_hz;
+    // the write time estimate follows the measured writes
+    for (int i = 0; i < 200; i++) {
+        example_beam_write_done(1000, ns_per_byte);
+    }
+    example_beam_on_vsync(TEST_VSYNC_US);
+}
+
+// scan-out position at `t_us`, counted from the first active line after the VSYNC and not wrapped to the frame
+static double test_beam_pos(double t_us)
+{
+    return (t_us - TEST_VSYNC_US) / s_line_us - s_config.vsync_to_active_lines;
+}
+
+// whether the scan-out passes over lines [lo, hi) of any frame while it moves from pos_a to pos_b
+static bool test_beam_crosses(double pos_a, double pos_b, double lo, double hi)
+{
+    const double v_total = s_config.v_total;
+    double k = floor((pos_a - lo) / v_total);
+    if (pos_a < hi + k * v_total) {
+        return true;
+    }
+    return lo + (k + 1) * v_total <= pos_b;
+}
+
+// Schedule the write of lines y1 to y2 with the scan-out at every position over two frames, then check that no
+// line is scanned out while it's being written. Returns the number of writes reported as unavoidable.
+static uint32_t test_beam_check_writes(int32_t y1, int32_t y2, bool top_down)
+{
+    example_beam_stats_t stats;
+    example_beam_get_stats(&stats, true);
+    const uint32_t lines = y2 - y1 + 1;
+    const uint32_t bytes = lines * s_panel->h_res * TEST_PIXEL_SIZE;
+    const double write_us = bytes * (double)stats.copy_ns_per_byte / 1000.0;
+    uint32_t unavoidable = 0;
+
+    s_writes = 0;
+    for (double pos = -1.0 * s_config.vsync_to_active_lines; pos < 2.0 * s_config.v_total; pos += 0.75) {
+        double now_us = TEST_VSYNC_US + (pos + s_config.vsync_to_active_lines) * s_line_us;
+        uint32_t wait_us = example_beam_schedule(y1, y2, bytes, top_down, (int64_t)now_us);
+        s_writes++;
+        example_beam_get_stats(&stats, true);
+        TEST_ASSERT_EQUAL_UINT32(1, stats.writes);
+        if (stats.unavoidable) {
+            TEST_ASSERT_EQUAL_UINT32(0, wait_us);
+            unavoidable++;
+            continue;
+        }
+        // never more than a frame away
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(ceil(s_config.v_total * s_line_us), wait_us);
+        TEST_ASSERT_EQUAL_UINT32(wait_us ? 1 : 0, stats.deferred);
+
+        double start_us = (int64_t)now_us + wait_us;
+        if (top_down) {
+            // the lines are written one after the other, each must be clear of the scan-out while it's written
+            for (uint32_t i = 0; i < lines; i++) {
+                double a = test_beam_pos(start_us + write_us * i / lines);
+                double b = test_beam_pos(start_us + write_us * (i + 1) / lines);
+                TEST_ASSERT_FALSE_MESSAGE(test_beam_crosses(a, b, y1 + i, y1 + i + 1), s_panel->name);
+            }
+        } else {
+            // in any order, the scan-out must stay away from all of them
+            double a = test_beam_pos(start_us);
+            double b = test_beam_pos(start_us + write_us);
+            TEST_ASSERT_FALSE_MESSAGE(test_beam_crosses(a, b, y1, y2 + 1), s_panel->name);
+        }
+    }
+    return unavoidable;
+}
+
+TEST_CASE("beam race: scan-out position from the VSYNC", "[beam_race]")
+{
+    for (uint32_t p = 0; p < sizeof(s_panels) / sizeof(s_panels[0]); p++) {
+        test_beam_setup(&s_panels[p], TEST_FAST_NS_PER_BYTE);
+        const float v_total = s_config.v_total;
+        const int64_t vsync = TEST_VSYNC_US;
+        // the VSYNC comes with the pulse, the blanking lines before the first active one count from the end
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, v_total - s_config.vsync_to_active_lines, example_beam_line(vsync));
+        float line_us = s_line_us;
+        int64_t active = vsync + (int64_t)ceilf(s_config.vsync_to_active_lines * line_us);
+        TEST_ASSERT_FLOAT_WITHIN(0.05f, 0, example_beam_line(active));
+        // past the 32-bit wrap of the time
+        int64_t mid = active + (int64_t)(s_config.v_res / 2 * line_us);
+        TEST_ASSERT_TRUE(mid > UINT32_MAX);
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, s_config.v_res / 2, example_beam_line(mid));
+        // the next frame, without a new VSYNC
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, 10, example_beam_line(active + (int64_t)((v_total + 10) * line_us)));
+        for (int64_t t = vsync; t < vsync + 3 * v_total * line_us; t += 97) {
+            float line = example_beam_line(t);
+            TEST_ASSERT_TRUE(line >= 0 && line < v_total);
+        }
+    }
+}
+
+TEST_CASE("beam race: unknown scan-out position", "[beam_race]")
+{
+    example_beam_init(&(example_beam_config_t) {
+        .pclk_hz = s_panels[0].pclk_hz,
+        .h_total = 812,
+        .v_res = 720,
+        .v_total = 756,
+        .vsync_to_active_lines = 20,
+        .margin_lines = TEST_BEAM_MARGIN_LINES,
+    });
+    // before the first VSYNC, writes go right away
+    TEST_ASSERT_TRUE(example_beam_line(1000) < 0);
+    TEST_ASSERT_EQUAL_UINT32(0, example_beam_schedule(0, 719, 720 * 720 * 2, true, 1000));
+    example_beam_stats_t stats;
+    example_beam_get_stats(&stats, true);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.writes);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.deferred);
+}
+
+TEST_CASE("beam race: writes never overlap the scan-out, all panels", "[beam_race]")
+{
+    for (uint32_t p = 0; p < sizeof(s_panels) / sizeof(s_panels[0]); p++) {
+        const int32_t v = s_panels[p].v_res;
+        // bands at the top, the middle and the bottom, which wrap around the blanking into the next frame
+        const struct {
+            int32_t y1;
+            int32_t y2;
+        } bands[] = {
+            {0, 15},
+            {0, 0},
+            {v / 2 - 20, v / 2 + 20},
+            {v / 4, v * 3 / 4},
+            {v - 16, v - 1},
+            {v - 1, v - 1},
+        };
+        const uint32_t speeds[] = {TEST_FAST_NS_PER_BYTE, TEST_SLOW_NS_PER_BYTE};
+        for (uint32_t s = 0; s < sizeof(speeds) / sizeof(speeds[0]); s++) {
+            for (uint32_t b = 0; b < sizeof(bands) / sizeof(bands[0]); b++) {
+                for (int top_down = 0; top_down <= 1; top_down++) {
+                    test_beam_setup(&s_panels[p], speeds[s]);
+                    uint32_t lines = bands[b].y2 - bands[b].y1 + 1;
+                    double write_lines = lines * s_panels[p].h_res * TEST_PIXEL_SIZE * speeds[s] / 1000.0 / s_line_us;
+                    uint32_t unavoidable = test_beam_check_writes(bands[b].y1, bands[b].y2, top_down);
+                    // a write that fits between two passes of the scan-out is always scheduled
+                    if (write_lines + lines + 2 * TEST_BEAM_MARGIN_LINES + 1 < s_config.v_total) {
+                        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, unavoidable, s_panels[p].name);
+                    }
+                    // one that doesn't never is, unless written top-down behind the scan-out
+                    if (!top_down && write_lines + lines + 2 * TEST_BEAM_MARGIN_LINES > s_config.v_total + 1) {
+                        TEST_ASSERT_EQUAL_UINT32_MESSAGE(s_writes, unavoidable, s_panels[p].name);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("beam race: slow top-down writes follow the scan-out", "[beam_race]")
+{
+    for (uint32_t p = 0; p < sizeof(s_panels) / sizeof(s_panels[0]); p++) {
+        // a third of the screen doesn't fit between two passes of the scan-out, only following it down avoids tearing
+        const int32_t y1 = s_panels[p].v_res / 3;
+        const int32_t y2 = y1 + s_panels[p].v_res / 3 - 1;
+        const uint32_t lines = y2 - y1 + 1;
+        test_beam_setup(&s_panels[p], TEST_SLOW_NS_PER_BYTE);
+        double write_lines = lines * s_panels[p].h_res * TEST_PIXEL_SIZE * TEST_SLOW_NS_PER_BYTE / 1000.0 / s_line_us;
+        TEST_ASSERT_TRUE(write_lines + lines + 2 * TEST_BEAM_MARGIN_LINES > s_config.v_total);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, test_beam_check_writes(y1, y2, true), s_panels[p].name);
+        uint32_t unavoidable = test_beam_check_writes(y1, y2, false);
+        TEST_ASSERT_EQUAL_UINT32(s_writes, unavoidable);
+    }
+}
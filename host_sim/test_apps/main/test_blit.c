@@ -0,0 +1,222 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "blit.h"
+
+#define TEST_BLIT_ROUNDS    300
+#define TEST_BLIT_MAX_W     100
+#define TEST_BLIT_MAX_H     20
+#define TEST_BLIT_PAD       48  // extra stride, and room for the offsets
+#define TEST_BLIT_BUF_SIZE  ((TEST_BLIT_MAX_W * 3 + TEST_BLIT_PAD) * TEST_BLIT_MAX_W + TEST_BLIT_PAD)
+
+typedef struct {
+    uint32_t w;
+    uint32_t h;
+    uint32_t src_off;
+    uint32_t dst_off;
+    uint32_t src_stride;
+    uint32_t dst_stride;
+} test_blit_rect_t;
+
+static uint32_t s_seed;
+// the whole buffers are compared, so a write outside the rectangle is a failure too
+static uint8_t s_src[TEST_BLIT_BUF_SIZE];
+static uint8_t s_out[TEST_BLIT_BUF_SIZE];
+static uint8_t s_ref[TEST_BLIT_BUF_SIZE];
+static uint16_t s_lut565[256];
+static uint32_t s_lut888[256];
+static uint8_t s_inv_lut[EXAMPLE_BLIT_L8_KEYS];
+
+static uint32_t test_rand(uint32_t range)
+{
+    s_seed = s_seed * 1103515245 + 12345;
+    return (s_seed >> 8) % range;
+}
+
+static void test_fill(uint8_t *buf, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        buf[i] = test_rand(256);
+    }
+}
+
+static void test_blit_setup(uint32_t seed)
+{
+    s_seed = seed;
+    test_fill(s_src, sizeof(s_src));
+    test_fill(s_out, sizeof(s_out));
+    memcpy(s_ref, s_out, sizeof(s_ref));
+    test_fill((uint8_t *)s_lut565, sizeof(s_lut565));
+    // the top byte of the RGB888 entries is not part of the color
+    test_fill((uint8_t *)s_lut888, sizeof(s_lut888));
+    test_fill(s_inv_lut, sizeof(s_inv_lut));
+}
+
+// A random rectangle. Every other round both sides get the same alignment, which the fast paths need, the
+// others any alignment. Strides are tight (one contiguous block) or padded by any number of bytes.
+static test_blit_rect_t test_blit_rect(uint32_t round, uint32_t src_ps, uint32_t dst_ps, uint32_t dst_line_px)
+{
+    test_blit_rect_t r = {
+        .w = 1 + test_rand(TEST_BLIT_MAX_W),
+        .h = 1 + test_rand(TEST_BLIT_MAX_H),
+        .src_off = test_rand(16),
+        .dst_off = test_rand(16),
+    };
+    if (round & 1) {
+        r.dst_off = r.src_off;
+    }
+    uint32_t pad = test_rand(4) == 0 ? 0 : test_rand(TEST_BLIT_PAD);
+    r.src_stride = r.w * src_ps + pad;
+    r.dst_stride = (dst_line_px ? dst_line_px : r.w) * dst_ps + (round & 2 ? pad : test_rand(TEST_BLIT_PAD));
+    return r;
+}
+
+static void test_blit_check(uint32_t round, const char *op, const test_blit_rect_t *r)
+{
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%s round %lu: %lux%lu src +%lu/%lu dst +%lu/%lu", op, (unsigned long)round,
+             (unsigned long)r->w, (unsigned long)r->h, (unsigned long)r->src_off, (unsigned long)r->src_stride,
+             (unsigned long)r->dst_off, (unsigned long)r->dst_stride);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(s_ref, s_out, sizeof(s_out), msg);
+}
+
+TEST_CASE("blit: copy matches the reference", "[blit]")
+{
+    for (uint32_t round = 0; round < TEST_BLIT_ROUNDS; round++) {
+        test_blit_setup(round + 1);
+        const uint32_t ps = 1 + test_rand(3);
+        test_blit_rect_t r = test_blit_rect(round, ps, ps, 0);
+        example_blit_copy(s_out + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w * ps, r.h);
+        example_blit_copy_ref(s_ref + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w * ps, r.h);
+        test_blit_check(round, "copy", &r);
+    }
+}
+
+TEST_CASE("blit: swap16 matches the reference", "[blit]")
+{
+    for (uint32_t round = 0; round < TEST_BLIT_ROUNDS; round++) {
+        test_blit_setup(round + 1);
+        test_blit_rect_t r = test_blit_rect(round, 2, 2, 0);
+        example_blit_swap16(s_out + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w, r.h);
+        example_blit_swap16_ref(s_ref + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w, r.h);
+        test_blit_check(round, "swap16", &r);
+    }
+}
+
+TEST_CASE("blit: RGB888 to RGB565 matches the reference", "[blit]")
+{
+    for (uint32_t round = 0; round < TEST_BLIT_ROUNDS; round++) {
+        test_blit_setup(round + 1);
+        test_blit_rect_t r = test_blit_rect(round, 3, 2, 0);
+        example_blit_rgb888_to_rgb565(s_out + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w, r.h);
+        example_blit_rgb888_to_rgb565_ref(s_ref + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w, r.h);
+        test_blit_check(round, "rgb888_to_rgb565", &r);
+    }
+}
+
+TEST_CASE("blit: RGB888 to RGB565 keeps the top bits of each channel", "[blit]")
+{
+    // LVGL byte order, B, G, R
+    const uint8_t src[] = {0xFF, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0xFF, 0x07, 0x03, 0x07, 0x08, 0x04, 0x08};
+    const uint16_t expected[] = {0x001F, 0x07E0, 0xF800, 0x0000, 0x0821};
+    uint8_t out[sizeof(expected) + 1] = {0};
+    uint8_t ref[sizeof(expected) + 1] = {0};
+    // odd destination address, the word stores can't be used
+    example_blit_rgb888_to_rgb565(out + 1, sizeof(expected), src, sizeof(src), 5, 1);
+    example_blit_rgb888_to_rgb565_ref(ref + 1, sizeof(expected), src, sizeof(src), 5, 1);
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_HEX16(expected[i], out[1 + i * 2] | (out[2 + i * 2] << 8));
+        TEST_ASSERT_EQUAL_HEX16(expected[i], ref[1 + i * 2] | (ref[2 + i * 2] << 8));
+    }
+}
+
+TEST_CASE("blit: rotation matches the reference", "[blit]")
+{
+    for (uint32_t round = 0; round < TEST_BLIT_ROUNDS; round++) {
+        test_blit_setup(round + 1);
+        const example_blit_rotation_t rotation = round % 4;
+        // 16-bit pixels take the tiled path when aligned, RGB888 always the reference
+        const uint32_t ps = test_rand(3) ? 2 : 3;
+        // rotated by 90 or 270 degrees, the destination lines are `h` pixels long
+        const bool transposed = rotation == EXAMPLE_BLIT_ROTATE_90 || rotation == EXAMPLE_BLIT_ROTATE_270;
+        test_blit_rect_t r = test_blit_rect(round, ps, ps, transposed ? TEST_BLIT_MAX_W : 0);
+        if (round & 4) {
+            r.src_off &= ~1;
+            r.dst_off &= ~1;
+            r.src_stride &= ~1;
+            r.dst_stride &= ~1;
+        }
+        example_blit_rotate(s_out + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w, r.h, ps, rotation);
+        example_blit_rotate_ref(s_ref + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w, r.h, ps, rotation);
+        test_blit_check(round, "rotate", &r);
+    }
+}
+
+TEST_CASE("blit: rotation reference moves every pixel clockwise", "[blit]")
+{
+    // 3x2, pixel (x, y) holds 10 * y + x
+    const uint16_t src[] = {0, 1, 2, 10, 11, 12};
+    const uint16_t expected[4][6] = {
+        {0, 1, 2, 10, 11, 12},
+        {10, 0, 11, 1, 12, 2},  // 2x3
+        {12, 11, 10, 2, 1, 0},
+        {2, 12, 1, 11, 0, 10},  // 2x3
+    };
+    for (int rotation = 0; rotation < 4; rotation++) {
+        uint16_t out[6] = {0};
+        uint16_t ref[6] = {0};
+        const uint32_t dst_stride = (rotation & 1 ? 2 : 3) * sizeof(uint16_t);
+        example_blit_rotate((uint8_t *)out, dst_stride, (const uint8_t *)src, 3 * sizeof(uint16_t), 3, 2, 2, rotation);
+        example_blit_rotate_ref((uint8_t *)ref, dst_stride, (const uint8_t *)src, 3 * sizeof(uint16_t), 3, 2, 2, rotation);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(expected[rotation], out, 6);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(expected[rotation], ref, 6);
+    }
+}
+
+TEST_CASE("blit: palette expansion matches the reference", "[blit]")
+{
+    for (uint32_t round = 0; round < TEST_BLIT_ROUNDS; round++) {
+        test_blit_setup(round + 1);
+        if (round & 4) {
+            test_blit_rect_t r = test_blit_rect(round, 1, 3, 0);
+            example_blit_l8_to_rgb888(s_out + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w, r.h, s_lut888);
+            example_blit_l8_to_rgb888_ref(s_ref + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w, r.h, s_lut888);
+            test_blit_check(round, "l8_to_rgb888", &r);
+        } else {
+            test_blit_rect_t r = test_blit_rect(round, 1, 2, 0);
+            example_blit_l8_to_rgb565(s_out + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w, r.h, s_lut565);
+            example_blit_l8_to_rgb565_ref(s_ref + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w, r.h, s_lut565);
+            test_blit_check(round, "l8_to_rgb565", &r);
+        }
+    }
+}
+
+TEST_CASE("blit: palette quantization matches the reference", "[blit]")
+{
+    for (uint32_t round = 0; round < TEST_BLIT_ROUNDS; round++) {
+        test_blit_setup(round + 1);
+        if (round & 4) {
+            test_blit_rect_t r = test_blit_rect(round, 3, 1, 0);
+            example_blit_rgb888_to_l8(s_out + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w, r.h, s_inv_lut);
+            example_blit_rgb888_to_l8_ref(s_ref + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w, r.h, s_inv_lut);
+            test_blit_check(round, "rgb888_to_l8", &r);
+        } else {
+            test_blit_rect_t r = test_blit_rect(round, 2, 1, 0);
+            example_blit_rgb565_to_l8(s_out + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w, r.h, s_inv_lut);
+            example_blit_rgb565_to_l8_ref(s_ref + r.dst_off, r.dst_stride, s_src + r.src_off, r.src_stride, r.w, r.h, s_inv_lut);
+            test_blit_check(round, "rgb565_to_l8", &r);
+        }
+    }
+}
+
+TEST_CASE("blit: self test passes", "[blit]")
+{
+    TEST_ASSERT_TRUE(example_blit_self_test());
+}
@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdint.h>
+#include "unity.h"
+#include "bounce_buffer.h"
+
+#define TEST_BOUNCE_LINES       10
+#define TEST_BOUNCE_T0_US       1000000
+#define TEST_BOUNCE_LATENCY_US  20  // from the DMA EOF to the refill start
+#define TEST_BOUNCE_FILL_US     100
+
+// NV3052C timings, as in its panel descriptor
+static const example_bounce_config_t s_config = {
+    .pclk_hz = 15 * 1000 * 1000,
+    .h_res = 720,
+    .v_res = 720,
+    .h_total = 720 + 2 + 44 + 46,
+    .v_total = 720 + 5 + 15 + 16,
+    .pixel_size = 2,
+    .fb_pixel_size = 2,
+};
+
+static double test_line_us(void)
+{
+    return (double)s_config.h_total * 1e6 / s_config.pclk_hz;
+}
+
+// when the DMA starts reading the bounce buffer at `pos_px` of `frame`
+static double test_bounce_read_us(uint32_t frame, int32_t pos_px)
+{
+    double frame_us = s_config.v_total * test_line_us();
+    return TEST_BOUNCE_T0_US + frame * frame_us + (double)pos_px / s_config.h_res * test_line_us();
+}
+
+// Refill every bounce buffer of `frames` frames as the RGB driver asks for them: once the DMA emptied the buffer
+// two positions before. `late_pos_px` of the last frame ends `late_us` after the DMA started reading it.
+static uint32_t test_bounce_run(uint32_t frames, int32_t late_pos_px, int32_t late_us)
+{
+    TEST_ESP_OK(example_bounce_init(&s_config, s_config.h_res * TEST_BOUNCE_LINES));
+    const int32_t size_px = s_config.h_res * TEST_BOUNCE_LINES;
+    const int32_t frame_px = s_config.h_res * s_config.v_res;
+    for (uint32_t frame = 1; frame <= frames; frame++) {
+        for (int32_t pos = 0; pos < frame_px; pos += size_px) {
+            // the first two buffers are asked for by the last two of the frame before
+            double request_us = test_bounce_read_us(frame, pos - 2 * size_px) + TEST_BOUNCE_LINES * test_line_us();
+            if (pos < 2 * size_px) {
+                request_us = test_bounce_read_us(frame - 1, frame_px + pos - 2 * size_px) + TEST_BOUNCE_LINES * test_line_us();
+            }
+            int64_t start_us = (int64_t)request_us + TEST_BOUNCE_LATENCY_US;
+            int64_t end_us = start_us + TEST_BOUNCE_FILL_US;
+            if (frame == frames && pos == late_pos_px) {
+                end_us = (int64_t)test_bounce_read_us(frame, pos) + late_us;
+                start_us = end_us - TEST_BOUNCE_FILL_US;
+            }
+            example_bounce_refill_done(pos, start_us, end_us);
+        }
+    }
+    example_bounce_stats_t stats;
+    example_bounce_get_stats(&stats, true);
+    TEST_ASSERT_EQUAL_UINT32(frames * (frame_px / size_px), stats.fills);
+    TEST_ASSERT_EQUAL_UINT32(size_px, stats.size_px);
+    return stats.underruns;
+}
+
+TEST_CASE("bounce buffer: refills in time are no underrun", "[bounce_buffer]")
+{
+    TEST_ASSERT_EQUAL_UINT32(0, test_bounce_run(4, -1, 0));
+    // right up to the moment the DMA reads the buffer
+    TEST_ASSERT_EQUAL_UINT32(0, test_bounce_run(4, s_config.h_res * TEST_BOUNCE_LINES * 30, -5));
+}
+
+TEST_CASE("bounce buffer: a single late refill is an underrun", "[bounce_buffer]")
+{
+    // late by far less than a bounce buffer period, in the middle of the frame
+    TEST_ASSERT_EQUAL_UINT32(1, test_bounce_run(4, s_config.h_res * TEST_BOUNCE_LINES * 30, 30));
+    // the refills after the vertical blanking
+    TEST_ASSERT_EQUAL_UINT32(1, test_bounce_run(4, 0, 30));
+    TEST_ASSERT_EQUAL_UINT32(1, test_bounce_run(4, s_config.h_res * TEST_BOUNCE_LINES, 30));
+    // and the last one of the frame
+    TEST_ASSERT_EQUAL_UINT32(1, test_bounce_run(4, s_config.h_res * (s_config.v_res - TEST_BOUNCE_LINES), 30));
+}
+
+TEST_CASE("bounce buffer: nothing is checked before a whole frame", "[bounce_buffer]")
+{
+    TEST_ASSERT_EQUAL_UINT32(0, test_bounce_run(1, s_config.h_res * TEST_BOUNCE_LINES * 30, 1000));
+}
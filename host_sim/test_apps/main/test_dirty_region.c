@@ -0,0 +1,336 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "dirty_region.h"
+// recorded by host_sim with EXAMPLE_SIM_DIRTY_TRACE, the cases replaying it are built once it's copied here
+#if __has_include("demo_dirty_trace.h")
+#include "demo_dirty_trace.h"
+#define TEST_HAVE_DEMO_TRACE 1
+#endif
+
+#define TEST_H_RES          720
+#define TEST_V_RES          720
+#define TEST_TILE_W         32  // as EXAMPLE_DIRTY_TILE_W for RGB565
+#define TEST_TILE_H         8
+#define TEST_RECT_COST_PX   4096
+#define TEST_INV_BUF_SIZE   32  // LV_INV_BUF_SIZE
+
+static example_dirty_config_t s_config;
+
+static void test_dirty_setup(int32_t h_res, int32_t v_res)
+{
+    s_config = (example_dirty_config_t) {
+        .h_res = h_res,
+        .v_res = v_res,
+        .tile_w = TEST_TILE_W,
+        .tile_h = TEST_TILE_H,
+        .rect_cost_px = TEST_RECT_COST_PX,
+    };
+    example_dirty_init(&s_config);
+}
+
+#if TEST_HAVE_DEMO_TRACE
+// the grid and the cost model the example ran the demo with
+static void test_dirty_setup_demo(void)
+{
+    s_config = (example_dirty_config_t) {
+        .h_res = DEMO_DIRTY_TRACE_H_RES,
+        .v_res = DEMO_DIRTY_TRACE_V_RES,
+        .tile_w = DEMO_DIRTY_TRACE_TILE_W,
+        .tile_h = DEMO_DIRTY_TRACE_TILE_H,
+        .rect_cost_px = DEMO_DIRTY_TRACE_RECT_COST_PX,
+    };
+    example_dirty_init(&s_config);
+}
+#endif
+
+static bool test_rect_is_in(const example_dirty_rect_t *in, const example_dirty_rect_t *out)
+{
+    return in->x1 >= out->x1 && in->y1 >= out->y1 && in->x2 <= out->x2 && in->y2 <= out->y2;
+}
+
+static void test_assert_on_grid(const example_dirty_rect_t *rect)
+{
+    const int32_t tile_w = s_config.tile_w;
+    const int32_t tile_h = s_config.tile_h;
+    TEST_ASSERT_EQUAL_INT32(0, rect->x1 % tile_w);
+    TEST_ASSERT_EQUAL_INT32(0, rect->y1 % tile_h);
+    // the right and bottom edges end a tile, or the display
+    TEST_ASSERT_TRUE((rect->x2 + 1) % tile_w == 0 || rect->x2 == s_config.h_res - 1);
+    TEST_ASSERT_TRUE((rect->y2 + 1) % tile_h == 0 || rect->y2 == s_config.v_res - 1);
+    TEST_ASSERT_LESS_THAN_INT32(s_config.h_res, rect->x2);
+    TEST_ASSERT_LESS_THAN_INT32(s_config.v_res, rect->y2);
+}
+
+static void test_assert_snapped(const example_dirty_rect_t *orig, const example_dirty_rect_t *snapped)
+{
+    TEST_ASSERT_TRUE(test_rect_is_in(orig, snapped));
+    test_assert_on_grid(snapped);
+    // grown by less than a tile on each side
+    TEST_ASSERT_LESS_THAN_INT32((int32_t)s_config.tile_w, orig->x1 - snapped->x1);
+    TEST_ASSERT_LESS_THAN_INT32((int32_t)s_config.tile_h, orig->y1 - snapped->y1);
+    TEST_ASSERT_LESS_THAN_INT32((int32_t)s_config.tile_w, snapped->x2 - orig->x2);
+    TEST_ASSERT_LESS_THAN_INT32((int32_t)s_config.tile_h, snapped->y2 - orig->y2);
+}
+
+#if TEST_HAVE_DEMO_TRACE
+static uint32_t test_rect_size(const example_dirty_rect_t *rect)
+{
+    return (uint32_t)(rect->x2 - rect->x1 + 1) * (uint32_t)(rect->y2 - rect->y1 + 1);
+}
+
+// the refresh of one trace entry on, as LVGL collects it: snapped on invalidation, areas within one already
+// collected dropped, then merged at render start
+typedef struct {
+    example_dirty_rect_t rects[TEST_INV_BUF_SIZE];
+    example_dirty_rect_t snapped[TEST_INV_BUF_SIZE];
+    uint8_t joined[TEST_INV_BUF_SIZE];
+    uint32_t count;
+} test_refresh_t;
+
+static uint32_t test_collect_refresh(uint32_t first, test_refresh_t *refresh)
+{
+    const uint32_t trace_len = sizeof(s_demo_dirty_trace) / sizeof(s_demo_dirty_trace[0]);
+    memset(refresh, 0, sizeof(*refresh));
+    uint32_t i = first;
+    for (; i < trace_len && s_demo_dirty_trace[i].refresh == s_demo_dirty_trace[first].refresh; i++) {
+        example_dirty_rect_t rect = s_demo_dirty_trace[i].area;
+        example_dirty_snap(&rect);
+        test_assert_snapped(&s_demo_dirty_trace[i].area, &rect);
+        bool contained = false;
+        for (uint32_t j = 0; j < refresh->count; j++) {
+            contained |= test_rect_is_in(&rect, &refresh->rects[j]);
+        }
+        if (!contained) {
+            TEST_ASSERT_LESS_THAN_UINT32(TEST_INV_BUF_SIZE, refresh->count);
+            refresh->rects[refresh->count] = rect;
+            refresh->snapped[refresh->count] = rect;
+            refresh->count++;
+        }
+    }
+    return i;
+}
+
+static int32_t test_last_not_joined(const uint8_t *joined, uint32_t count)
+{
+    int32_t last = -1;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!joined[i]) {
+            last = i;
+        }
+    }
+    return last;
+}
+#endif
+
+TEST_CASE("dirty region: snapped areas are on the tile grid", "[dirty_region]")
+{
+    test_dirty_setup(TEST_H_RES, TEST_V_RES);
+    const example_dirty_rect_t rects[] = {
+        {0, 0, 0, 0},
+        {31, 7, 32, 8},     // one pixel on each side of a tile corner
+        {32, 8, 63, 15},    // exactly one tile
+        {100, 200, 100, 500},
+        {5, 5, 714, 714},
+    };
+    for (uint32_t i = 0; i < sizeof(rects) / sizeof(rects[0]); i++) {
+        example_dirty_rect_t rect = rects[i];
+        example_dirty_snap(&rect);
+        test_assert_snapped(&rects[i], &rect);
+    }
+    example_dirty_rect_t tile = rects[2];
+    example_dirty_snap(&tile);
+    TEST_ASSERT_EQUAL_MEMORY(&rects[2], &tile, sizeof(tile));
+
+#if TEST_HAVE_DEMO_TRACE
+    // every area of the demo
+    test_dirty_setup_demo();
+    for (uint32_t i = 0; i < sizeof(s_demo_dirty_trace) / sizeof(s_demo_dirty_trace[0]); i++) {
+        example_dirty_rect_t rect = s_demo_dirty_trace[i].area;
+        example_dirty_snap(&rect);
+        test_assert_snapped(&s_demo_dirty_trace[i].area, &rect);
+    }
+#endif
+}
+
+TEST_CASE("dirty region: snapped areas are clipped to the display", "[dirty_region]")
+{
+    // 400 columns end half way through a tile, 854 lines 6 lines into one
+    test_dirty_setup(400, 854);
+    example_dirty_rect_t rect = {390, 850, 399, 853};
+    example_dirty_snap(&rect);
+    TEST_ASSERT_EQUAL_INT32(384, rect.x1);
+    TEST_ASSERT_EQUAL_INT32(848, rect.y1);
+    TEST_ASSERT_EQUAL_INT32(399, rect.x2);
+    TEST_ASSERT_EQUAL_INT32(853, rect.y2);
+
+    rect = (example_dirty_rect_t){370, 840, 380, 845};
+    example_dirty_snap(&rect);
+    TEST_ASSERT_EQUAL_INT32(383, rect.x2);
+    TEST_ASSERT_EQUAL_INT32(847, rect.y2);
+
+    rect = (example_dirty_rect_t){0, 0, 399, 853};
+    example_dirty_snap(&rect);
+    TEST_ASSERT_EQUAL_INT32(0, rect.x1);
+    TEST_ASSERT_EQUAL_INT32(0, rect.y1);
+    TEST_ASSERT_EQUAL_INT32(399, rect.x2);
+    TEST_ASSERT_EQUAL_INT32(853, rect.y2);
+}
+
+TEST_CASE("dirty region: merging follows the cost model", "[dirty_region]")
+{
+    test_dirty_setup(TEST_H_RES, TEST_V_RES);
+    // neighbouring tiles and overlapping areas are merged
+    example_dirty_rect_t rects[3] = {
+        {0, 0, 31, 7},
+        {32, 0, 63, 7},
+        {16, 0, 47, 15},
+    };
+    uint8_t joined[3] = {0};
+    example_dirty_merge(rects, joined, 3);
+    TEST_ASSERT_EQUAL_UINT8(1, joined[0]);
+    TEST_ASSERT_EQUAL_UINT8(1, joined[1]);
+    TEST_ASSERT_EQUAL_UINT8(0, joined[2]);
+    example_dirty_rect_t merged = {0, 0, 63, 15};
+    TEST_ASSERT_EQUAL_MEMORY(&merged, &rects[2], sizeof(merged));
+
+    // the union of two far corners costs more than a second flush
+    example_dirty_rect_t corners[2] = {
+        {0, 0, 127, 127},
+        {592, 592, 719, 719},
+    };
+    memset(joined, 0, sizeof(joined));
+    example_dirty_merge(corners, joined, 2);
+    TEST_ASSERT_EQUAL_UINT8(0, joined[0]);
+    TEST_ASSERT_EQUAL_UINT8(0, joined[1]);
+
+    // entries LVGL already joined are left alone
+    example_dirty_rect_t skipped[3] = {
+        {0, 0, 31, 7},
+        {0, 8, 31, 15},
+        {600, 600, 631, 607},
+    };
+    memset(joined, 0, sizeof(joined));
+    joined[0] = 1;
+    example_dirty_merge(skipped, joined, 3);
+    TEST_ASSERT_EQUAL_UINT8(1, joined[0]);
+    TEST_ASSERT_EQUAL_INT32(7, skipped[0].y2);
+
+    example_dirty_stats_t stats;
+    example_dirty_get_stats(&stats, true);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.passes);
+    TEST_ASSERT_EQUAL_UINT32(3 + 2 + 2, stats.rects_in);
+}
+
+#if TEST_HAVE_DEMO_TRACE
+TEST_CASE("dirty region: merging the demo keeps the last area and covers every area", "[dirty_region]")
+{
+    test_dirty_setup_demo();
+    const uint32_t trace_len = sizeof(s_demo_dirty_trace) / sizeof(s_demo_dirty_trace[0]);
+    test_refresh_t refresh;
+    for (uint32_t i = 0; i < trace_len;) {
+        i = test_collect_refresh(i, &refresh);
+        // LVGL flags the last flush of a refresh by the last area not joined, it must stay where it was
+        int32_t last_i = test_last_not_joined(refresh.joined, refresh.count);
+        example_dirty_merge(refresh.rects, refresh.joined, refresh.count);
+        TEST_ASSERT_EQUAL_INT32(last_i, test_last_not_joined(refresh.joined, refresh.count));
+
+        uint32_t cost_before = 0;
+        uint32_t cost_after = 0;
+        for (uint32_t j = 0; j < refresh.count; j++) {
+            cost_before += test_rect_size(&refresh.snapped[j]) + DEMO_DIRTY_TRACE_RECT_COST_PX;
+            if (!refresh.joined[j]) {
+                cost_after += test_rect_size(&refresh.rects[j]) + DEMO_DIRTY_TRACE_RECT_COST_PX;
+                // merged areas stay on the grid
+                test_assert_on_grid(&refresh.rects[j]);
+            }
+            // every area is rendered by one of those left
+            bool covered = false;
+            for (uint32_t k = 0; k < refresh.count; k++) {
+                covered |= !refresh.joined[k] && test_rect_is_in(&refresh.snapped[j], &refresh.rects[k]);
+            }
+            TEST_ASSERT_TRUE(covered);
+        }
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(cost_before, cost_after);
+    }
+}
+
+TEST_CASE("dirty region: demo trace benchmark", "[dirty_region]")
+{
+    test_dirty_setup_demo();
+    const uint32_t trace_len = sizeof(s_demo_dirty_trace) / sizeof(s_demo_dirty_trace[0]);
+    test_refresh_t refresh;
+    uint32_t snapped_px = 0;
+    uint32_t refreshes = 0;
+    for (uint32_t i = 0; i < trace_len; refreshes++) {
+        i = test_collect_refresh(i, &refresh);
+        for (uint32_t j = 0; j < refresh.count; j++) {
+            snapped_px += test_rect_size(&refresh.snapped[j]);
+        }
+        example_dirty_merge(refresh.rects, refresh.joined, refresh.count);
+    }
+
+    example_dirty_stats_t stats;
+    example_dirty_get_stats(&stats, true);
+    printf("demo trace: %"PRIu32" refreshes, %"PRIu32" areas merged into %"PRIu32", %"PRIu32" px invalidated, "
+           "%"PRIu32" snapped, %"PRIu32" rendered\n", refreshes, stats.rects_in, stats.rects_out, stats.invalidated_px,
+           snapped_px, stats.rendered_px);
+    TEST_ASSERT_EQUAL_UINT32(refreshes, stats.passes);
+    TEST_ASSERT_LESS_THAN_UINT32(stats.rects_in, stats.rects_out);
+    // merging trades flushes for pixels, never more than the cost of the flushes saved
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(snapped_px + (stats.rects_in - stats.rects_out) * DEMO_DIRTY_TRACE_RECT_COST_PX,
+                                     stats.rendered_px);
+}
+
+TEST_CASE("dirty region: replaying the demo merges as the example did", "[dirty_region]")
+{
+    test_dirty_setup_demo();
+    const uint32_t merges_len = sizeof(s_demo_dirty_merges) / sizeof(s_demo_dirty_merges[0]);
+    example_dirty_rect_t rects[TEST_INV_BUF_SIZE];
+    uint8_t joined[TEST_INV_BUF_SIZE];
+    // the areas the refreshes recorded render, through the snapping, which counts the invalidated pixels
+    for (uint32_t i = 0; i < sizeof(s_demo_dirty_trace) / sizeof(s_demo_dirty_trace[0]); i++) {
+        if (s_demo_dirty_trace[i].refresh < DEMO_DIRTY_TRACE_REFRESHES) {
+            example_dirty_rect_t rect = s_demo_dirty_trace[i].area;
+            example_dirty_snap(&rect);
+        }
+    }
+    uint32_t refreshes = 0;
+    // the areas of one refresh, as LVGL handed them over, then merged again
+    for (uint32_t i = 0; i < merges_len; refreshes++) {
+        uint32_t count = 0;
+        const uint32_t refresh = s_demo_dirty_merges[i].refresh;
+        for (; i < merges_len && s_demo_dirty_merges[i].refresh == refresh; i++) {
+            TEST_ASSERT_LESS_THAN_UINT32(TEST_INV_BUF_SIZE, count);
+            rects[count] = s_demo_dirty_merges[i].area;
+            joined[count] = s_demo_dirty_merges[i].joined;
+            count++;
+        }
+        example_dirty_merge(rects, joined, count);
+    }
+
+    example_dirty_stats_t stats;
+    example_dirty_get_stats(&stats, true);
+    const uint32_t permille = (uint64_t)stats.rendered_px * 1000 / stats.invalidated_px;
+    printf("demo replay: %"PRIu32" refreshes, %"PRIu32" areas merged into %"PRIu32", %"PRIu32" of %"PRIu32
+           " invalidated px rendered, %"PRIu32" per mille\n", refreshes, stats.rects_in, stats.rects_out, stats.rendered_px,
+           stats.invalidated_px, permille);
+    TEST_ASSERT_EQUAL_UINT32(DEMO_DIRTY_TRACE_REFRESHES, refreshes);
+    TEST_ASSERT_EQUAL_UINT32(DEMO_DIRTY_TRACE_REFRESHES, stats.passes);
+    TEST_ASSERT_EQUAL_UINT32(DEMO_DIRTY_TRACE_RECTS_IN, stats.rects_in);
+    // as many areas left as in the demo, and as many pixels rendered for the pixels invalidated
+    TEST_ASSERT_EQUAL_UINT32(DEMO_DIRTY_TRACE_RECTS_OUT, stats.rects_out);
+    TEST_ASSERT_LESS_THAN_UINT32(stats.rects_in, stats.rects_out);
+    TEST_ASSERT_EQUAL_UINT32(DEMO_DIRTY_TRACE_INVALIDATED_PX, stats.invalidated_px);
+    TEST_ASSERT_EQUAL_UINT32((uint64_t)DEMO_DIRTY_TRACE_RENDERED_PX * 1000 / DEMO_DIRTY_TRACE_INVALIDATED_PX, permille);
+}
+#endif
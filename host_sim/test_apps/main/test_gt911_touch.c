@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "unity.h"
+#include "lvgl.h"
+#include "i2c_sim.h"
+#include "gt911_sim.h"
+#include "lvgl_touch.h"
+#include "vernon_gt911.h"
+
+#define TEST_TOUCH_H_RES        720
+#define TEST_TOUCH_V_RES        720
+#define TEST_TOUCH_PIN_SDA      8
+#define TEST_TOUCH_PIN_SCL      18
+#define TEST_TOUCH_PIN_INT      39
+#define TEST_TOUCH_I2C_FREQ_HZ  400000
+#define TEST_TOUCH_PRIORITY     4   // above the test task, as above the LVGL task in the example
+#define TEST_TOUCH_TIMEOUT_MS   1000
+
+static Vernon_GT911 s_gt911;
+static SemaphoreHandle_t s_frame_sem;
+static uint32_t s_frames;       // frames published by the touch task
+static uint32_t s_reads;        // LVGL read callbacks
+static lv_indev_t *s_indev;
+
+static void test_touch_frame_cb(Vernon_GT911 *gt911, const GT911_snapshot *snapshot, void *user_ctx)
+{
+    s_frames++;
+    xSemaphoreGive(s_frame_sem);
+}
+
+// the read callback of the example with the INT pin
+static void example_lvgl_touch_cb(lv_indev_t *indev, lv_indev_data_t *data)
+{
+    s_reads++;
+    example_touch_read_snapshot(indev, &s_gt911, data);
+}
+
+static void test_touch_setup(void)
+{
+    if (s_indev) {
+        // the touch task runs for the rest of the tests
+        return;
+    }
+    s_frame_sem = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(s_frame_sem);
+    TEST_ESP_OK(example_gt911_sim_init(I2C_NUM_0, GT911_ADDR1, TEST_TOUCH_PIN_INT, TEST_TOUCH_H_RES, TEST_TOUCH_V_RES));
+    TEST_ESP_OK(GT911_init(&s_gt911, TEST_TOUCH_PIN_SDA, TEST_TOUCH_PIN_SCL, TEST_TOUCH_PIN_INT, -1, I2C_NUM_0,
+                           GT911_ADDR1, TEST_TOUCH_I2C_FREQ_HZ, TEST_TOUCH_H_RES, TEST_TOUCH_V_RES));
+    GT911_setRotation(&s_gt911, ROTATION_NORMAL);
+    GT911_register_frame_callback(&s_gt911, test_touch_frame_cb, NULL);
+    TEST_ESP_OK(GT911_enable_interrupt(&s_gt911, TEST_TOUCH_PRIORITY));
+
+    lv_init();
+    lv_display_t *display = lv_display_create(TEST_TOUCH_H_RES, TEST_TOUCH_V_RES);
+    TEST_ASSERT_NOT_NULL(display);
+    example_touch_init();
+    s_indev = lv_indev_create();
+    lv_indev_set_type(s_indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_display(s_indev, display);
+    lv_indev_set_read_cb(s_indev, example_lvgl_touch_cb);
+}
+
+// latch a frame in the simulated GT911, which pulses INT, and wait for the touch task to publish it
+static void test_touch_frame(const example_gt911_sim_point_t *points, uint8_t num)
+{
+    uint32_t frames = s_frames;
+    example_gt911_sim_touch(points, num);
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(s_frame_sem, pdMS_TO_TICKS(TEST_TOUCH_TIMEOUT_MS)));
+    TEST_ASSERT_EQUAL_UINT32(frames + 1, s_frames);
+}
+
+static void test_touch_assert_pointer(lv_indev_state_t state, int32_t x, int32_t y)
+{
+    uint32_t reads = s_reads;
+    lv_indev_read(s_indev);
+    TEST_ASSERT_EQUAL_UINT32(reads + 1, s_reads);
+    lv_point_t point;
+    lv_indev_get_point(s_indev, &point);
+    TEST_ASSERT_EQUAL(state, lv_indev_get_state(s_indev));
+    TEST_ASSERT_EQUAL_INT32(x, point.x);
+    TEST_ASSERT_EQUAL_INT32(y, point.y);
+}
+
+TEST_CASE("touch: INT edge to the LVGL read callback", "[gt911_touch]")
+{
+    test_touch_setup();
+    const example_gt911_sim_point_t press = {.id = 3, .x = 200, .y = 500, .size = 30};
+    int64_t before_us = esp_timer_get_time();
+    test_touch_frame(&press, 1);
+
+    // the snapshot holds the frame the touch task read on the edge
+    GT911_snapshot snapshot;
+    TEST_ASSERT_TRUE(GT911_read_snapshot(&s_gt911, &snapshot));
+    TEST_ASSERT_EQUAL_UINT8(1, snapshot.touch_num);
+    TEST_ASSERT_EQUAL_UINT8(press.id, snapshot.points_info[0].id);
+    TEST_ASSERT_EQUAL_UINT16(press.size, snapshot.points_info[0].size);
+    TEST_ASSERT_TRUE(snapshot.timestamp_us >= before_us);
+
+    test_touch_assert_pointer(LV_INDEV_STATE_PRESSED, press.x, press.y);
+    example_touch_point_t points[TOUCH_POINT_TOTAL];
+    TEST_ASSERT_EQUAL_UINT8(1, example_touch_get_points(points));
+    TEST_ASSERT_EQUAL_UINT8(press.id, points[0].id);
+
+    // lifted, LVGL keeps the last position
+    test_touch_frame(NULL, 0);
+    test_touch_assert_pointer(LV_INDEV_STATE_RELEASED, press.x, press.y);
+    TEST_ASSERT_EQUAL_UINT8(0, example_touch_get_points(points));
+}
+
+TEST_CASE("touch: one frame per INT edge, the pointer follows the oldest finger", "[gt911_touch]")
+{
+    test_touch_setup();
+    for (uint32_t step = 0; step < 8; step++) {
+        example_gt911_sim_point_t fingers[2] = {
+            {.id = 1, .x = 100 + step * 40, .y = 300, .size = 20},
+            {.id = 2, .x = 600, .y = 100 + step * 50, .size = 20},
+        };
+        // the second finger lands on the third frame
+        test_touch_frame(fingers, step < 2 ? 1 : 2);
+        test_touch_assert_pointer(LV_INDEV_STATE_PRESSED, fingers[0].x, fingers[0].y);
+        example_touch_point_t points[TOUCH_POINT_TOTAL];
+        TEST_ASSERT_EQUAL_UINT8(step < 2 ? 1 : 2, example_touch_get_points(points));
+    }
+    test_touch_frame(NULL, 0);
+    test_touch_assert_pointer(LV_INDEV_STATE_RELEASED, 100 + 7 * 40, 300);
+
+    // no edge, no I2C read: the touch task stays asleep and LVGL reads the same snapshot
+    const uint32_t frames = s_frames;
+    i2c_sim_stats_t i2c_stats;
+    i2c_sim_get_stats(I2C_NUM_0, &i2c_stats, true);
+    TEST_ASSERT_EQUAL(pdFALSE, xSemaphoreTake(s_frame_sem, pdMS_TO_TICKS(50)));
+    test_touch_assert_pointer(LV_INDEV_STATE_RELEASED, 100 + 7 * 40, 300);
+    TEST_ASSERT_EQUAL_UINT32(frames, s_frames);
+    i2c_sim_get_stats(I2C_NUM_0, &i2c_stats, false);
+    TEST_ASSERT_EQUAL_UINT32(0, i2c_stats.transactions);
+}
@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdint.h>
+#include "unity.h"
+#include "latency_trace.h"
+
+#define TEST_TRACE_RING_SIZE    512 // as in latency_trace.c
+
+static void test_trace_clear(void)
+{
+    // leave nothing in the ring for the next test
+    example_trace_process();
+    example_trace_reset();
+}
+
+// one touch travelling through every stage, each delay relative to the previous stage
+static void test_trace_chain(uint32_t touch_us, uint32_t lvgl_us, uint32_t indev_us, uint32_t flush_us, uint32_t done_us)
+{
+    uint32_t t = touch_us;
+    example_trace_record_at(EXAMPLE_TRACE_TOUCH_READ, t);
+    example_trace_record_at(EXAMPLE_TRACE_LVGL_HANDLER, t += lvgl_us);
+    example_trace_record_at(EXAMPLE_TRACE_INDEV_READ, t += indev_us);
+    example_trace_record_at(EXAMPLE_TRACE_FLUSH, t += flush_us);
+    example_trace_record_at(EXAMPLE_TRACE_FLUSH_DONE, t += done_us);
+}
+
+// percentiles are reported as the upper bound of their histogram bucket, at most 1/8 above the value
+static void test_trace_assert_percentile(uint32_t expected_us, uint32_t max_us, uint32_t reported_us)
+{
+    uint32_t upper = expected_us < 8 ? expected_us : expected_us + expected_us / 8;
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(expected_us, reported_us);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(upper < max_us ? upper : max_us, reported_us);
+}
+
+TEST_CASE("latency trace: p50, p99 and max per interval", "[latency_trace]")
+{
+    test_trace_clear();
+    // render times of 100 to 10000 us, everything else constant
+    for (uint32_t i = 1; i <= 100; i++) {
+        test_trace_chain(i * 100000, 3, 5, i * 100, 1000);
+        example_trace_process();
+    }
+
+    example_trace_stats_t stats;
+    example_trace_get_stats(EXAMPLE_TRACE_WAIT_LVGL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(100, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.p50_us);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.p99_us);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.max_us);
+
+    example_trace_get_stats(EXAMPLE_TRACE_WAIT_INDEV, &stats);
+    TEST_ASSERT_EQUAL_UINT32(5, stats.p50_us);
+    TEST_ASSERT_EQUAL_UINT32(5, stats.max_us);
+
+    example_trace_get_stats(EXAMPLE_TRACE_RENDER, &stats);
+    TEST_ASSERT_EQUAL_UINT32(100, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(10000, stats.max_us);
+    test_trace_assert_percentile(5000, stats.max_us, stats.p50_us);
+    test_trace_assert_percentile(9900, stats.max_us, stats.p99_us);
+
+    example_trace_get_stats(EXAMPLE_TRACE_FLUSH_TIME, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1000, stats.p50_us);
+    TEST_ASSERT_EQUAL_UINT32(1000, stats.p99_us);
+
+    example_trace_get_stats(EXAMPLE_TRACE_TOTAL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(3 + 5 + 10000 + 1000, stats.max_us);
+    test_trace_assert_percentile(3 + 5 + 5000 + 1000, stats.max_us, stats.p50_us);
+    test_trace_assert_percentile(3 + 5 + 9900 + 1000, stats.max_us, stats.p99_us);
+    TEST_ASSERT_EQUAL_UINT32(0, example_trace_get_dropped());
+}
+
+TEST_CASE("latency trace: touches waiting for the same frame", "[latency_trace]")
+{
+    test_trace_clear();
+    // a stage without an open chain is ignored
+    example_trace_record_at(EXAMPLE_TRACE_LVGL_HANDLER, 50);
+    // two touch frames before LVGL runs, both are answered by the same frame
+    example_trace_record_at(EXAMPLE_TRACE_TOUCH_READ, 100);
+    example_trace_record_at(EXAMPLE_TRACE_TOUCH_READ, 200);
+    example_trace_record_at(EXAMPLE_TRACE_LVGL_HANDLER, 300);
+    example_trace_record_at(EXAMPLE_TRACE_INDEV_READ, 400);
+    example_trace_record_at(EXAMPLE_TRACE_FLUSH, 500);
+    example_trace_record_at(EXAMPLE_TRACE_FLUSH_DONE, 600);
+    example_trace_process();
+
+    example_trace_stats_t stats;
+    example_trace_get_stats(EXAMPLE_TRACE_TOTAL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(500, stats.max_us);
+    example_trace_get_stats(EXAMPLE_TRACE_WAIT_LVGL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(200, stats.max_us);
+    example_trace_get_stats(EXAMPLE_TRACE_FLUSH_TIME, &stats);
+    TEST_ASSERT_EQUAL_UINT32(100, stats.max_us);
+}
+
+TEST_CASE("latency trace: stale stages and timestamp wrap-around", "[latency_trace]")
+{
+    test_trace_clear();
+    // a stage older than the touch belongs to an earlier frame, it does not advance the chain
+    example_trace_record_at(EXAMPLE_TRACE_TOUCH_READ, 1000);
+    example_trace_record_at(EXAMPLE_TRACE_LVGL_HANDLER, 900);
+    test_trace_chain(1100, 0, 20, 30, 40);
+    example_trace_process();
+
+    example_trace_stats_t stats;
+    example_trace_get_stats(EXAMPLE_TRACE_WAIT_LVGL, &stats);
+    // the first touch completes with the second one's stages: 1000 -> 1100
+    TEST_ASSERT_EQUAL_UINT32(2, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(100, stats.max_us);
+
+    test_trace_clear();
+    // the 32-bit microsecond clock wraps every 71 minutes
+    test_trace_chain(UINT32_MAX - 100, 50, 50, 50, 50);
+    example_trace_process();
+    example_trace_get_stats(EXAMPLE_TRACE_TOTAL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(200, stats.max_us);
+}
+
+TEST_CASE("latency trace: dump only formats, overflow is counted", "[latency_trace]")
+{
+    test_trace_clear();
+    test_trace_chain(0, 10, 10, 10, 10);
+    // the trace points are only drained by example_trace_process(), from a single task
+    example_trace_dump();
+    example_trace_stats_t stats;
+    example_trace_get_stats(EXAMPLE_TRACE_TOTAL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.count);
+    example_trace_process();
+    example_trace_get_stats(EXAMPLE_TRACE_TOTAL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.count);
+
+    // the ring wraps when it's not drained in time, the oldest points are lost
+    for (uint32_t i = 0; i < TEST_TRACE_RING_SIZE + 37; i++) {
+        example_trace_record_at(EXAMPLE_TRACE_LVGL_HANDLER, i);
+    }
+    example_trace_process();
+    TEST_ASSERT_EQUAL_UINT32(37, example_trace_get_dropped());
+}
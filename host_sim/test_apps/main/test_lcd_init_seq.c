@@ -0,0 +1,206 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_lcd_panel_io.h"
+#include "esp_lcd_sim.h"
+#include "lcd_init_seq.h"
+#include "lcd_panel_registry.h"
+#include "esp_lcd_nv3052c.h"
+#include "lcd_h040a18.h"
+#include "lcd_h035a17.h"
+
+#define TEST_IO_MAX_RECORDS     256
+#define TEST_IO_MAX_PARAM_BYTES 2048
+#define TEST_IO_SCL_HZ          (1 * 1000 * 1000)
+#define TEST_STATS_UNTOUCHED    0xA5
+
+// the panels whose driver sends a vendor table
+static const lcd_panel_desc_t *const s_descs[] = {
+    &nv3052_panel_desc,
+    &h040a18_panel_desc,
+    &h035a17_panel_desc,
+};
+
+static esp_lcd_panel_io_handle_t test_io_new(void)
+{
+    esp_lcd_sim_panel_io_config_t config = {
+        .max_records = TEST_IO_MAX_RECORDS,
+        .max_param_bytes = TEST_IO_MAX_PARAM_BYTES,
+        .scl_hz = TEST_IO_SCL_HZ,
+    };
+    esp_lcd_panel_io_handle_t io = NULL;
+    TEST_ESP_OK(esp_lcd_sim_new_panel_io_3wire(&config, &io));
+    return io;
+}
+
+// what sending the first `count` entries of a packed table must produce, the duration aside
+static size_t test_seq_expect(const uint8_t *seq, size_t size, size_t count, lcd_init_seq_stats_t *expect)
+{
+    memset(expect, 0, sizeof(*expect));
+    size_t offset = 0;
+    while (offset < size && expect->cmds < count) {
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(size, offset + 3 + seq[offset + 1]);
+        expect->cmds++;
+        expect->bytes += 1 + seq[offset + 1];
+        if (seq[offset + 2]) {
+            expect->delays++;
+            expect->delay_ms += seq[offset + 2];
+        }
+        offset += 3 + seq[offset + 1];
+    }
+    return expect->cmds;
+}
+
+// the IO saw exactly the first `count` entries of the table, parameters and delays included
+static void test_seq_assert_records(esp_lcd_panel_io_handle_t io, const uint8_t *seq, size_t count, const char *name)
+{
+    const esp_lcd_sim_io_record_t *records;
+    const uint8_t *params;
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(count, esp_lcd_sim_panel_io_get_records(io, &records, &params), name);
+    size_t offset = 0;
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t len = seq[offset + 1];
+        const uint8_t delay_ms = seq[offset + 2];
+        TEST_ASSERT_EQUAL_INT_MESSAGE(seq[offset], records[i].cmd, name);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(len, records[i].param_size, name);
+        if (len) {
+            TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(&seq[offset + 3], params + records[i].param_offset, len, name);
+        }
+        // the panel is left alone for at least as long as the entry asks
+        if (delay_ms && i + 1 < count) {
+            TEST_ASSERT_GREATER_OR_EQUAL_INT32_MESSAGE(delay_ms * 1000, (int32_t)(records[i + 1].time_us - records[i].time_us), name);
+        }
+        offset += 3 + len;
+    }
+}
+
+static void test_seq_assert_stats(const lcd_init_seq_stats_t *expect, const lcd_init_seq_stats_t *stats, const char *name)
+{
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(expect->cmds, stats->cmds, name);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(expect->bytes, stats->bytes, name);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(expect->delays, stats->delays, name);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(expect->delay_ms, stats->delay_ms, name);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32_MESSAGE(expect->delay_ms * 1000, stats->duration_us, name);
+}
+
+// the same table as entries, pointing into it
+static lcd_init_seq_cmd_t *test_seq_unpack(const uint8_t *seq, size_t size, size_t *count)
+{
+    lcd_init_seq_stats_t expect;
+    *count = test_seq_expect(seq, size, SIZE_MAX, &expect);
+    lcd_init_seq_cmd_t *cmds = calloc(*count, sizeof(lcd_init_seq_cmd_t));
+    TEST_ASSERT_NOT_NULL(cmds);
+    size_t offset = 0;
+    for (size_t i = 0; i < *count; i++) {
+        cmds[i] = (lcd_init_seq_cmd_t) {
+            .cmd = seq[offset],
+            .data = seq[offset + 1] ? &seq[offset + 3] : NULL,
+            .data_bytes = seq[offset + 1],
+            .delay_ms = seq[offset + 2],
+        };
+        offset += 3 + seq[offset + 1];
+    }
+    return cmds;
+}
+
+TEST_CASE("init seq: vendor tables go out as written", "[lcd_init_seq]")
+{
+    for (size_t p = 0; p < sizeof(s_descs) / sizeof(s_descs[0]); p++) {
+        const lcd_panel_desc_t *desc = s_descs[p];
+        TEST_ASSERT_NOT_NULL_MESSAGE(desc->init_seq, desc->name);
+        lcd_init_seq_stats_t expect;
+        size_t count = test_seq_expect(desc->init_seq, desc->init_seq_size, SIZE_MAX, &expect);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(TEST_IO_MAX_RECORDS, count);
+
+        esp_lcd_panel_io_handle_t io = test_io_new();
+        lcd_init_seq_stats_t stats;
+        TEST_ESP_OK(lcd_init_seq_send_packed(io, desc->init_seq, desc->init_seq_size, &stats));
+        test_seq_assert_records(io, desc->init_seq, count, desc->name);
+        test_seq_assert_stats(&expect, &stats, desc->name);
+
+        esp_lcd_sim_panel_io_stats_t io_stats;
+        esp_lcd_sim_panel_io_get_stats(io, &io_stats, false);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(count, io_stats.cmds, desc->name);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(expect.bytes - count, io_stats.param_bytes, desc->name);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, io_stats.dropped, desc->name);
+        TEST_ESP_OK(esp_lcd_panel_io_del(io));
+    }
+}
+
+TEST_CASE("init seq: entries go out like the packed table", "[lcd_init_seq]")
+{
+    const lcd_panel_desc_t *desc = &h040a18_panel_desc;
+    size_t count;
+    lcd_init_seq_cmd_t *cmds = test_seq_unpack(desc->init_seq, desc->init_seq_size, &count);
+    lcd_init_seq_stats_t expect;
+    test_seq_expect(desc->init_seq, desc->init_seq_size, SIZE_MAX, &expect);
+
+    esp_lcd_panel_io_handle_t io = test_io_new();
+    lcd_init_seq_stats_t stats;
+    TEST_ESP_OK(lcd_init_seq_send(io, cmds, count, &stats));
+    test_seq_assert_records(io, desc->init_seq, count, desc->name);
+    test_seq_assert_stats(&expect, &stats, desc->name);
+    TEST_ESP_OK(esp_lcd_panel_io_del(io));
+    free(cmds);
+}
+
+TEST_CASE("init seq: sending stops at the first failing command", "[lcd_init_seq]")
+{
+    for (size_t p = 0; p < sizeof(s_descs) / sizeof(s_descs[0]); p++) {
+        const lcd_panel_desc_t *desc = s_descs[p];
+        lcd_init_seq_stats_t expect;
+        size_t count = test_seq_expect(desc->init_seq, desc->init_seq_size, SIZE_MAX, &expect);
+        // the first command, one in the middle and the last one
+        const size_t fail_at[] = {0, count / 2, count - 1};
+        for (size_t f = 0; f < sizeof(fail_at) / sizeof(fail_at[0]); f++) {
+            esp_lcd_panel_io_handle_t io = test_io_new();
+            esp_lcd_sim_panel_io_fail_at(io, fail_at[f], ESP_ERR_TIMEOUT);
+            lcd_init_seq_stats_t stats;
+            memset(&stats, TEST_STATS_UNTOUCHED, sizeof(stats));
+            TEST_ASSERT_EQUAL_MESSAGE(ESP_ERR_TIMEOUT, lcd_init_seq_send_packed(io, desc->init_seq, desc->init_seq_size, &stats),
+                                      desc->name);
+            // nothing after the failing command, and no stats for a sequence that wasn't sent
+            test_seq_assert_records(io, desc->init_seq, fail_at[f], desc->name);
+            TEST_ASSERT_EACH_EQUAL_HEX8_MESSAGE(TEST_STATS_UNTOUCHED, &stats, sizeof(stats), desc->name);
+            TEST_ESP_OK(esp_lcd_panel_io_del(io));
+        }
+    }
+
+    // same with entries
+    const lcd_panel_desc_t *desc = &h035a17_panel_desc;
+    size_t count;
+    lcd_init_seq_cmd_t *cmds = test_seq_unpack(desc->init_seq, desc->init_seq_size, &count);
+    esp_lcd_panel_io_handle_t io = test_io_new();
+    esp_lcd_sim_panel_io_fail_at(io, count / 3, ESP_FAIL);
+    TEST_ASSERT_EQUAL(ESP_FAIL, lcd_init_seq_send(io, cmds, count, NULL));
+    test_seq_assert_records(io, desc->init_seq, count / 3, desc->name);
+    TEST_ESP_OK(esp_lcd_panel_io_del(io));
+    free(cmds);
+}
+
+TEST_CASE("init seq: a table cut short sends nothing", "[lcd_init_seq]")
+{
+    static const uint8_t seq[] = {
+        LCD_INIT_SEQ_CMD(0x11, 0),
+        LCD_INIT_SEQ_CMD(0x3A, 0, 0x55),
+        LCD_INIT_SEQ_CMD(0xB0, 0, 0x01, 0x02, 0x03),
+    };
+    esp_lcd_panel_io_handle_t io = test_io_new();
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, lcd_init_seq_send_packed(io, seq, sizeof(seq) - 1, NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, lcd_init_seq_send_packed(io, seq, 2, NULL));
+    const esp_lcd_sim_io_record_t *records;
+    const uint8_t *params;
+    TEST_ASSERT_EQUAL_UINT32(0, esp_lcd_sim_panel_io_get_records(io, &records, &params));
+
+    // whole, it goes out
+    TEST_ESP_OK(lcd_init_seq_send_packed(io, seq, sizeof(seq), NULL));
+    test_seq_assert_records(io, seq, 3, "cut short");
+    TEST_ESP_OK(esp_lcd_panel_io_del(io));
+}
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "palette.h"
+
+#define TEST_PALETTE_MAX_PX     67
+#define TEST_PALETTE_GUARD      4   // bytes after the expanded pixels, which must be left alone
+
+// the colors of lvgl_demo_ui.c, LVGL isn't linked into the tests
+static const uint32_t s_ui_colors[] = {
+    0x000000, 0x15171A, 0x282B30, 0x2F3237, 0x9E9E9E, 0xFAFAFA,
+    0xF44336, 0x2196F3, 0x4CAF50,
+};
+#define TEST_UI_NUM_COLORS  (sizeof(s_ui_colors) / sizeof(s_ui_colors[0]))
+#define TEST_PALETTE_USED   (TEST_UI_NUM_COLORS + EXAMPLE_PALETTE_CUBE_LEVELS * EXAMPLE_PALETTE_CUBE_LEVELS * EXAMPLE_PALETTE_CUBE_LEVELS)
+
+static uint32_t s_seed;
+
+static uint32_t test_rand(uint32_t range)
+{
+    s_seed = s_seed * 1103515245 + 12345;
+    return (s_seed >> 8) % range;
+}
+
+// entry `i` of the palette as 0xRRGGBB, as the header describes it: the UI colors, then the color cube
+static uint32_t test_palette_rgb(uint32_t i)
+{
+    if (i < TEST_UI_NUM_COLORS) {
+        return s_ui_colors[i];
+    }
+    const uint32_t step = 255 / (EXAMPLE_PALETTE_CUBE_LEVELS - 1);
+    i -= TEST_UI_NUM_COLORS;
+    uint32_t r = i / (EXAMPLE_PALETTE_CUBE_LEVELS * EXAMPLE_PALETTE_CUBE_LEVELS);
+    uint32_t g = i / EXAMPLE_PALETTE_CUBE_LEVELS % EXAMPLE_PALETTE_CUBE_LEVELS;
+    uint32_t b = i % EXAMPLE_PALETTE_CUBE_LEVELS;
+    return (r * step) << 16 | (g * step) << 8 | (b * step);
+}
+
+// a pixel of color `rgb` as LVGL renders it, little endian RGB565 or B, G, R
+static void test_put_px(uint8_t *dst, uint32_t rgb, uint32_t pixel_size)
+{
+    if (pixel_size == 2) {
+        uint16_t c = ((rgb >> 8) & 0xF800) | ((rgb >> 5) & 0x07E0) | ((rgb >> 3) & 0x001F);
+        dst[0] = c & 0xFF;
+        dst[1] = c >> 8;
+    } else {
+        dst[0] = rgb & 0xFF;
+        dst[1] = (rgb >> 8) & 0xFF;
+        dst[2] = rgb >> 16;
+    }
+}
+
+TEST_CASE("palette: the colors of the UI round-trip exactly", "[palette]")
+{
+    for (uint32_t pixel_size = 2; pixel_size <= 3; pixel_size++) {
+        TEST_ESP_OK(example_palette_init(s_ui_colors, TEST_UI_NUM_COLORS, pixel_size));
+        // odd widths, the source and destination at any alignment
+        for (uint32_t w = 1; w <= TEST_PALETTE_MAX_PX; w += 2) {
+            uint8_t src[TEST_PALETTE_MAX_PX * 3 + 3];
+            uint8_t idx[TEST_PALETTE_MAX_PX + 3];
+            uint8_t out[TEST_PALETTE_MAX_PX * 3 + 3];
+            const uint32_t off = w % 4;
+            for (uint32_t x = 0; x < w; x++) {
+                test_put_px(src + off + x * pixel_size, s_ui_colors[x % TEST_UI_NUM_COLORS], pixel_size);
+            }
+            example_palette_quantize(idx + off, w, src + off, w * pixel_size, w, 1);
+            for (uint32_t x = 0; x < w; x++) {
+                TEST_ASSERT_EQUAL_UINT8(x % TEST_UI_NUM_COLORS, idx[off + x]);
+            }
+            example_palette_expand(out + (3 - off), idx + off, w);
+            char msg[64];
+            snprintf(msg, sizeof(msg), "pixel size %lu, width %lu", (unsigned long)pixel_size, (unsigned long)w);
+            TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(src + off, out + (3 - off), w * pixel_size, msg);
+        }
+    }
+}
+
+TEST_CASE("palette: expansion matches a scalar loop", "[palette]")
+{
+    for (uint32_t round = 0; round < 200; round++) {
+        s_seed = round + 1;
+        const uint32_t pixel_size = round & 1 ? 3 : 2;
+        TEST_ESP_OK(example_palette_init(s_ui_colors, TEST_UI_NUM_COLORS, pixel_size));
+        const uint32_t num_px = 1 + test_rand(TEST_PALETTE_MAX_PX);
+        const uint32_t src_off = test_rand(4);
+        const uint32_t dst_off = test_rand(4);
+        uint8_t src[TEST_PALETTE_MAX_PX + 4];
+        uint8_t out[TEST_PALETTE_MAX_PX * 3 + 4 + TEST_PALETTE_GUARD];
+        uint8_t ref[sizeof(out)];
+        for (uint32_t i = 0; i < sizeof(src); i++) {
+            src[i] = test_rand(TEST_PALETTE_USED);
+        }
+        for (uint32_t i = 0; i < sizeof(out); i++) {
+            out[i] = ref[i] = test_rand(256);
+        }
+        for (uint32_t x = 0; x < num_px; x++) {
+            test_put_px(ref + dst_off + x * pixel_size, test_palette_rgb(src[src_off + x]), pixel_size);
+        }
+        example_palette_expand(out + dst_off, src + src_off, num_px);
+        char msg[64];
+        snprintf(msg, sizeof(msg), "round %lu: %lu px, src +%lu, dst +%lu", (unsigned long)round,
+                 (unsigned long)num_px, (unsigned long)src_off, (unsigned long)dst_off);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(ref, out, sizeof(out), msg);
+    }
+}
+
+TEST_CASE("palette: too many colors or an unsupported pixel size are rejected", "[palette]")
+{
+    uint32_t colors[EXAMPLE_PALETTE_MAX_COLORS + 1];
+    for (uint32_t i = 0; i <= EXAMPLE_PALETTE_MAX_COLORS; i++) {
+        // one per RGB444 cell, so none of them shadows another
+        colors[i] = (i & 0xF) << 20 | (i >> 4) << 12;
+    }
+    TEST_ESP_OK(example_palette_init(colors, EXAMPLE_PALETTE_MAX_COLORS, 2));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, example_palette_init(colors, EXAMPLE_PALETTE_MAX_COLORS + 1, 2));
+    TEST_ESP_ERR(ESP_ERR_INVALID_ARG, example_palette_init(s_ui_colors, TEST_UI_NUM_COLORS, 4));
+}
@@ -0,0 +1,227 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <string.h>
+#include "async_flush.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+#else
+#define IRAM_ATTR
+#endif
+
+// the linux target has neither GDMA nor cache, the copy engine is given by the caller there
+#if defined(ESP_PLATFORM) && !CONFIG_IDF_TARGET_LINUX
+#define FLUSH_HAVE_GDMA 1
+#include "freertos/FreeRTOS.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_cache.h"
+#include "esp_heap_caps.h"
+#include "esp_async_memcpy.h"
+static const char *TAG = "async_flush";
+static portMUX_TYPE s_flush_lock = portMUX_INITIALIZER_UNLOCKED;
+// taken from the task and from the DMA ISR, the ISR variant works in both contexts
+#define FLUSH_LOCK()    portENTER_CRITICAL_SAFE(&s_flush_lock)
+#define FLUSH_UNLOCK()  portEXIT_CRITICAL_SAFE(&s_flush_lock)
+#else
+#define FLUSH_HAVE_GDMA 0
+#define FLUSH_LOCK()
+#define FLUSH_UNLOCK()
+#endif
+
+#define FLUSH_GDMA_BACKLOG      8
+#define FLUSH_GDMA_MIN_BYTES    64  // below this the descriptor setup costs more than the CPU copy
+
+typedef struct {
+    example_async_flush_ops_t ops;
+    example_async_flush_done_cb_t done_cb;
+    void *user_ctx;
+    // rectangle in flight
+    uint8_t *dst;
+    const uint8_t *src;
+    uint32_t dst_stride;
+    uint32_t src_stride;
+    uint32_t width_bytes;
+    uint32_t h;
+    uint32_t next_line;     // next line to hand to the DMA
+    uint32_t inflight;      // copies started and not completed yet
+    bool submitting;        // set while `example_async_flush_start()` queues, the ISR must not report done meanwhile
+} async_flush_t;
+
+static async_flush_t s_flush;
+
+static inline uintptr_t flush_align_up(uintptr_t v, uint32_t align)
+{
+    return (v + align - 1) & ~(uintptr_t)(align - 1);
+}
+
+static inline uintptr_t flush_align_down(uintptr_t v, uint32_t align)
+{
+    return v & ~(uintptr_t)(align - 1);
+}
+
+// part of a line the DMA can copy: destination aligned start and size, source aligned start
+static bool IRAM_ATTR flush_line_dma_part(uint32_t line, uint32_t *head, uint32_t *size)
+{
+    uintptr_t dst = (uintptr_t)(s_flush.dst + line * s_flush.dst_stride);
+    uintptr_t start = flush_align_up(dst, s_flush.ops.dst_align);
+    uintptr_t end = flush_align_down(dst + s_flush.width_bytes, s_flush.ops.dst_align);
+    if (end <= start || end - start < s_flush.ops.min_dma_bytes) {
+        return false;
+    }
+    *head = start - dst;
+    *size = end - start;
+    const uint8_t *src = s_flush.src + line * s_flush.src_stride + *head;
+    return ((uintptr_t)src & (s_flush.ops.src_align - 1)) == 0;
+}
+
+// hand lines to the DMA until it's full or all are queued, must hold the lock
+static void IRAM_ATTR flush_submit(void)
+{
+    while (s_flush.next_line < s_flush.h) {
+        uint32_t head, size;
+        if (!flush_line_dma_part(s_flush.next_line, &head, &size)) {
+            // done by the CPU in example_async_flush_start()
+            s_flush.next_line++;
+            continue;
+        }
+        uint32_t line = s_flush.next_line++;
+        uint8_t *dst = s_flush.dst + line * s_flush.dst_stride + head;
+        const uint8_t *src = s_flush.src + line * s_flush.src_stride + head;
+        // count it first, the completion can come before dma_copy() returns
+        s_flush.inflight++;
+        if (!s_flush.ops.dma_copy(dst, src, size, s_flush.ops.ctx)) {
+            s_flush.inflight--;
+            if (s_flush.inflight == 0) {
+                // nothing in flight that would retry from its completion, copy it here
+                memcpy(dst, src, size);
+                if (s_flush.ops.sync_cache) {
+                    s_flush.ops.sync_cache(dst, size, true, s_flush.ops.ctx);
+                }
+                continue;
+            }
+            // retried from the next completion
+            s_flush.next_line = line;
+            return;
+        }
+    }
+}
+
+void example_async_flush_init(const example_async_flush_ops_t *ops, example_async_flush_done_cb_t done_cb, void *user_ctx)
+{
+    memset(&s_flush, 0, sizeof(s_flush));
+    s_flush.ops = *ops;
+    s_flush.done_cb = done_cb;
+    s_flush.user_ctx = user_ctx;
+}
+
+void example_async_flush_start(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                               uint32_t width_bytes, uint32_t h)
+{
+    if (dst_stride == width_bytes && src_stride == width_bytes) {
+        // contiguous rectangle, one long line
+        width_bytes *= h;
+        dst_stride = src_stride = width_bytes;
+        h = 1;
+    }
+    s_flush.dst = dst;
+    s_flush.src = src;
+    s_flush.dst_stride = dst_stride;
+    s_flush.src_stride = src_stride;
+    s_flush.width_bytes = width_bytes;
+    s_flush.h = h;
+    s_flush.next_line = 0;
+    s_flush.inflight = 0;
+
+    // The CPU parts share no cache line with the DMA parts, but a line written by the DMA in an earlier flush
+    // may still sit in the cache with stale data. Drop the lines before the CPU writes into them, so the
+    // write back afterwards can't overwrite what the DMA put there.
+    uintptr_t sync_start = flush_align_down((uintptr_t)dst, s_flush.ops.dst_align);
+    uintptr_t sync_end = flush_align_up((uintptr_t)dst + (h - 1) * dst_stride + width_bytes, s_flush.ops.dst_align);
+    if (s_flush.ops.sync_cache) {
+        s_flush.ops.sync_cache((void *)sync_start, sync_end - sync_start, false, s_flush.ops.ctx);
+    }
+    bool cpu_wrote = false;
+    for (uint32_t line = 0; line < h; line++) {
+        uint8_t *d = dst + line * dst_stride;
+        const uint8_t *s = src + line * src_stride;
+        uint32_t head, size;
+        if (flush_line_dma_part(line, &head, &size)) {
+            memcpy(d, s, head);
+            memcpy(d + head + size, s + head + size, width_bytes - head - size);
+            cpu_wrote |= head || width_bytes - head - size;
+        } else {
+            memcpy(d, s, width_bytes);
+            cpu_wrote = true;
+        }
+    }
+    if (cpu_wrote && s_flush.ops.sync_cache) {
+        s_flush.ops.sync_cache((void *)sync_start, sync_end - sync_start, true, s_flush.ops.ctx);
+    }
+
+    FLUSH_LOCK();
+    s_flush.submitting = true;
+    flush_submit();
+    s_flush.submitting = false;
+    bool done = s_flush.next_line == s_flush.h && s_flush.inflight == 0;
+    FLUSH_UNLOCK();
+    if (done) {
+        // nothing left for the DMA, or it was quicker than the submission
+        s_flush.done_cb(s_flush.user_ctx);
+    }
+}
+
+bool IRAM_ATTR example_async_flush_dma_done(void)
+{
+    FLUSH_LOCK();
+    s_flush.inflight--;
+    flush_submit();
+    // while submitting, example_async_flush_start() checks for completion itself
+    bool done = !s_flush.submitting && s_flush.next_line == s_flush.h && s_flush.inflight == 0;
+    FLUSH_UNLOCK();
+    return done ? s_flush.done_cb(s_flush.user_ctx) : false;
+}
+
+#if FLUSH_HAVE_GDMA
+static async_memcpy_handle_t s_mcp;
+
+static bool IRAM_ATTR flush_gdma_done(async_memcpy_handle_t mcp, async_memcpy_event_t *event, void *cb_args)
+{
+    return example_async_flush_dma_done();
+}
+
+static bool IRAM_ATTR flush_gdma_copy(void *dst, const void *src, size_t size, void *ctx)
+{
+    return esp_async_memcpy(s_mcp, dst, (void *)src, size, flush_gdma_done, NULL) == ESP_OK;
+}
+
+static void flush_sync_cache(void *addr, size_t size, bool writeback, void *ctx)
+{
+    esp_cache_msync(addr, size, writeback ? ESP_CACHE_MSYNC_FLAG_DIR_C2M : ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+}
+
+esp_err_t example_async_flush_install_gdma(example_async_flush_done_cb_t done_cb, void *user_ctx)
+{
+    async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    config.backlog = FLUSH_GDMA_BACKLOG;
+    ESP_RETURN_ON_ERROR(esp_async_memcpy_install(&config, &s_mcp), TAG, "install async memcpy failed");
+
+    size_t cache_line = 0;
+    ESP_RETURN_ON_ERROR(esp_cache_get_alignment(MALLOC_CAP_SPIRAM, &cache_line), TAG, "get cache alignment failed");
+    example_async_flush_ops_t ops = {
+        // PSRAM destinations need whole cache lines, and the GDMA moves them in bursts of 16 bytes at least
+        .dst_align = cache_line > 16 ? cache_line : 16,
+        .src_align = 4,
+        .min_dma_bytes = FLUSH_GDMA_MIN_BYTES,
+        .dma_copy = flush_gdma_copy,
+        .sync_cache = flush_sync_cache,
+    };
+    example_async_flush_init(&ops, done_cb, user_ctx);
+    ESP_LOGI(TAG, "GDMA flush, %u byte aligned, backlog %d", (unsigned)ops.dst_align, FLUSH_GDMA_BACKLOG);
+    return ESP_OK;
+}
+#endif
@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#include "esp_err.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Called once the whole rectangle is copied, from the DMA completion ISR or from `example_async_flush_start()`.
+ *
+ * @return true if a higher priority task was woken up
+ */
+typedef bool (*example_async_flush_done_cb_t)(void *user_ctx);
+
+/**
+ * @brief Copy engine used by the scheduler.
+ */
+typedef struct {
+    uint32_t dst_align;     /*!< Address and size alignment the DMA needs on the destination, also the cache line size */
+    uint32_t src_align;     /*!< Address alignment the DMA needs on the source */
+    uint32_t min_dma_bytes; /*!< Shorter lines are cheaper to copy with the CPU */
+    /**
+     * Start one copy, its completion must be reported with `example_async_flush_dma_done()`.
+     * Return false if the engine can't take more copies right now.
+     */
+    bool (*dma_copy)(void *dst, const void *src, size_t size, void *ctx);
+    /**
+     * Write back (`writeback` true) or invalidate the CPU cache of a destination range, NULL if the destination is not cached.
+     */
+    void (*sync_cache)(void *addr, size_t size, bool writeback, void *ctx);
+    void *ctx;
+} example_async_flush_ops_t;
+
+/**
+ * @brief Set the copy engine and the completion callback.
+ */
+void example_async_flush_init(const example_async_flush_ops_t *ops, example_async_flush_done_cb_t done_cb, void *user_ctx);
+
+#if defined(ESP_PLATFORM) && !CONFIG_IDF_TARGET_LINUX
+/**
+ * @brief Use the async memcpy driver (GDMA) as copy engine, destination in PSRAM.
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - Others: Async memcpy driver could not be installed
+ */
+esp_err_t example_async_flush_install_gdma(example_async_flush_done_cb_t done_cb, void *user_ctx);
+#endif
+
+/**
+ * @brief Copy a rectangle of `width_bytes` x `h`, strides in bytes.
+ *
+ * The aligned middle of every line is queued to the DMA, the unaligned head and tail are copied by the CPU
+ * right away, as are lines too short or too misaligned for the DMA. The done callback fires once the DMA is
+ * through, the source must not change until then. Only one rectangle may be in flight.
+ */
+void example_async_flush_start(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                               uint32_t width_bytes, uint32_t h);
+
+/**
+ * @brief Report the completion of one copy started by `dma_copy` (ISR context).
+ *
+ * @return true if a higher priority task was woken up
+ */
+bool example_async_flush_dma_done(void);
+
+#ifdef __cplusplus
+}
+#endif
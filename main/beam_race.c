@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <math.h>
+#include <stdatomic.h>
+#include <string.h>
+#include "beam_race.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+#else
+#define IRAM_ATTR
+#endif
+
+#define BEAM_INITIAL_NS_PER_BYTE    25.0f   // CPU copy into PSRAM, until the first writes are measured
+#define BEAM_ESTIMATE_WEIGHT        0.125f  // share of a new measurement in the write speed estimate
+
+static struct {
+    example_beam_config_t config;
+    float line_us;
+    float ns_per_byte;          // LVGL task only
+    atomic_uint vsync_us;       // low 32 bits of the last VSYNC time, written from the ISR
+    atomic_bool synced;
+    // statistics
+    atomic_uint writes;
+    atomic_uint deferred;
+    atomic_uint unavoidable;
+    atomic_uint wait_max_us;
+} s_beam;
+
+void example_beam_init(const example_beam_config_t *config)
+{
+    memset(&s_beam, 0, sizeof(s_beam));
+    s_beam.config = *config;
+    s_beam.line_us = (float)config->h_total * 1e6f / config->pclk_hz;
+    s_beam.ns_per_byte = BEAM_INITIAL_NS_PER_BYTE;
+}
+
+void IRAM_ATTR example_beam_on_vsync(int64_t now_us)
+{
+    atomic_store_explicit(&s_beam.vsync_us, (uint32_t)now_us, memory_order_relaxed);
+    atomic_store_explicit(&s_beam.synced, true, memory_order_release);
+}
+
+float example_beam_line(int64_t now_us)
+{
+    if (!atomic_load_explicit(&s_beam.synced, memory_order_acquire)) {
+        return -1;
+    }
+    // 32-bit wrap-around is harmless, VSYNCs are a few ms apart
+    uint32_t since_vsync_us = (uint32_t)now_us - atomic_load_explicit(&s_beam.vsync_us, memory_order_relaxed);
+    float line = since_vsync_us / s_beam.line_us - s_beam.config.vsync_to_active_lines;
+    line = fmodf(line, s_beam.config.v_total);
+    return line < 0 ? line + s_beam.config.v_total : line;
+}
+
+// lines until the scan-out reaches [lo, hi], both may lie beyond one frame
+static float beam_lines_until(float line, float lo, float hi, float v_total)
+{
+    // the occurrence of `line` at or after `lo`
+    float at = line + ceilf((lo - line) / v_total) * v_total;
+    if (at - v_total >= lo) {
+        at -= v_total;
+    }
+    return at <= hi ? 0 : lo + v_total - at;
+}
+
+uint32_t example_beam_schedule(int32_t y1, int32_t y2, uint32_t bytes, bool top_down, int64_t now_us)
+{
+    atomic_fetch_add_explicit(&s_beam.writes, 1, memory_order_relaxed);
+    float line = example_beam_line(now_us);
+    if (line < 0) {
+        return 0;
+    }
+    const float v_total = s_beam.config.v_total;
+    const float margin = s_beam.config.margin_lines;
+    float lines = y2 - y1 + 1;
+    float write_lines = bytes * s_beam.ns_per_byte / 1000.0f / s_beam.line_us; // write time, in scanned lines
+    float wait = INFINITY;
+
+    // 1. the whole write fits while the scan-out is away: start after it leaves y2 and finish before it's back at y1
+    float lo = y2 + 1 + margin;
+    float hi = y1 + v_total - margin - write_lines;
+    if (top_down && write_lines < lines) {
+        // faster than the scan-out, it can't catch up with the write once behind it
+        hi = y1 + v_total - margin;
+    }
+    if (hi >= lo) {
+        wait = beam_lines_until(line, lo, hi, v_total);
+    }
+
+    // 2. slower than the scan-out: follow it down through the lines, every line is written after being scanned out,
+    //    and before the next frame scans it again
+    if (top_down && write_lines >= lines) {
+        lo = y1 + margin;
+        hi = fminf(y2, fminf(y1 + v_total - margin - write_lines / lines, y2 + v_total - margin - write_lines));
+        if (hi >= lo) {
+            wait = fminf(wait, beam_lines_until(line, lo, hi, v_total));
+        }
+    }
+
+    if (isinf(wait)) {
+        atomic_fetch_add_explicit(&s_beam.unavoidable, 1, memory_order_relaxed);
+        return 0;
+    }
+    uint32_t wait_us = (uint32_t)ceilf(wait * s_beam.line_us);
+    if (wait_us) {
+        atomic_fetch_add_explicit(&s_beam.deferred, 1, memory_order_relaxed);
+        unsigned max = atomic_load_explicit(&s_beam.wait_max_us, memory_order_relaxed);
+        if (wait_us > max) {
+            atomic_store_explicit(&s_beam.wait_max_us, wait_us, memory_order_relaxed);
+        }
+    }
+    return wait_us;
+}
+
+void example_beam_write_done(uint32_t bytes, uint32_t us)
+{
+    if (bytes == 0) {
+        return;
+    }
+    float ns_per_byte = us * 1000.0f / bytes;
+    s_beam.ns_per_byte += (ns_per_byte - s_beam.ns_per_byte) * BEAM_ESTIMATE_WEIGHT;
+}
+
+void example_beam_get_stats(example_beam_stats_t *stats, bool reset)
+{
+    if (reset) {
+        stats->writes = atomic_exchange_explicit(&s_beam.writes, 0, memory_order_relaxed);
+        stats->deferred = atomic_exchange_explicit(&s_beam.deferred, 0, memory_order_relaxed);
+        stats->unavoidable = atomic_exchange_explicit(&s_beam.unavoidable, 0, memory_order_relaxed);
+        stats->wait_max_us = atomic_exchange_explicit(&s_beam.wait_max_us, 0, memory_order_relaxed);
+    } else {
+        stats->writes = atomic_load_explicit(&s_beam.writes, memory_order_relaxed);
+        stats->deferred = atomic_load_explicit(&s_beam.deferred, memory_order_relaxed);
+        stats->unavoidable = atomic_load_explicit(&s_beam.unavoidable, memory_order_relaxed);
+        stats->wait_max_us = atomic_load_explicit(&s_beam.wait_max_us, memory_order_relaxed);
+    }
+    stats->copy_ns_per_byte = s_beam.ns_per_byte;
+}
@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Panel timing the scan-out position is derived from.
+ */
+typedef struct {
+    uint32_t pclk_hz;               /*!< Pixel clock */
+    uint32_t h_total;               /*!< Pixel clocks per line, including sync and porches */
+    uint32_t v_res;                 /*!< Active lines per frame */
+    uint32_t v_total;               /*!< Lines per frame, including sync and porches */
+    uint32_t vsync_to_active_lines; /*!< Lines from the VSYNC event to the first active line */
+    uint32_t margin_lines;          /*!< Distance kept between the scan-out and the lines being written */
+} example_beam_config_t;
+
+typedef struct {
+    uint32_t writes;        /*!< Writes scheduled */
+    uint32_t deferred;      /*!< Writes that had to wait for the scan-out to move on */
+    uint32_t unavoidable;   /*!< Writes too long to fit anywhere in the frame, done right away */
+    uint32_t wait_max_us;   /*!< Longest wait */
+    float copy_ns_per_byte; /*!< Current estimate of the write speed */
+} example_beam_stats_t;
+
+/**
+ * @brief Set the panel timing, the scan-out position is unknown until the first VSYNC.
+ */
+void example_beam_init(const example_beam_config_t *config);
+
+/**
+ * @brief Anchor the scan-out position, call from the VSYNC callback (ISR context).
+ */
+void example_beam_on_vsync(int64_t now_us);
+
+/**
+ * @brief Line being scanned out, active lines first, then the blanking lines up to `v_total`.
+ *
+ * @return Line in [0, v_total), or -1 before the first VSYNC
+ */
+float example_beam_line(int64_t now_us);
+
+/**
+ * @brief Compute when to start writing lines `y1` to `y2` of the frame buffer so that no frame shows them half written.
+ *
+ * A write may start while the scan-out is away from the lines and would not reach them before the write is done,
+ * or, for a top-down write slower than the scan-out, right behind the scan-out while it crosses them.
+ *
+ * @param[in] y1       First line written
+ * @param[in] y2       Last line written
+ * @param[in] bytes    Bytes written, the write time is estimated from `example_beam_write_done()`
+ * @param[in] top_down The lines are written in order, from `y1` to `y2`
+ * @param[in] now_us   Current time
+ * @return Microseconds to wait before starting the write, 0 to start now
+ */
+uint32_t example_beam_schedule(int32_t y1, int32_t y2, uint32_t bytes, bool top_down, int64_t now_us);
+
+/**
+ * @brief Report how long a write took, to refine the write time estimate.
+ */
+void example_beam_write_done(uint32_t bytes, uint32_t us);
+
+/**
+ * @brief Get the statistics collected since the last reset.
+ */
+void example_beam_get_stats(example_beam_stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
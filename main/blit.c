@@ -0,0 +1,473 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "blit.h"
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#else
+#define IRAM_ATTR
+#endif
+
+#if CONFIG_EXAMPLE_BLIT_USE_PIE
+#include <assert.h>
+#include "freertos/FreeRTOS.h"
+
+#define BLIT_HAVE_PIE           1
+#define BLIT_PIE_MIN_BYTES      64  // below this the alignment head and tail cost more than PIE saves
+// The FreeRTOS port saves the PIE registers lazily on a task switch, as it does the FPU, and pins the task to its
+// core on first use. Nothing saves them on interrupt entry, so the PIE paths are for task context only: the LVGL
+// task, the present task, and esp_timer callbacks dispatched from the esp_timer task.
+#define BLIT_PIE_CHECK_CONTEXT() assert(!xPortInIsrContext())
+
+// blit_pie.S, `dst` and `src` 16-byte aligned, `blocks` of 16 bytes
+void example_blit_copy_pie(uint8_t *dst, const uint8_t *src, uint32_t blocks);
+void example_blit_swap16_pie(uint8_t *dst, const uint8_t *src, uint32_t blocks);
+#else
+#define BLIT_HAVE_PIE           0
+#endif
+
+#define BLIT_ROTATE_TILE        16  // pixels, a tile of 16-bit pixels fits the cache lines it touches
+
+static inline uint32_t blit_swap16_word(uint32_t v)
+{
+    return ((v << 8) & 0xFF00FF00) | ((v >> 8) & 0x00FF00FF);
+}
+
+static void blit_copy_line(uint8_t *dst, const uint8_t *src, uint32_t n)
+{
+#if BLIT_HAVE_PIE
+    // PIE moves 16 aligned bytes at a time, usable when source and destination are equally misaligned
+    if (n >= BLIT_PIE_MIN_BYTES && (((uintptr_t)dst ^ (uintptr_t)src) & 15) == 0) {
+        BLIT_PIE_CHECK_CONTEXT();
+        uint32_t head = (-(uintptr_t)dst) & 15;
+        uint32_t blocks = (n - head) / 16;
+        memcpy(dst, src, head);
+        example_blit_copy_pie(dst + head, src + head, blocks);
+        uint32_t done = head + blocks * 16;
+        memcpy(dst + done, src + done, n - done);
+        return;
+    }
+#endif
+    memcpy(dst, src, n);
+}
+
+void example_blit_copy(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                       uint32_t width_bytes, uint32_t h)
+{
+    if (dst_stride == width_bytes && src_stride == width_bytes) {
+        // contiguous rectangle, one long line
+        blit_copy_line(dst, src, width_bytes * h);
+        return;
+    }
+    for (uint32_t y = 0; y < h; y++) {
+        blit_copy_line(dst, src, width_bytes);
+        dst += dst_stride;
+        src += src_stride;
+    }
+}
+
+static void blit_swap16_line(uint8_t *dst, const uint8_t *src, uint32_t w)
+{
+    uint32_t x = 0;
+#if BLIT_HAVE_PIE
+    if (w * 2 >= BLIT_PIE_MIN_BYTES && (((uintptr_t)dst ^ (uintptr_t)src) & 15) == 0 && ((uintptr_t)dst & 1) == 0) {
+        BLIT_PIE_CHECK_CONTEXT();
+        uint32_t head = ((-(uintptr_t)dst) & 15) / 2;
+        for (; x < head; x++) {
+            dst[x * 2] = src[x * 2 + 1];
+            dst[x * 2 + 1] = src[x * 2];
+        }
+        uint32_t blocks = (w - head) / 8;
+        example_blit_swap16_pie(dst + x * 2, src + x * 2, blocks);
+        x += blocks * 8;
+    }
+#endif
+    if ((((uintptr_t)dst ^ (uintptr_t)src) & 3) == 0 && ((uintptr_t)dst & 1) == 0) {
+        // equally aligned, swap two pixels per word once the destination is word aligned
+        if ((((uintptr_t)dst + x * 2) & 3) != 0 && x < w) {
+            dst[x * 2] = src[x * 2 + 1];
+            dst[x * 2 + 1] = src[x * 2];
+            x++;
+        }
+        const uint32_t *s = (const uint32_t *)(src + x * 2);
+        uint32_t *d = (uint32_t *)(dst + x * 2);
+        for (; x + 2 <= w; x += 2) {
+            *d++ = blit_swap16_word(*s++);
+        }
+    }
+    for (; x < w; x++) {
+        dst[x * 2] = src[x * 2 + 1];
+        dst[x * 2 + 1] = src[x * 2];
+    }
+}
+
+void example_blit_swap16(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                         uint32_t w, uint32_t h)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        blit_swap16_line(dst, src, w);
+        dst += dst_stride;
+        src += src_stride;
+    }
+}
+
+static inline uint16_t blit_rgb888_to_rgb565_px(const uint8_t *p)
+{
+    return ((p[2] & 0xF8) << 8) | ((p[1] & 0xFC) << 3) | (p[0] >> 3);
+}
+
+void example_blit_rgb888_to_rgb565(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                                   uint32_t w, uint32_t h)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        const uint8_t *s = src;
+        uint8_t *d = dst;
+        uint32_t x = 0;
+        if (((uintptr_t)d & 3) == 0) {
+            // two output pixels per word store
+            for (; x + 2 <= w; x += 2) {
+                *(uint32_t *)d = blit_rgb888_to_rgb565_px(s) | ((uint32_t)blit_rgb888_to_rgb565_px(s + 3) << 16);
+                s += 6;
+                d += 4;
+            }
+        }
+        for (; x < w; x++) {
+            uint16_t c = blit_rgb888_to_rgb565_px(s);
+            d[0] = c & 0xFF;
+            d[1] = c >> 8;
+            s += 3;
+            d += 2;
+        }
+        dst += dst_stride;
+        src += src_stride;
+    }
+}
+
+static void blit_rotate16(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                          uint32_t w, uint32_t h, example_blit_rotation_t rotation)
+{
+    if (rotation == EXAMPLE_BLIT_ROTATE_180) {
+        // last source line goes first, reversed
+        for (uint32_t y = 0; y < h; y++) {
+            const uint16_t *s = (const uint16_t *)(src + y * src_stride);
+            uint16_t *d = (uint16_t *)(dst + (h - 1 - y) * dst_stride) + w - 1;
+            for (uint32_t x = 0; x < w; x++) {
+                *d-- = s[x];
+            }
+        }
+        return;
+    }
+    // transpose tile by tile, so the column-wise writes stay within a few cache lines
+    for (uint32_t ty = 0; ty < h; ty += BLIT_ROTATE_TILE) {
+        uint32_t y_end = ty + BLIT_ROTATE_TILE < h ? ty + BLIT_ROTATE_TILE : h;
+        for (uint32_t tx = 0; tx < w; tx += BLIT_ROTATE_TILE) {
+            uint32_t x_end = tx + BLIT_ROTATE_TILE < w ? tx + BLIT_ROTATE_TILE : w;
+            for (uint32_t y = ty; y < y_end; y++) {
+                const uint16_t *s = (const uint16_t *)(src + y * src_stride);
+                if (rotation == EXAMPLE_BLIT_ROTATE_90) {
+                    uint8_t *d = dst + tx * dst_stride + (h - 1 - y) * 2;
+                    for (uint32_t x = tx; x < x_end; x++) {
+                        *(uint16_t *)d = s[x];
+                        d += dst_stride;
+                    }
+                } else {
+                    uint8_t *d = dst + (w - 1 - tx) * dst_stride + y * 2;
+                    for (uint32_t x = tx; x < x_end; x++) {
+                        *(uint16_t *)d = s[x];
+                        d -= dst_stride;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void example_blit_rotate(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                         uint32_t w, uint32_t h, uint32_t pixel_size, example_blit_rotation_t rotation)
+{
+    if (rotation == EXAMPLE_BLIT_ROTATE_0) {
+        example_blit_copy(dst, dst_stride, src, src_stride, w * pixel_size, h);
+    } else if (pixel_size == 2 && (((uintptr_t)dst | (uintptr_t)src | dst_stride | src_stride) & 1) == 0) {
+        blit_rotate16(dst, dst_stride, src, src_stride, w, h, rotation);
+    } else {
+        example_blit_rotate_ref(dst, dst_stride, src, src_stride, w, h, pixel_size, rotation);
+    }
+}
+
+// the palette expansions run in the bounce buffer refill ISR: no PIE, the lookups don't vectorize anyway.
+// Four indices are read per word load, and the pixels stored a word at a time.
+void IRAM_ATTR example_blit_l8_to_rgb565(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                                         uint32_t w, uint32_t h, const uint16_t *lut)
+{
+    if (dst_stride == w * 2 && src_stride == w) {
+        // contiguous rectangle, one long line
+        w *= h;
+        h = 1;
+    }
+    for (uint32_t y = 0; y < h; y++) {
+        const uint8_t *s = src;
+        uint8_t *d = dst;
+        uint32_t x = 0;
+        for (; x < w && ((uintptr_t)s & 3) != 0; x++) {
+            uint16_t c = lut[*s++];
+            d[0] = c & 0xFF;
+            d[1] = c >> 8;
+            d += 2;
+        }
+        if (((uintptr_t)d & 3) == 0) {
+            uint32_t *d32 = (uint32_t *)d;
+            for (; x + 4 <= w; x += 4) {
+                uint32_t i = *(const uint32_t *)s;
+                d32[0] = lut[i & 0xFF] | ((uint32_t)lut[(i >> 8) & 0xFF] << 16);
+                d32[1] = lut[(i >> 16) & 0xFF] | ((uint32_t)lut[i >> 24] << 16);
+                d32 += 2;
+                s += 4;
+            }
+            d = (uint8_t *)d32;
+        }
+        for (; x < w; x++) {
+            uint16_t c = lut[*s++];
+            d[0] = c & 0xFF;
+            d[1] = c >> 8;
+            d += 2;
+        }
+        dst += dst_stride;
+        src += src_stride;
+    }
+}
+
+void IRAM_ATTR example_blit_l8_to_rgb888(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                                         uint32_t w, uint32_t h, const uint32_t *lut)
+{
+    if (dst_stride == w * 3 && src_stride == w) {
+        w *= h;
+        h = 1;
+    }
+    for (uint32_t y = 0; y < h; y++) {
+        const uint8_t *s = src;
+        uint8_t *d = dst;
+        uint32_t x = 0;
+        // 4 pixels make 3 words, the indices and the output get word aligned together if their offsets add up to 4
+        if ((((uintptr_t)s + (uintptr_t)d) & 3) == 0) {
+            for (; x < w && ((uintptr_t)s & 3) != 0; x++) {
+                uint32_t c = lut[*s++];
+                d[0] = c & 0xFF;
+                d[1] = (c >> 8) & 0xFF;
+                d[2] = (c >> 16) & 0xFF;
+                d += 3;
+            }
+            uint32_t *d32 = (uint32_t *)d;
+            for (; x + 4 <= w; x += 4) {
+                uint32_t i = *(const uint32_t *)s;
+                uint32_t c0 = lut[i & 0xFF];
+                uint32_t c1 = lut[(i >> 8) & 0xFF];
+                uint32_t c2 = lut[(i >> 16) & 0xFF];
+                uint32_t c3 = lut[i >> 24];
+                d32[0] = (c0 & 0xFFFFFF) | (c1 << 24);
+                d32[1] = ((c1 >> 8) & 0xFFFF) | (c2 << 16);
+                d32[2] = ((c2 >> 16) & 0xFF) | (c3 << 8);
+                d32 += 3;
+                s += 4;
+            }
+            d = (uint8_t *)d32;
+        }
+        for (; x < w; x++) {
+            uint32_t c = lut[*s++];
+            d[0] = c & 0xFF;
+            d[1] = (c >> 8) & 0xFF;
+            d[2] = (c >> 16) & 0xFF;
+            d += 3;
+        }
+        dst += dst_stride;
+        src += src_stride;
+    }
+}
+
+// top 4 bits of R, G and B of an RGB565 pixel, as EXAMPLE_BLIT_L8_KEY()
+static inline uint32_t blit_rgb565_key(uint32_t c)
+{
+    return ((c >> 12) << 8) | ((c >> 3) & 0xF0) | ((c >> 1) & 0x0F);
+}
+
+void example_blit_rgb565_to_l8(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                               uint32_t w, uint32_t h, const uint8_t *inv_lut)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        const uint8_t *s = src;
+        uint8_t *d = dst;
+        uint32_t x = 0;
+        for (; x < w && ((uintptr_t)d & 3) != 0; x++) {
+            *d++ = inv_lut[blit_rgb565_key(s[0] | (s[1] << 8))];
+            s += 2;
+        }
+        if (((uintptr_t)s & 3) == 0) {
+            // two pixels per word load, four indices per word store
+            const uint32_t *s32 = (const uint32_t *)s;
+            for (; x + 4 <= w; x += 4) {
+                uint32_t p01 = s32[0];
+                uint32_t p23 = s32[1];
+                *(uint32_t *)d = inv_lut[blit_rgb565_key(p01 & 0xFFFF)] |
+                                 ((uint32_t)inv_lut[blit_rgb565_key(p01 >> 16)] << 8) |
+                                 ((uint32_t)inv_lut[blit_rgb565_key(p23 & 0xFFFF)] << 16) |
+                                 ((uint32_t)inv_lut[blit_rgb565_key(p23 >> 16)] << 24);
+                s32 += 2;
+                d += 4;
+            }
+            s = (const uint8_t *)s32;
+        }
+        for (; x < w; x++) {
+            *d++ = inv_lut[blit_rgb565_key(s[0] | (s[1] << 8))];
+            s += 2;
+        }
+        dst += dst_stride;
+        src += src_stride;
+    }
+}
+
+void example_blit_rgb888_to_l8(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                               uint32_t w, uint32_t h, const uint8_t *inv_lut)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        const uint8_t *s = src;
+        uint8_t *d = dst;
+        uint32_t x = 0;
+        for (; x < w && ((uintptr_t)d & 3) != 0; x++) {
+            *d++ = inv_lut[EXAMPLE_BLIT_L8_KEY(s[2], s[1], s[0])];
+            s += 3;
+        }
+        // four indices per word store
+        for (; x + 4 <= w; x += 4) {
+            *(uint32_t *)d = inv_lut[EXAMPLE_BLIT_L8_KEY(s[2], s[1], s[0])] |
+                             ((uint32_t)inv_lut[EXAMPLE_BLIT_L8_KEY(s[5], s[4], s[3])] << 8) |
+                             ((uint32_t)inv_lut[EXAMPLE_BLIT_L8_KEY(s[8], s[7], s[6])] << 16) |
+                             ((uint32_t)inv_lut[EXAMPLE_BLIT_L8_KEY(s[11], s[10], s[9])] << 24);
+            s += 12;
+            d += 4;
+        }
+        for (; x < w; x++) {
+            *d++ = inv_lut[EXAMPLE_BLIT_L8_KEY(s[2], s[1], s[0])];
+            s += 3;
+        }
+        dst += dst_stride;
+        src += src_stride;
+    }
+}
+
+/* Self test */
+
+#define BLIT_TEST_ROUNDS        400
+#define BLIT_TEST_OPS           8
+#define BLIT_TEST_MAX_W         96
+#define BLIT_TEST_MAX_H         24
+#define BLIT_TEST_BUF_SIZE      (BLIT_TEST_MAX_W * 3 * BLIT_TEST_MAX_W + 64)
+
+static uint32_t s_test_seed;
+// bytes per pixel read and written by each operation of the self test
+static const uint8_t s_test_src_ps[BLIT_TEST_OPS] = {2, 2, 3, 2, 1, 1, 2, 3};
+static const uint8_t s_test_dst_ps[BLIT_TEST_OPS] = {2, 2, 2, 2, 2, 3, 1, 1};
+
+static uint32_t blit_test_rand(uint32_t range)
+{
+    s_test_seed = s_test_seed * 1664525 + 1013904223;
+    return (s_test_seed >> 8) % range;
+}
+
+static void blit_test_fill(uint8_t *buf, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++) {
+        buf[i] = blit_test_rand(256);
+    }
+}
+
+bool example_blit_self_test(void)
+{
+    uint8_t *src = malloc(BLIT_TEST_BUF_SIZE);
+    uint8_t *out = malloc(BLIT_TEST_BUF_SIZE);
+    uint8_t *ref = malloc(BLIT_TEST_BUF_SIZE);
+    uint16_t *lut565 = malloc(256 * sizeof(uint16_t));
+    uint32_t *lut888 = malloc(256 * sizeof(uint32_t));
+    uint8_t *inv_lut = malloc(EXAMPLE_BLIT_L8_KEYS);
+    bool ok = src && out && ref && lut565 && lut888 && inv_lut;
+
+    s_test_seed = 1;
+    if (ok) {
+        // random tables, the top byte of the RGB888 entries must be ignored
+        blit_test_fill((uint8_t *)lut565, 256 * sizeof(uint16_t));
+        blit_test_fill((uint8_t *)lut888, 256 * sizeof(uint32_t));
+        blit_test_fill(inv_lut, EXAMPLE_BLIT_L8_KEYS);
+    }
+    for (int round = 0; ok && round < BLIT_TEST_ROUNDS; round++) {
+        uint32_t w = 1 + blit_test_rand(BLIT_TEST_MAX_W);
+        uint32_t h = 1 + blit_test_rand(BLIT_TEST_MAX_H);
+        uint32_t src_off = blit_test_rand(16);
+        uint32_t dst_off = blit_test_rand(16);
+        // every other round, give both sides the same alignment so the vector paths get exercised
+        if (round & 1) {
+            dst_off = src_off;
+        }
+        uint32_t op = round % BLIT_TEST_OPS;
+        uint32_t src_ps = s_test_src_ps[op];
+        uint32_t dst_ps = s_test_dst_ps[op];
+        uint32_t src_stride = w * src_ps + blit_test_rand(2) * 16;
+        // rotated by 90/270 the destination lines are `h` pixels long
+        uint32_t dst_stride = (op == 3 ? BLIT_TEST_MAX_W : w) * dst_ps + blit_test_rand(2) * 16;
+        example_blit_rotation_t rotation = blit_test_rand(4);
+
+        blit_test_fill(src, BLIT_TEST_BUF_SIZE);
+        blit_test_fill(out, BLIT_TEST_BUF_SIZE);
+        memcpy(ref, out, BLIT_TEST_BUF_SIZE);
+        switch (op) {
+        case 0:
+            example_blit_copy(out + dst_off, dst_stride, src + src_off, src_stride, w * 2, h);
+            example_blit_copy_ref(ref + dst_off, dst_stride, src + src_off, src_stride, w * 2, h);
+            break;
+        case 1:
+            example_blit_swap16(out + dst_off, dst_stride, src + src_off, src_stride, w, h);
+            example_blit_swap16_ref(ref + dst_off, dst_stride, src + src_off, src_stride, w, h);
+            break;
+        case 2:
+            example_blit_rgb888_to_rgb565(out + dst_off, dst_stride, src + src_off, src_stride, w, h);
+            example_blit_rgb888_to_rgb565_ref(ref + dst_off, dst_stride, src + src_off, src_stride, w, h);
+            break;
+        case 4:
+            example_blit_l8_to_rgb565(out + dst_off, dst_stride, src + src_off, src_stride, w, h, lut565);
+            example_blit_l8_to_rgb565_ref(ref + dst_off, dst_stride, src + src_off, src_stride, w, h, lut565);
+            break;
+        case 5:
+            example_blit_l8_to_rgb888(out + dst_off, dst_stride, src + src_off, src_stride, w, h, lut888);
+            example_blit_l8_to_rgb888_ref(ref + dst_off, dst_stride, src + src_off, src_stride, w, h, lut888);
+            break;
+        case 6:
+            example_blit_rgb565_to_l8(out + dst_off, dst_stride, src + src_off, src_stride, w, h, inv_lut);
+            example_blit_rgb565_to_l8_ref(ref + dst_off, dst_stride, src + src_off, src_stride, w, h, inv_lut);
+            break;
+        case 7:
+            example_blit_rgb888_to_l8(out + dst_off, dst_stride, src + src_off, src_stride, w, h, inv_lut);
+            example_blit_rgb888_to_l8_ref(ref + dst_off, dst_stride, src + src_off, src_stride, w, h, inv_lut);
+            break;
+        default:
+            // the tiled path needs 16-bit aligned pixels
+            dst_off &= ~1;
+            src_off &= ~1;
+            example_blit_rotate(out + dst_off, dst_stride, src + src_off, src_stride, w, h, 2, rotation);
+            example_blit_rotate_ref(ref + dst_off, dst_stride, src + src_off, src_stride, w, h, 2, rotation);
+            break;
+        }
+        ok = memcmp(out, ref, BLIT_TEST_BUF_SIZE) == 0;
+    }
+
+    free(src);
+    free(out);
+    free(ref);
+    free(lut565);
+    free(lut888);
+    free(inv_lut);
+    return ok;
+}
@@ -0,0 +1,121 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Clockwise rotation applied by `example_blit_rotate()`.
+ */
+typedef enum {
+    EXAMPLE_BLIT_ROTATE_0,
+    EXAMPLE_BLIT_ROTATE_90,
+    EXAMPLE_BLIT_ROTATE_180,
+    EXAMPLE_BLIT_ROTATE_270,
+} example_blit_rotation_t;
+
+/**
+ * @brief Index into the inverse palette table of `example_blit_*_to_l8()`: the top 4 bits of each 8-bit channel.
+ */
+#define EXAMPLE_BLIT_L8_KEY(r, g, b)    ((((r) >> 4) << 8) | (((g) >> 4) << 4) | ((b) >> 4))
+#define EXAMPLE_BLIT_L8_KEYS            4096
+
+/*
+ * All functions copy a `w` x `h` pixel rectangle. Strides are in bytes, `dst` and `src` point to the
+ * top-left pixel of the rectangle and must not overlap. RGB888 is in LVGL byte order (B, G, R).
+ *
+ * The `example_blit_*()` functions pick the fastest implementation for the target (PIE on ESP32-S3 when
+ * enabled), the `example_blit_*_ref()` ones are the portable scalar references they must match bit-exactly.
+ * With PIE, the copies and swaps must be called from a task, never from an ISR (asserted).
+ */
+
+/**
+ * @brief Copy `width_bytes` bytes per line.
+ */
+void example_blit_copy(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                       uint32_t width_bytes, uint32_t h);
+
+/**
+ * @brief Copy RGB565 pixels, swapping the two bytes of each (for panels that expect big endian RGB565).
+ */
+void example_blit_swap16(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                         uint32_t w, uint32_t h);
+
+/**
+ * @brief Convert RGB888 pixels to RGB565, dropping the low bits of each channel.
+ */
+void example_blit_rgb888_to_rgb565(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                                   uint32_t w, uint32_t h);
+
+/**
+ * @brief Copy pixels of `pixel_size` bytes, rotated clockwise.
+ *
+ * @note  For 90 and 270 degrees the destination rectangle is `h` x `w`.
+ */
+void example_blit_rotate(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                         uint32_t w, uint32_t h, uint32_t pixel_size, example_blit_rotation_t rotation);
+
+/**
+ * @brief Expand 8-bit palette indices to RGB565 pixels, through a 256 entry table of RGB565 values.
+ *
+ * @note  In IRAM and without PIE, so it can refill bounce buffers from an ISR.
+ */
+void example_blit_l8_to_rgb565(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                               uint32_t w, uint32_t h, const uint16_t *lut);
+
+/**
+ * @brief Expand 8-bit palette indices to RGB888 pixels, through a 256 entry table holding B, G, R in the low 3 bytes.
+ *
+ * @note  In IRAM and without PIE, so it can refill bounce buffers from an ISR.
+ */
+void example_blit_l8_to_rgb888(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                               uint32_t w, uint32_t h, const uint32_t *lut);
+
+/**
+ * @brief Map RGB565 pixels to 8-bit palette indices, through a table of `EXAMPLE_BLIT_L8_KEYS` indices.
+ */
+void example_blit_rgb565_to_l8(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                               uint32_t w, uint32_t h, const uint8_t *inv_lut);
+
+/**
+ * @brief Map RGB888 pixels to 8-bit palette indices, through a table of `EXAMPLE_BLIT_L8_KEYS` indices.
+ */
+void example_blit_rgb888_to_l8(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                               uint32_t w, uint32_t h, const uint8_t *inv_lut);
+
+void example_blit_copy_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                           uint32_t width_bytes, uint32_t h);
+void example_blit_swap16_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                             uint32_t w, uint32_t h);
+void example_blit_rgb888_to_rgb565_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                                       uint32_t w, uint32_t h);
+void example_blit_rotate_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                             uint32_t w, uint32_t h, uint32_t pixel_size, example_blit_rotation_t rotation);
+void example_blit_l8_to_rgb565_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                                   uint32_t w, uint32_t h, const uint16_t *lut);
+void example_blit_l8_to_rgb888_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                                   uint32_t w, uint32_t h, const uint32_t *lut);
+void example_blit_rgb565_to_l8_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                                   uint32_t w, uint32_t h, const uint8_t *inv_lut);
+void example_blit_rgb888_to_l8_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                                   uint32_t w, uint32_t h, const uint8_t *inv_lut);
+
+/**
+ * @brief Run every blit on random rectangles, strides and alignments, and compare with the references.
+ *
+ * @return true if all results are bit-exact
+ */
+bool example_blit_self_test(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+// Portable one-pixel-at-a-time implementations, the behavior the optimized blits must reproduce
+
+#include "blit.h"
+
+void example_blit_copy_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                           uint32_t width_bytes, uint32_t h)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < width_bytes; x++) {
+            dst[y * dst_stride + x] = src[y * src_stride + x];
+        }
+    }
+}
+
+void example_blit_swap16_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                             uint32_t w, uint32_t h)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            dst[y * dst_stride + x * 2] = src[y * src_stride + x * 2 + 1];
+            dst[y * dst_stride + x * 2 + 1] = src[y * src_stride + x * 2];
+        }
+    }
+}
+
+void example_blit_rgb888_to_rgb565_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                                       uint32_t w, uint32_t h)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            const uint8_t *p = &src[y * src_stride + x * 3];
+            uint16_t c = ((p[2] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[0] >> 3);
+            dst[y * dst_stride + x * 2] = c & 0xFF;
+            dst[y * dst_stride + x * 2 + 1] = c >> 8;
+        }
+    }
+}
+
+void example_blit_rotate_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                             uint32_t w, uint32_t h, uint32_t pixel_size, example_blit_rotation_t rotation)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            uint32_t dx, dy;
+            switch (rotation) {
+            case EXAMPLE_BLIT_ROTATE_90:
+                dx = h - 1 - y;
+                dy = x;
+                break;
+            case EXAMPLE_BLIT_ROTATE_180:
+                dx = w - 1 - x;
+                dy = h - 1 - y;
+                break;
+            case EXAMPLE_BLIT_ROTATE_270:
+                dx = y;
+                dy = w - 1 - x;
+                break;
+            default:
+                dx = x;
+                dy = y;
+                break;
+            }
+            for (uint32_t i = 0; i < pixel_size; i++) {
+                dst[dy * dst_stride + dx * pixel_size + i] = src[y * src_stride + x * pixel_size + i];
+            }
+        }
+    }
+}
+
+void example_blit_l8_to_rgb565_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                                   uint32_t w, uint32_t h, const uint16_t *lut)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            uint16_t c = lut[src[y * src_stride + x]];
+            dst[y * dst_stride + x * 2] = c & 0xFF;
+            dst[y * dst_stride + x * 2 + 1] = c >> 8;
+        }
+    }
+}
+
+void example_blit_l8_to_rgb888_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                                   uint32_t w, uint32_t h, const uint32_t *lut)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            uint32_t c = lut[src[y * src_stride + x]];
+            dst[y * dst_stride + x * 3] = c & 0xFF;
+            dst[y * dst_stride + x * 3 + 1] = (c >> 8) & 0xFF;
+            dst[y * dst_stride + x * 3 + 2] = (c >> 16) & 0xFF;
+        }
+    }
+}
+
+void example_blit_rgb565_to_l8_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                                   uint32_t w, uint32_t h, const uint8_t *inv_lut)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            const uint8_t *p = &src[y * src_stride + x * 2];
+            uint16_t c = p[0] | (p[1] << 8);
+            uint8_t r = (c >> 11) << 3;
+            uint8_t g = ((c >> 5) & 0x3F) << 2;
+            uint8_t b = (c & 0x1F) << 3;
+            dst[y * dst_stride + x] = inv_lut[EXAMPLE_BLIT_L8_KEY(r, g, b)];
+        }
+    }
+}
+
+void example_blit_rgb888_to_l8_ref(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                                   uint32_t w, uint32_t h, const uint8_t *inv_lut)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            const uint8_t *p = &src[y * src_stride + x * 3];
+            dst[y * dst_stride + x] = inv_lut[EXAMPLE_BLIT_L8_KEY(p[2], p[1], p[0])];
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <inttypes.h>
+#include <stdatomic.h>
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "boot_timing.h"
+
+static const char *TAG = "boot";
+
+static const char *const s_phase_names[EXAMPLE_BOOT_PHASE_MAX] = {
+    [EXAMPLE_BOOT_APP_MAIN] = "app_main",
+    [EXAMPLE_BOOT_PANEL_CREATED] = "panel created",
+    [EXAMPLE_BOOT_LVGL_READY] = "LVGL ready",
+    [EXAMPLE_BOOT_UI_BUILT] = "UI built",
+    [EXAMPLE_BOOT_PANEL_RESET] = "panel reset",
+    [EXAMPLE_BOOT_PANEL_INIT] = "panel init",
+    [EXAMPLE_BOOT_FIRST_FRAME] = "first frame",
+    [EXAMPLE_BOOT_BACKLIGHT_ON] = "backlight on",
+};
+
+// milestones are marked from several tasks and ISRs, 0 means not reached
+static _Atomic uint32_t s_marks_us[EXAMPLE_BOOT_PHASE_MAX];
+
+bool IRAM_ATTR example_boot_mark(example_boot_phase_t phase, int64_t now_us)
+{
+    // the startup is over long before 32-bit microseconds wrap, and it never ends at 0 us
+    uint32_t expected = 0;
+    uint32_t mark_us = now_us > 0 ? (uint32_t)now_us : 1;
+    return atomic_compare_exchange_strong(&s_marks_us[phase], &expected, mark_us);
+}
+
+int64_t example_boot_time(example_boot_phase_t phase)
+{
+    uint32_t mark_us = atomic_load(&s_marks_us[phase]);
+    return mark_us ? (int64_t)mark_us : -1;
+}
+
+void example_boot_report(void)
+{
+    for (int i = 0; i < EXAMPLE_BOOT_PHASE_MAX; i++) {
+        int64_t t_us = example_boot_time(i);
+        if (t_us < 0) {
+            ESP_LOGI(TAG, "%-13s not reached", s_phase_names[i]);
+            continue;
+        }
+        // the phases overlap, the delta is to the latest milestone reached before this one
+        int64_t prev_us = 0;
+        for (int j = 0; j < EXAMPLE_BOOT_PHASE_MAX; j++) {
+            int64_t other_us = example_boot_time(j);
+            if (other_us < t_us && other_us > prev_us) {
+                prev_us = other_us;
+            }
+        }
+        ESP_LOGI(TAG, "%-13s %4"PRIu32".%"PRIu32" ms (+%"PRIu32".%"PRIu32" ms)", s_phase_names[i],
+                 (uint32_t)(t_us / 1000), (uint32_t)(t_us % 1000 / 100),
+                 (uint32_t)((t_us - prev_us) / 1000), (uint32_t)((t_us - prev_us) % 1000 / 100));
+    }
+}
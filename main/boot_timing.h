@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Milestones of the startup, in the order they are reported.
+ */
+typedef enum {
+    EXAMPLE_BOOT_APP_MAIN,      /*!< app_main() entered */
+    EXAMPLE_BOOT_PANEL_CREATED, /*!< Panel IO and RGB panel driver installed, frame buffers allocated */
+    EXAMPLE_BOOT_LVGL_READY,    /*!< LVGL display, buffers and callbacks set up */
+    EXAMPLE_BOOT_UI_BUILT,      /*!< First screen created */
+    EXAMPLE_BOOT_PANEL_RESET,   /*!< Panel out of reset */
+    EXAMPLE_BOOT_PANEL_INIT,    /*!< Init sequence sent, scan-out running */
+    EXAMPLE_BOOT_FIRST_FRAME,   /*!< First frame completely in the frame buffer on screen */
+    EXAMPLE_BOOT_BACKLIGHT_ON,  /*!< Backlight on, the first frame is visible */
+    EXAMPLE_BOOT_PHASE_MAX,
+} example_boot_phase_t;
+
+/**
+ * @brief Record the time a milestone was reached, only the first call counts. ISR safe.
+ *
+ * @return true if this call recorded the milestone
+ */
+bool example_boot_mark(example_boot_phase_t phase, int64_t now_us);
+
+/**
+ * @brief Time a milestone was reached, since the esp_timer started.
+ *
+ * @return Time in microseconds, or -1 if not reached yet
+ */
+int64_t example_boot_time(example_boot_phase_t phase);
+
+/**
+ * @brief Log the milestones reached so far, with the time since startup and since the previous one.
+ */
+void example_boot_report(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,198 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <string.h>
+#include "esp_attr.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "bounce_buffer.h"
+#include "blit.h"
+#include "palette.h"
+
+static const char *TAG = "bounce";
+
+static struct {
+    uint8_t *fb;
+    uint32_t stride;
+    uint32_t pixel_size;
+    uint32_t fb_pixel_size;
+    uint32_t h_res;
+    uint32_t size_px;
+    uint32_t frame_px;
+    uint32_t period_us;
+    uint32_t line_ns;
+    int64_t frame_us;
+    // scan-out model, ISR only: when the DMA starts reading the frame the refills are for, and the earliest
+    // start that the refills of the frame before were consistent with
+    int64_t frame_start_us;
+    int64_t prev_best_us;
+    int64_t best_us;
+    atomic_uint fills;
+    atomic_uint underruns;
+    atomic_uint fill_max_us;
+} s_bounce;
+
+// the RGB driver wants the frame to be an even number of bounce buffers
+static bool bounce_lines_valid(const example_bounce_config_t *config, uint32_t lines)
+{
+    return config->v_res % (2 * lines) == 0;
+}
+
+uint32_t example_bounce_calc_size_px(const example_bounce_config_t *config)
+{
+    uint32_t line_bytes = config->h_res * config->pixel_size;
+    // the DMA needs a new line every line period, copying it from PSRAM takes less, the difference builds up the slack
+    float line_us = (float)config->h_total * 1e6f / config->pclk_hz;
+    float copy_us = (float)config->h_res * config->fb_pixel_size / config->psram_bandwidth_mbps;
+    size_t sram_free = heap_caps_get_largest_free_block(MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    uint32_t max_lines = sram_free / 100 * config->sram_budget_percent / (2 * line_bytes);
+
+    // a refill has one bounce buffer period to complete: latency + lines * copy_us <= lines * line_us
+    uint32_t want_lines = max_lines;
+    if (copy_us < line_us) {
+        want_lines = (uint32_t)ceilf(config->max_isr_latency_us / (line_us - copy_us));
+    } else {
+        ESP_LOGW(TAG, "PSRAM copy (%.1f us/line) can't keep up with the panel (%.1f us/line)", copy_us, line_us);
+    }
+    if (want_lines < 1) {
+        want_lines = 1;
+    }
+
+    // round up to a valid size, but stay within the SRAM budget
+    uint32_t lines = 0;
+    for (uint32_t n = want_lines; n <= config->v_res / 2; n++) {
+        if (bounce_lines_valid(config, n)) {
+            lines = n;
+            break;
+        }
+    }
+    if (lines == 0 || lines > max_lines) {
+        for (lines = LV_MIN(max_lines, config->v_res / 2); lines > 1 && !bounce_lines_valid(config, lines); lines--) {
+        }
+        ESP_LOGW(TAG, "%"PRIu32" lines needed to cover %"PRIu32" us of latency, only %"PRIu32" fit in %"PRIu32"%% of %zu bytes SRAM, expect underruns",
+                 want_lines, config->max_isr_latency_us, lines, config->sram_budget_percent, sram_free);
+    }
+    lines = LV_MAX(lines, 1);
+
+    ESP_LOGI(TAG, "line %.1f us, PSRAM copy %.1f us/line, bounce buffer %"PRIu32" lines (2 x %"PRIu32" bytes), refill budget %.0f us",
+             line_us, copy_us, lines, lines * line_bytes, lines * line_us);
+    return lines * config->h_res;
+}
+
+esp_err_t example_bounce_init(const example_bounce_config_t *config, uint32_t size_px)
+{
+    memset(&s_bounce, 0, sizeof(s_bounce));
+    s_bounce.pixel_size = config->pixel_size;
+    s_bounce.fb_pixel_size = config->fb_pixel_size;
+    s_bounce.stride = config->h_res * config->fb_pixel_size;
+    s_bounce.h_res = config->h_res;
+    s_bounce.size_px = size_px;
+    s_bounce.frame_px = config->h_res * config->v_res;
+    s_bounce.period_us = (uint32_t)((uint64_t)size_px / config->h_res * config->h_total * 1000000 / config->pclk_hz);
+    s_bounce.line_ns = (uint32_t)((uint64_t)config->h_total * 1000000000 / config->pclk_hz);
+    s_bounce.frame_us = (int64_t)config->v_total * s_bounce.line_ns / 1000;
+    s_bounce.frame_start_us = INT64_MAX;
+    s_bounce.prev_best_us = INT64_MAX;
+    s_bounce.best_us = INT64_MAX;
+    s_bounce.fb = heap_caps_calloc(1, s_bounce.stride * config->v_res, MALLOC_CAP_SPIRAM);
+    ESP_RETURN_ON_FALSE(s_bounce.fb, ESP_ERR_NO_MEM, TAG, "no mem for frame buffer");
+    return ESP_OK;
+}
+
+void example_bounce_draw(const lv_area_t *area, const uint8_t *px_map)
+{
+    uint32_t line_bytes = lv_area_get_width(area) * s_bounce.pixel_size;
+    uint8_t *dst = s_bounce.fb + area->y1 * s_bounce.stride + area->x1 * s_bounce.fb_pixel_size;
+    if (s_bounce.fb_pixel_size == 1) {
+        example_palette_quantize(dst, s_bounce.stride, px_map, line_bytes, lv_area_get_width(area), lv_area_get_height(area));
+        return;
+    }
+    example_blit_copy(dst, s_bounce.stride, px_map, line_bytes, line_bytes, lv_area_get_height(area));
+}
+
+uint8_t *example_bounce_get_fb(void)
+{
+    return s_bounce.fb;
+}
+
+// time from the start of a frame until the DMA starts reading the pixel at `pos_px`, negative for the frame before
+static inline int64_t IRAM_ATTR bounce_scan_us(int32_t pos_px)
+{
+    int64_t frame_us = 0;
+    if (pos_px < 0) {
+        pos_px += s_bounce.frame_px;
+        frame_us = s_bounce.frame_us;
+    }
+    // a frame is well below 2^32 ns, no 64-bit division in the ISR
+    return (uint32_t)pos_px / s_bounce.h_res * s_bounce.line_ns / 1000 - frame_us;
+}
+
+void IRAM_ATTR example_bounce_refill_done(int pos_px, int64_t start_us, int64_t end_us)
+{
+    // The driver asks for the refill at `pos_px` once the DMA has emptied the buffer that held pos_px - 2 buffers,
+    // so the request can't be earlier than this after the start of the frame. The first two refills of a frame
+    // are asked for in the frame before, the vertical blanking is in their budget.
+    int64_t request_us = bounce_scan_us((int32_t)pos_px - 2 * (int32_t)s_bounce.size_px) + s_bounce.period_us;
+    // the refill started late by its latency, the earliest start of the frame it fits is the closest to the truth
+    int64_t frame_start_us = start_us - request_us;
+    if (pos_px == 0) {
+        s_bounce.prev_best_us = s_bounce.best_us;
+        s_bounce.best_us = frame_start_us;
+        s_bounce.frame_start_us = s_bounce.prev_best_us == INT64_MAX ? INT64_MAX : s_bounce.prev_best_us + s_bounce.frame_us;
+    } else if (frame_start_us < s_bounce.best_us) {
+        s_bounce.best_us = frame_start_us;
+    }
+    if (frame_start_us < s_bounce.frame_start_us) {
+        s_bounce.frame_start_us = frame_start_us;
+    }
+
+    // the DMA starts reading this buffer one buffer of scan time after the request, it must be full by then.
+    // Nothing to compare against before a whole frame was refilled
+    if (s_bounce.prev_best_us != INT64_MAX && end_us > s_bounce.frame_start_us + bounce_scan_us(pos_px)) {
+        atomic_fetch_add_explicit(&s_bounce.underruns, 1, memory_order_relaxed);
+    }
+
+    uint32_t fill_us = (uint32_t)(end_us - start_us);
+    unsigned max = atomic_load_explicit(&s_bounce.fill_max_us, memory_order_relaxed);
+    if (fill_us > max) {
+        atomic_store_explicit(&s_bounce.fill_max_us, fill_us, memory_order_relaxed);
+    }
+    atomic_fetch_add_explicit(&s_bounce.fills, 1, memory_order_relaxed);
+}
+
+bool IRAM_ATTR example_bounce_on_empty(esp_lcd_panel_handle_t panel, void *bounce_buf, int pos_px, int len_bytes, void *user_ctx)
+{
+    int64_t start_us = esp_timer_get_time();
+    if (s_bounce.fb_pixel_size == 1) {
+        // half (RGB565) or a third (RGB888) of the PSRAM reads, for a table lookup per pixel
+        example_palette_expand(bounce_buf, s_bounce.fb + pos_px, len_bytes / s_bounce.pixel_size);
+    } else {
+        // plain memcpy, the PIE blits are not usable from an ISR
+        memcpy(bounce_buf, s_bounce.fb + pos_px * s_bounce.pixel_size, len_bytes);
+    }
+    example_bounce_refill_done(pos_px, start_us, esp_timer_get_time());
+    return false;
+}
+
+void example_bounce_get_stats(example_bounce_stats_t *stats, bool reset)
+{
+    stats->size_px = s_bounce.size_px;
+    stats->period_us = s_bounce.period_us;
+    if (reset) {
+        stats->fills = atomic_exchange_explicit(&s_bounce.fills, 0, memory_order_relaxed);
+        stats->underruns = atomic_exchange_explicit(&s_bounce.underruns, 0, memory_order_relaxed);
+        stats->fill_max_us = atomic_exchange_explicit(&s_bounce.fill_max_us, 0, memory_order_relaxed);
+    } else {
+        stats->fills = atomic_load_explicit(&s_bounce.fills, memory_order_relaxed);
+        stats->underruns = atomic_load_explicit(&s_bounce.underruns, memory_order_relaxed);
+        stats->fill_max_us = atomic_load_explicit(&s_bounce.fill_max_us, memory_order_relaxed);
+    }
+}
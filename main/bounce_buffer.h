@@ -0,0 +1,108 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_lcd_types.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Panel timing and platform limits used to size the bounce buffers.
+ */
+typedef struct {
+    uint32_t pclk_hz;               /*!< Pixel clock */
+    uint32_t h_res;                 /*!< Active pixels per line */
+    uint32_t v_res;                 /*!< Active lines per frame */
+    uint32_t h_total;               /*!< Pixel clocks per line, including sync and porches */
+    uint32_t v_total;               /*!< Lines per frame, including sync and porches */
+    uint32_t pixel_size;            /*!< Bytes per pixel */
+    uint32_t fb_pixel_size;         /*!< Bytes per pixel in the frame buffer, 1 for palette indices expanded by the refill */
+    uint32_t psram_bandwidth_mbps;  /*!< Sustained PSRAM to SRAM copy rate, in MB/s */
+    uint32_t max_isr_latency_us;    /*!< Worst delay before a bounce buffer refill starts */
+    uint32_t sram_budget_percent;   /*!< Share of the largest free internal DMA block the bounce buffers may use */
+} example_bounce_config_t;
+
+typedef struct {
+    uint32_t size_px;           /*!< Size of one bounce buffer */
+    uint32_t period_us;         /*!< Time the DMA takes to scan one bounce buffer, i.e. the refill budget */
+    uint32_t fills;             /*!< Refills since the last reset */
+    uint32_t underruns;         /*!< Refills that finished after the DMA started reading the buffer */
+    uint32_t fill_max_us;       /*!< Longest refill, from callback entry to done */
+} example_bounce_stats_t;
+
+/**
+ * @brief Compute the bounce buffer size that covers the refill latency, within the internal SRAM budget.
+ *
+ * The bounce buffer holds whole lines and the frame is an even number of bounce buffers, as the RGB driver requires.
+ *
+ * @param[in] config Panel timing and platform limits
+ * @return Size of one bounce buffer in pixels
+ */
+uint32_t example_bounce_calc_size_px(const example_bounce_config_t *config);
+
+/**
+ * @brief Allocate the frame buffer in PSRAM, the bounce buffers are refilled from it.
+ *
+ * With `fb_pixel_size` 1, the frame buffer holds palette indices, `example_palette_init()` must be called first.
+ *
+ * @note  The panel has to be created with `no_fb` and `bounce_buffer_size_px` = `size_px`,
+ *        with `example_bounce_on_empty()` registered as `on_bounce_empty` callback.
+ *
+ * @param[in] config  Panel timing
+ * @param[in] size_px Size of one bounce buffer, usually from `example_bounce_calc_size_px()`
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_NO_MEM: No PSRAM for the frame buffer
+ */
+esp_err_t example_bounce_init(const example_bounce_config_t *config, uint32_t size_px);
+
+/**
+ * @brief Copy a rendered area into the frame buffer, mapped to palette indices for an indexed frame buffer.
+ */
+void example_bounce_draw(const lv_area_t *area, const uint8_t *px_map);
+
+/**
+ * @brief Get the frame buffer the bounce buffers are refilled from, for callers that draw into it themselves.
+ */
+uint8_t *example_bounce_get_fb(void);
+
+/**
+ * @brief Refill a bounce buffer from the frame buffer, expanding palette indices, and check it was done in time (ISR context).
+ */
+bool example_bounce_on_empty(esp_lcd_panel_handle_t panel, void *bounce_buf, int pos_px, int len_bytes, void *user_ctx);
+
+/**
+ * @brief Account a refill of the bounce buffer at `pos_px`, done by the caller, and check it was done in time.
+ *
+ * The scan-out is modelled from the panel timing, anchored on the refills of the frame before, so a refill is late
+ * when it ends after the DMA starts reading its buffer. The refills right after the vertical blanking are checked too.
+ * The anchor is as late as the shortest refill latency of the frame before, a refill late by less goes unnoticed.
+ *
+ * @param[in] pos_px   Position of the refilled buffer in the frame
+ * @param[in] start_us When the refill started
+ * @param[in] end_us   When the refill ended
+ */
+void example_bounce_refill_done(int pos_px, int64_t start_us, int64_t end_us);
+
+/**
+ * @brief Get the refill statistics.
+ *
+ * @param[out] stats Statistics since the last reset
+ * @param[in]  reset Clear the counters after reading
+ */
+void example_bounce_get_stats(example_bounce_stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
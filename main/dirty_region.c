@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdatomic.h>
+#include <string.h>
+#include "dirty_region.h"
+
+static example_dirty_config_t s_config;
+
+// written by the LVGL task, read and reset by the monitor task
+static struct {
+    atomic_uint passes;
+    atomic_uint rects_in;
+    atomic_uint rects_out;
+    atomic_uint invalidated_px;
+    atomic_uint rendered_px;
+} s_stats;
+
+static inline uint32_t dirty_rect_size(const example_dirty_rect_t *rect)
+{
+    return (uint32_t)(rect->x2 - rect->x1 + 1) * (uint32_t)(rect->y2 - rect->y1 + 1);
+}
+
+static inline void dirty_rect_union(example_dirty_rect_t *out, const example_dirty_rect_t *a, const example_dirty_rect_t *b)
+{
+    out->x1 = a->x1 < b->x1 ? a->x1 : b->x1;
+    out->y1 = a->y1 < b->y1 ? a->y1 : b->y1;
+    out->x2 = a->x2 > b->x2 ? a->x2 : b->x2;
+    out->y2 = a->y2 > b->y2 ? a->y2 : b->y2;
+}
+
+void example_dirty_init(const example_dirty_config_t *config)
+{
+    s_config = *config;
+    example_dirty_stats_t stats;
+    example_dirty_get_stats(&stats, true);
+}
+
+void example_dirty_snap(example_dirty_rect_t *rect)
+{
+    atomic_fetch_add_explicit(&s_stats.invalidated_px, dirty_rect_size(rect), memory_order_relaxed);
+    // round the corners out to the grid, the right and bottom edges end on the last pixel of a tile
+    rect->x1 -= rect->x1 % s_config.tile_w;
+    rect->y1 -= rect->y1 % s_config.tile_h;
+    rect->x2 += s_config.tile_w - 1 - rect->x2 % s_config.tile_w;
+    rect->y2 += s_config.tile_h - 1 - rect->y2 % s_config.tile_h;
+    if (rect->x2 >= s_config.h_res) {
+        rect->x2 = s_config.h_res - 1;
+    }
+    if (rect->y2 >= s_config.v_res) {
+        rect->y2 = s_config.v_res - 1;
+    }
+}
+
+void example_dirty_merge(example_dirty_rect_t *rects, uint8_t *joined, uint32_t count)
+{
+    uint32_t rects_in = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        rects_in += !joined[i];
+    }
+
+    // Rendering a rectangle costs its pixels plus a fixed overhead (flush call, cache write back, DMA setup).
+    // Overlaps are rendered twice, so two rectangles cost size_a + size_b + 2 * overhead and their union
+    // size_u + overhead. Greedily merge the pair that saves the most until no merge saves anything.
+    uint32_t merged = 0;
+    while (true) {
+        int64_t best_gain = -1;
+        uint32_t best_i = 0;
+        uint32_t best_j = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            if (joined[i]) {
+                continue;
+            }
+            uint32_t size_i = dirty_rect_size(&rects[i]);
+            for (uint32_t j = i + 1; j < count; j++) {
+                if (joined[j]) {
+                    continue;
+                }
+                example_dirty_rect_t u;
+                dirty_rect_union(&u, &rects[i], &rects[j]);
+                int64_t gain = (int64_t)size_i + dirty_rect_size(&rects[j]) + s_config.rect_cost_px - dirty_rect_size(&u);
+                if (gain > best_gain) {
+                    best_gain = gain;
+                    best_i = i;
+                    best_j = j;
+                }
+            }
+        }
+        if (best_gain < 0) {
+            break;
+        }
+        // keep the union in the later one
+        dirty_rect_union(&rects[best_j], &rects[best_i], &rects[best_j]);
+        joined[best_i] = 1;
+        merged++;
+    }
+
+    uint32_t rendered_px = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!joined[i]) {
+            rendered_px += dirty_rect_size(&rects[i]);
+        }
+    }
+    atomic_fetch_add_explicit(&s_stats.passes, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&s_stats.rects_in, rects_in, memory_order_relaxed);
+    atomic_fetch_add_explicit(&s_stats.rects_out, rects_in - merged, memory_order_relaxed);
+    atomic_fetch_add_explicit(&s_stats.rendered_px, rendered_px, memory_order_relaxed);
+}
+
+void example_dirty_get_stats(example_dirty_stats_t *stats, bool reset)
+{
+    if (reset) {
+        stats->passes = atomic_exchange_explicit(&s_stats.passes, 0, memory_order_relaxed);
+        stats->rects_in = atomic_exchange_explicit(&s_stats.rects_in, 0, memory_order_relaxed);
+        stats->rects_out = atomic_exchange_explicit(&s_stats.rects_out, 0, memory_order_relaxed);
+        stats->invalidated_px = atomic_exchange_explicit(&s_stats.invalidated_px, 0, memory_order_relaxed);
+        stats->rendered_px = atomic_exchange_explicit(&s_stats.rendered_px, 0, memory_order_relaxed);
+    } else {
+        stats->passes = atomic_load_explicit(&s_stats.passes, memory_order_relaxed);
+        stats->rects_in = atomic_load_explicit(&s_stats.rects_in, memory_order_relaxed);
+        stats->rects_out = atomic_load_explicit(&s_stats.rects_out, memory_order_relaxed);
+        stats->invalidated_px = atomic_load_explicit(&s_stats.invalidated_px, memory_order_relaxed);
+        stats->rendered_px = atomic_load_explicit(&s_stats.rendered_px, memory_order_relaxed);
+    }
+}
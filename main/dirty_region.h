@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Rectangle with inclusive corners, same layout as `lv_area_t`.
+ */
+typedef struct {
+    int32_t x1;
+    int32_t y1;
+    int32_t x2;
+    int32_t y2;
+} example_dirty_rect_t;
+
+typedef struct {
+    int32_t h_res;          /*!< Display resolution, snapped rectangles are clipped to it */
+    int32_t v_res;
+    uint32_t tile_w;        /*!< Grid the rectangles are snapped to, in pixels */
+    uint32_t tile_h;
+    uint32_t rect_cost_px;  /*!< Fixed cost of rendering and flushing one more rectangle, in pixels */
+} example_dirty_config_t;
+
+typedef struct {
+    uint32_t passes;            /*!< Merge passes, one per refresh */
+    uint32_t rects_in;          /*!< Rectangles before merging */
+    uint32_t rects_out;         /*!< Rectangles left after merging */
+    uint32_t invalidated_px;    /*!< Pixels invalidated, before snapping */
+    uint32_t rendered_px;       /*!< Pixels left to render after snapping and merging */
+} example_dirty_stats_t;
+
+/**
+ * @brief Set the tile grid and the cost model, reset the statistics.
+ */
+void example_dirty_init(const example_dirty_config_t *config);
+
+/**
+ * @brief Grow a rectangle to the tile grid, clipped to the display.
+ */
+void example_dirty_snap(example_dirty_rect_t *rect);
+
+/**
+ * @brief Merge rectangles as long as rendering the union costs less than rendering both.
+ *
+ * Merged rectangles are flagged in `joined`, entries already flagged are skipped. The union is kept
+ * in the later of the two, so the last rectangle not joined stays the last one.
+ *
+ * @param[inout] rects  Rectangles
+ * @param[inout] joined Non-zero for rectangles to skip, one per rectangle
+ * @param[in]    count  Number of rectangles
+ */
+void example_dirty_merge(example_dirty_rect_t *rects, uint8_t *joined, uint32_t count);
+
+/**
+ * @brief Get the statistics collected since the last reset.
+ */
+void example_dirty_get_stats(example_dirty_stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <string.h>
+#include "soc/soc_caps.h"
+#include "esp_check.h"
+#include "esp_cache.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "display_rotate.h"
+#if SOC_PPA_SUPPORTED
+#include "driver/ppa.h"
+#endif
+
+static const char *TAG = "rotate";
+
+static struct {
+    example_rotate_config_t config;
+    uint32_t stride;
+#if SOC_PPA_SUPPORTED
+    ppa_client_handle_t ppa;
+    ppa_srm_color_mode_t ppa_cm;
+#endif
+} s_rotate;
+
+#if SOC_PPA_SUPPORTED
+// the PPA rotates counterclockwise
+static const ppa_srm_rotation_angle_t s_ppa_angle[] = {
+    [EXAMPLE_BLIT_ROTATE_0] = PPA_SRM_ROTATION_ANGLE_0,
+    [EXAMPLE_BLIT_ROTATE_90] = PPA_SRM_ROTATION_ANGLE_270,
+    [EXAMPLE_BLIT_ROTATE_180] = PPA_SRM_ROTATION_ANGLE_180,
+    [EXAMPLE_BLIT_ROTATE_270] = PPA_SRM_ROTATION_ANGLE_90,
+};
+
+static esp_err_t rotate_ppa_init(void)
+{
+    const example_rotate_config_t *config = &s_rotate.config;
+    if (config->pixel_size == 2) {
+        s_rotate.ppa_cm = PPA_SRM_COLOR_MODE_RGB565;
+    } else if (config->pixel_size == 3) {
+        s_rotate.ppa_cm = PPA_SRM_COLOR_MODE_RGB888;
+    } else {
+        return ESP_OK;
+    }
+    // the PPA writes whole cache lines of the output buffer
+    size_t cache_line = 0;
+    ESP_RETURN_ON_ERROR(esp_cache_get_alignment(MALLOC_CAP_SPIRAM, &cache_line), TAG, "get cache alignment failed");
+    if (cache_line && (((uintptr_t)config->fb | (s_rotate.stride * config->v_res)) & (cache_line - 1))) {
+        ESP_LOGW(TAG, "frame buffer not cache line aligned, can't use the PPA");
+        return ESP_OK;
+    }
+    ppa_client_config_t ppa_config = {
+        .oper_type = PPA_OPERATION_SRM,
+        .max_pending_trans_num = 1,
+    };
+    return ppa_register_client(&ppa_config, &s_rotate.ppa);
+}
+#endif
+
+esp_err_t example_rotate_init(const example_rotate_config_t *config)
+{
+    memset(&s_rotate, 0, sizeof(s_rotate));
+    s_rotate.config = *config;
+    s_rotate.stride = config->h_res * config->pixel_size;
+    const char *engine = "CPU";
+#if SOC_PPA_SUPPORTED
+    ESP_RETURN_ON_ERROR(rotate_ppa_init(), TAG, "register PPA client failed");
+    if (s_rotate.ppa) {
+        engine = "PPA";
+    }
+#endif
+    ESP_LOGI(TAG, "rotate %d degrees by %s", config->rotation * 90, engine);
+    return ESP_OK;
+}
+
+void example_rotate_area(const lv_area_t *area, lv_area_t *fb_area)
+{
+    // LVGL resolution, swapped for 90 and 270 degrees
+    bool quarter = s_rotate.config.rotation == EXAMPLE_BLIT_ROTATE_90 || s_rotate.config.rotation == EXAMPLE_BLIT_ROTATE_270;
+    int32_t ui_w = quarter ? s_rotate.config.v_res : s_rotate.config.h_res;
+    int32_t ui_h = quarter ? s_rotate.config.h_res : s_rotate.config.v_res;
+    switch (s_rotate.config.rotation) {
+    case EXAMPLE_BLIT_ROTATE_90:
+        lv_area_set(fb_area, ui_h - 1 - area->y2, area->x1, ui_h - 1 - area->y1, area->x2);
+        break;
+    case EXAMPLE_BLIT_ROTATE_180:
+        lv_area_set(fb_area, ui_w - 1 - area->x2, ui_h - 1 - area->y2, ui_w - 1 - area->x1, ui_h - 1 - area->y1);
+        break;
+    case EXAMPLE_BLIT_ROTATE_270:
+        lv_area_set(fb_area, area->y1, ui_w - 1 - area->x2, area->y2, ui_w - 1 - area->x1);
+        break;
+    default:
+        *fb_area = *area;
+        break;
+    }
+}
+
+void example_rotate_draw(const lv_area_t *area, const uint8_t *px_map)
+{
+    const example_rotate_config_t *config = &s_rotate.config;
+    uint32_t w = lv_area_get_width(area);
+    uint32_t h = lv_area_get_height(area);
+    lv_area_t fb_area;
+    example_rotate_area(area, &fb_area);
+
+#if SOC_PPA_SUPPORTED
+    if (s_rotate.ppa) {
+        ppa_srm_oper_config_t srm = {
+            .in = {
+                .buffer = px_map,
+                .pic_w = w,
+                .pic_h = h,
+                .block_w = w,
+                .block_h = h,
+                .srm_cm = s_rotate.ppa_cm,
+            },
+            .out = {
+                .buffer = config->fb,
+                .buffer_size = s_rotate.stride * config->v_res,
+                .pic_w = config->h_res,
+                .pic_h = config->v_res,
+                .block_offset_x = fb_area.x1,
+                .block_offset_y = fb_area.y1,
+                .srm_cm = s_rotate.ppa_cm,
+            },
+            .rotation_angle = s_ppa_angle[config->rotation],
+            .scale_x = 1.0f,
+            .scale_y = 1.0f,
+            .mode = PPA_TRANS_MODE_BLOCKING,
+        };
+        // the driver writes the input back from the cache and drops the output from it
+        if (ppa_do_scale_rotate_mirror(s_rotate.ppa, &srm) == ESP_OK) {
+            return;
+        }
+    }
+#endif
+
+    // tiled transpose, see example_blit_rotate()
+    uint8_t *fb_line = config->fb + fb_area.y1 * s_rotate.stride;
+    example_blit_rotate(fb_line + fb_area.x1 * config->pixel_size, s_rotate.stride, px_map, w * config->pixel_size,
+                        w, h, config->pixel_size, config->rotation);
+    if (config->dma_reads_fb) {
+        esp_cache_msync(fb_line, lv_area_get_height(&fb_area) * s_rotate.stride,
+                        ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "lvgl.h"
+#include "blit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Frame buffer of the panel and how the LVGL display sits on it.
+ */
+typedef struct {
+    uint8_t *fb;                        /*!< Frame buffer, in panel orientation */
+    uint32_t h_res;                     /*!< Panel resolution */
+    uint32_t v_res;
+    uint32_t pixel_size;                /*!< Bytes per pixel */
+    example_blit_rotation_t rotation;   /*!< Clockwise rotation of the LVGL display on the panel */
+    bool dma_reads_fb;                  /*!< The LCD DMA scans the frame buffer, write the cache back after drawing */
+} example_rotate_config_t;
+
+/**
+ * @brief Set up the rotated flush, using the PPA when the target has one.
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - Others: PPA client could not be registered
+ */
+esp_err_t example_rotate_init(const example_rotate_config_t *config);
+
+/**
+ * @brief Map an area of the LVGL display to the frame buffer.
+ *
+ * @param[in]  area    Area in LVGL coordinates
+ * @param[out] fb_area Same pixels in frame buffer coordinates
+ */
+void example_rotate_area(const lv_area_t *area, lv_area_t *fb_area);
+
+/**
+ * @brief Rotate a rendered area into the frame buffer.
+ *
+ * @param[in] area   Area in LVGL coordinates
+ * @param[in] px_map Rendered pixels of the area
+ */
+void example_rotate_draw(const lv_area_t *area, const uint8_t *px_map);
+
+#ifdef __cplusplus
+}
+#endif
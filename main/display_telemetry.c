@@ -0,0 +1,165 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <inttypes.h>
+#include <stdatomic.h>
+#include "display_telemetry.h"
+
+#if CONFIG_EXAMPLE_ENABLE_DISPLAY_TELEMETRY
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "telemetry";
+
+// sum and maximum of one metric, updated lock-free from tasks and ISRs
+typedef struct {
+    atomic_uint count;
+    atomic_uint sum;
+    atomic_uint max;
+} telemetry_metric_t;
+
+static telemetry_metric_t s_render;
+static telemetry_metric_t s_flush;
+static telemetry_metric_t s_flush_wait;
+static telemetry_metric_t s_isr;
+static telemetry_metric_t s_area;
+static telemetry_metric_t s_lock;
+
+static float s_panel_refresh_hz;
+static int64_t s_period_start_us;
+static int64_t s_render_start_us;   // LVGL task only
+static uint32_t s_frame_area;       // LVGL task only
+static int64_t s_lock_start_us;     // written by the lock holder only
+static volatile int64_t s_flush_start_us;
+
+static void IRAM_ATTR telemetry_metric_add(telemetry_metric_t *metric, uint32_t value)
+{
+    atomic_fetch_add_explicit(&metric->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&metric->sum, value, memory_order_relaxed);
+    unsigned max = atomic_load_explicit(&metric->max, memory_order_relaxed);
+    while (value > max &&
+            !atomic_compare_exchange_weak_explicit(&metric->max, &max, value, memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+static void telemetry_metric_take(telemetry_metric_t *metric, uint32_t *count, uint32_t *sum, uint32_t *max, bool reset)
+{
+    if (reset) {
+        *count = atomic_exchange_explicit(&metric->count, 0, memory_order_relaxed);
+        *sum = atomic_exchange_explicit(&metric->sum, 0, memory_order_relaxed);
+        *max = atomic_exchange_explicit(&metric->max, 0, memory_order_relaxed);
+    } else {
+        *count = atomic_load_explicit(&metric->count, memory_order_relaxed);
+        *sum = atomic_load_explicit(&metric->sum, memory_order_relaxed);
+        *max = atomic_load_explicit(&metric->max, memory_order_relaxed);
+    }
+}
+
+static void telemetry_render_event_cb(lv_event_t *e)
+{
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_START) {
+        s_render_start_us = esp_timer_get_time();
+        s_frame_area = 0;
+    } else {
+        telemetry_metric_add(&s_render, (uint32_t)(esp_timer_get_time() - s_render_start_us));
+        telemetry_metric_add(&s_area, s_frame_area);
+    }
+}
+
+void example_telemetry_init(lv_display_t *disp, float panel_refresh_hz)
+{
+    s_panel_refresh_hz = panel_refresh_hz;
+    s_period_start_us = esp_timer_get_time();
+    lv_display_add_event_cb(disp, telemetry_render_event_cb, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(disp, telemetry_render_event_cb, LV_EVENT_RENDER_READY, NULL);
+}
+
+void example_telemetry_flush_start(const lv_area_t *area)
+{
+    s_frame_area += lv_area_get_size(area);
+    s_flush_start_us = esp_timer_get_time();
+}
+
+void IRAM_ATTR example_telemetry_flush_done(int64_t isr_enter_us)
+{
+    telemetry_metric_add(&s_flush, (uint32_t)(isr_enter_us - s_flush_start_us));
+    telemetry_metric_add(&s_isr, (uint32_t)(esp_timer_get_time() - isr_enter_us));
+}
+
+void example_telemetry_flush_wait(uint32_t wait_us)
+{
+    telemetry_metric_add(&s_flush_wait, wait_us);
+}
+
+void example_telemetry_lock_acquired(void)
+{
+    s_lock_start_us = esp_timer_get_time();
+}
+
+void example_telemetry_lock_released(void)
+{
+    telemetry_metric_add(&s_lock, (uint32_t)(esp_timer_get_time() - s_lock_start_us));
+}
+
+void example_telemetry_get_report(example_telemetry_report_t *report, bool reset)
+{
+    uint32_t count, sum, max;
+    int64_t now = esp_timer_get_time();
+    uint32_t period_us = (uint32_t)(now - s_period_start_us);
+    if (reset) {
+        s_period_start_us = now;
+    }
+
+    report->period_ms = period_us / 1000;
+    report->panel_refresh_hz = s_panel_refresh_hz;
+
+    telemetry_metric_take(&s_render, &count, &sum, &max, reset);
+    report->frames = count;
+    report->fps = period_us ? count * 1e6f / period_us : 0;
+    report->render_avg_us = count ? sum / count : 0;
+    report->render_max_us = max;
+
+    telemetry_metric_take(&s_area, &count, &sum, &max, reset);
+    report->area_avg_px = count ? sum / count : 0;
+    report->area_max_px = max;
+
+    // flush time is reported per frame, summed over the areas flushed in it
+    telemetry_metric_take(&s_flush, &count, &sum, &max, reset);
+    report->flush_avg_us = report->frames ? sum / report->frames : 0;
+    report->flush_max_us = max;
+    report->flushes = count;
+
+    telemetry_metric_take(&s_flush_wait, &count, &sum, &max, reset);
+    report->flush_waits = count;
+    report->flush_wait_avg_us = count ? sum / count : 0;
+    report->flush_wait_max_us = max;
+
+    telemetry_metric_take(&s_isr, &count, &sum, &max, reset);
+    report->isr_avg_us = count ? sum / count : 0;
+    report->isr_max_us = max;
+
+    telemetry_metric_take(&s_lock, &count, &sum, &max, reset);
+    report->lock_hold_avg_us = count ? sum / count : 0;
+    report->lock_hold_max_us = max;
+    report->lvgl_busy_pct = period_us ? (uint32_t)((uint64_t)sum * 100 / period_us) : 0;
+}
+
+void example_telemetry_publish(void)
+{
+    example_telemetry_report_t report;
+    example_telemetry_get_report(&report, true);
+    ESP_LOGI(TAG, "%"PRIu32" frames in %"PRIu32" ms, %.1f fps (panel %.1f Hz), lvgl busy %"PRIu32"%%",
+             report.frames, report.period_ms, report.fps, report.panel_refresh_hz, report.lvgl_busy_pct);
+    ESP_LOGI(TAG, "render avg %"PRIu32" max %"PRIu32" us, flush avg %"PRIu32" max %"PRIu32" us, isr avg %"PRIu32" max %"PRIu32" us",
+             report.render_avg_us, report.render_max_us, report.flush_avg_us, report.flush_max_us,
+             report.isr_avg_us, report.isr_max_us);
+    ESP_LOGI(TAG, "area avg %"PRIu32" max %"PRIu32" px, lock hold avg %"PRIu32" max %"PRIu32" us",
+             report.area_avg_px, report.area_max_px, report.lock_hold_avg_us, report.lock_hold_max_us);
+    ESP_LOGI(TAG, "render waited for flush %"PRIu32" of %"PRIu32" flushes, avg %"PRIu32" max %"PRIu32" us",
+             report.flush_waits, report.flushes, report.flush_wait_avg_us, report.flush_wait_max_us);
+}
+#endif // CONFIG_EXAMPLE_ENABLE_DISPLAY_TELEMETRY
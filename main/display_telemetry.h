@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdkconfig.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Display pipeline statistics over one publishing period.
+ */
+typedef struct {
+    uint32_t period_ms;         /*!< Length of the period */
+    uint32_t frames;            /*!< Frames rendered in the period */
+    float fps;                  /*!< Achieved frame rate */
+    float panel_refresh_hz;     /*!< Scan-out rate of the panel, from the RGB timing */
+    uint32_t render_avg_us;     /*!< Render start to render ready, per frame */
+    uint32_t render_max_us;
+    uint32_t flush_avg_us;      /*!< Flush callback to flush done, summed per frame */
+    uint32_t flush_max_us;      /*!< Longest single flush */
+    uint32_t flushes;           /*!< Areas flushed in the period */
+    uint32_t flush_waits;       /*!< Times LVGL had to wait for a flush to finish before reusing a draw buffer */
+    uint32_t flush_wait_avg_us; /*!< Per wait */
+    uint32_t flush_wait_max_us;
+    uint32_t isr_avg_us;        /*!< Time spent in the flush done callback, per call */
+    uint32_t isr_max_us;
+    uint32_t area_avg_px;       /*!< Flushed area, per frame */
+    uint32_t area_max_px;
+    uint32_t lock_hold_avg_us;  /*!< `lvgl_api_lock` hold time, per acquisition */
+    uint32_t lock_hold_max_us;
+    uint32_t lvgl_busy_pct;     /*!< Share of the period the LVGL lock was held */
+} example_telemetry_report_t;
+
+#if CONFIG_EXAMPLE_ENABLE_DISPLAY_TELEMETRY
+/**
+ * @brief Start collecting frame statistics of a display.
+ *
+ * @param[in] disp             LVGL display to watch
+ * @param[in] panel_refresh_hz Scan-out rate of the panel, reported next to the achieved FPS
+ */
+void example_telemetry_init(lv_display_t *disp, float panel_refresh_hz);
+
+/**
+ * @brief Call from the flush callback, before handing the area to the panel.
+ */
+void example_telemetry_flush_start(const lv_area_t *area);
+
+/**
+ * @brief Call from the flush done callback (ISR context).
+ *
+ * @param[in] isr_enter_us `esp_timer_get_time()` taken when the callback was entered
+ */
+void example_telemetry_flush_done(int64_t isr_enter_us);
+
+/**
+ * @brief Call from the flush wait callback when LVGL had to block for a flush.
+ *
+ * @param[in] wait_us How long it blocked
+ */
+void example_telemetry_flush_wait(uint32_t wait_us);
+
+/**
+ * @brief Call right after acquiring / before releasing the LVGL API lock.
+ */
+void example_telemetry_lock_acquired(void);
+void example_telemetry_lock_released(void);
+
+/**
+ * @brief Get the statistics collected since the last reset.
+ *
+ * @param[out] report Statistics of the period
+ * @param[in]  reset  Start a new period after reading
+ */
+void example_telemetry_get_report(example_telemetry_report_t *report, bool reset);
+
+/**
+ * @brief Log the statistics of the current period and start a new one.
+ */
+void example_telemetry_publish(void);
+#else
+static inline void example_telemetry_init(lv_display_t *disp, float panel_refresh_hz) {}
+static inline void example_telemetry_flush_start(const lv_area_t *area) {}
+static inline void example_telemetry_flush_done(int64_t isr_enter_us) {}
+static inline void example_telemetry_flush_wait(uint32_t wait_us) {}
+static inline void example_telemetry_lock_acquired(void) {}
+static inline void example_telemetry_lock_released(void) {}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,239 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_attr.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_lcd_panel_ops.h"
+#include "frame_present.h"
+#include "blit.h"
+
+#define PRESENT_MAX_AREAS       16  // more areas fall back to copying the whole screen
+#define PRESENT_TASK_STACK_SIZE (3 * 1024)
+
+static const char *TAG = "present";
+
+typedef struct {
+    lv_area_t areas[PRESENT_MAX_AREAS];
+    uint32_t num;
+    bool full;
+} present_areas_t;
+
+// frame waiting in the ready queue
+typedef struct {
+    uint8_t fb;
+    lv_area_t bbox;     // rows the driver has to write back from the cache
+} present_frame_t;
+
+static struct {
+    esp_lcd_panel_handle_t panel;
+    lv_draw_buf_t bufs[EXAMPLE_PRESENT_MAX_FBS];
+    uint8_t num_fbs;
+    uint32_t stride;
+    uint32_t pixel_size;
+    int32_t hor_res;
+    int32_t ver_res;
+    // owned by the LVGL task
+    uint8_t cur;                    // buffer LVGL draws into
+    uint8_t latest;                 // last buffer LVGL finished
+    bool submitted;                 // `cur` is in the ready queue, a new buffer is needed before drawing
+    present_areas_t frame_dirty;    // areas rendered into `cur` in this frame
+    lv_area_t copied;               // bounding box of what the acquire copied into `cur`
+    bool has_copied;
+    present_areas_t stale[EXAMPLE_PRESENT_MAX_FBS]; // areas each buffer misses compared to `latest`
+    // shared with the present task
+    QueueHandle_t ready_queue;
+    QueueHandle_t free_queue;
+    TaskHandle_t task;
+    volatile bool swap_pending;     // a buffer was handed to the panel, waiting for VSYNC
+} s_present;
+
+static void present_task(void *arg);
+
+esp_err_t example_present_init(lv_display_t *disp, esp_lcd_panel_handle_t panel, void *const *fbs, int num_fbs, int task_prio)
+{
+    ESP_RETURN_ON_FALSE(num_fbs >= 2 && num_fbs <= EXAMPLE_PRESENT_MAX_FBS, ESP_ERR_INVALID_ARG, TAG, "invalid number of frame buffers");
+    lv_color_format_t cf = lv_display_get_color_format(disp);
+
+    memset(&s_present, 0, sizeof(s_present));
+    s_present.panel = panel;
+    s_present.num_fbs = num_fbs;
+    s_present.hor_res = lv_display_get_horizontal_resolution(disp);
+    s_present.ver_res = lv_display_get_vertical_resolution(disp);
+    s_present.pixel_size = lv_color_format_get_size(cf);
+    // the panel frame buffers have no line padding
+    s_present.stride = s_present.hor_res * s_present.pixel_size;
+    uint32_t fb_size = s_present.stride * s_present.ver_res;
+    for (int i = 0; i < num_fbs; i++) {
+        ESP_RETURN_ON_FALSE(lv_draw_buf_init(&s_present.bufs[i], s_present.hor_res, s_present.ver_res, cf,
+                                             s_present.stride, fbs[i], fb_size) == LV_RESULT_OK,
+                            ESP_ERR_INVALID_ARG, TAG, "frame buffer %d not usable as draw buffer", i);
+    }
+
+    s_present.ready_queue = xQueueCreate(num_fbs - 1, sizeof(present_frame_t));
+    s_present.free_queue = xQueueCreate(num_fbs, sizeof(uint8_t));
+    ESP_RETURN_ON_FALSE(s_present.ready_queue && s_present.free_queue, ESP_ERR_NO_MEM, TAG, "no mem for queues");
+    // the panel scans out fbs[0] after initialization, LVGL starts in fbs[1], the others are free
+    for (uint8_t i = 2; i < num_fbs; i++) {
+        xQueueSend(s_present.free_queue, &i, 0);
+    }
+    s_present.cur = 1;
+    s_present.latest = 0;
+    ESP_RETURN_ON_FALSE(xTaskCreate(present_task, "present", PRESENT_TASK_STACK_SIZE, NULL, task_prio, &s_present.task) == pdPASS,
+                        ESP_ERR_NO_MEM, TAG, "create present task failed");
+
+    lv_display_set_draw_buffers(disp, &s_present.bufs[s_present.cur], NULL);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
+
+    ESP_LOGI(TAG, "%d frame buffers x %"PRIu32" bytes = %"PRIu32" KB, %d frame ready queue, free PSRAM %zu KB, free internal %zu KB",
+             num_fbs, fb_size, num_fbs * fb_size / 1024, num_fbs - 1,
+             heap_caps_get_free_size(MALLOC_CAP_SPIRAM) / 1024, heap_caps_get_free_size(MALLOC_CAP_INTERNAL) / 1024);
+    return ESP_OK;
+}
+
+static void present_join(lv_area_t *bbox, bool *valid, const lv_area_t *area)
+{
+    if (!*valid) {
+        *bbox = *area;
+        *valid = true;
+        return;
+    }
+    bbox->x1 = LV_MIN(bbox->x1, area->x1);
+    bbox->y1 = LV_MIN(bbox->y1, area->y1);
+    bbox->x2 = LV_MAX(bbox->x2, area->x2);
+    bbox->y2 = LV_MAX(bbox->y2, area->y2);
+}
+
+static void present_areas_add(present_areas_t *list, const lv_area_t *area)
+{
+    if (list->full) {
+        return;
+    }
+    if (list->num < PRESENT_MAX_AREAS) {
+        list->areas[list->num++] = *area;
+    } else {
+        list->full = true;
+    }
+}
+
+static void present_areas_merge(present_areas_t *list, const present_areas_t *from)
+{
+    if (from->full) {
+        list->full = true;
+        return;
+    }
+    for (uint32_t i = 0; i < from->num; i++) {
+        present_areas_add(list, &from->areas[i]);
+    }
+}
+
+void example_present_flush(const lv_area_t *area, uint8_t *px_map, bool last)
+{
+    present_areas_add(&s_present.frame_dirty, area);
+    if (!last) {
+        return;
+    }
+
+    // every other buffer now misses what this frame changed
+    for (int i = 0; i < s_present.num_fbs; i++) {
+        if (i != s_present.cur) {
+            present_areas_merge(&s_present.stale[i], &s_present.frame_dirty);
+        }
+    }
+
+    // the driver writes the cache back for the given rows, so cover the copied areas as well
+    present_frame_t frame = {
+        .fb = s_present.cur,
+        .bbox = {0, 0, s_present.hor_res - 1, s_present.ver_res - 1},
+    };
+    if (!s_present.frame_dirty.full) {
+        bool valid = s_present.has_copied;
+        frame.bbox = s_present.copied;
+        for (uint32_t i = 0; i < s_present.frame_dirty.num; i++) {
+            present_join(&frame.bbox, &valid, &s_present.frame_dirty.areas[i]);
+        }
+    }
+    memset(&s_present.frame_dirty, 0, sizeof(s_present.frame_dirty));
+    s_present.has_copied = false;
+    s_present.latest = s_present.cur;
+    s_present.submitted = true;
+    // the queue has room for every buffer but the one on screen, this never blocks
+    xQueueSend(s_present.ready_queue, &frame, portMAX_DELAY);
+}
+
+bool IRAM_ATTR example_present_on_vsync(BaseType_t *need_yield)
+{
+    if (!s_present.swap_pending) {
+        return false;
+    }
+    s_present.swap_pending = false;
+    vTaskNotifyGiveFromISR(s_present.task, need_yield);
+    return true;
+}
+
+void example_present_start(void)
+{
+    xTaskNotifyGive(s_present.task);
+}
+
+static void present_task(void *arg)
+{
+    uint8_t front = 0;
+    present_frame_t frame;
+    // the panel may still be initializing while LVGL renders the first frame
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    while (1) {
+        xQueueReceive(s_present.ready_queue, &frame, portMAX_DELAY);
+        esp_lcd_panel_draw_bitmap(s_present.panel, frame.bbox.x1, frame.bbox.y1, frame.bbox.x2 + 1, frame.bbox.y2 + 1,
+                                  s_present.bufs[frame.fb].data);
+        // the driver switches to the new buffer when the next frame starts, the old one is in use until then
+        s_present.swap_pending = true;
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        xQueueSend(s_present.free_queue, &front, portMAX_DELAY);
+        front = frame.fb;
+    }
+}
+
+static void present_copy_area(uint8_t *dst, const uint8_t *src, const lv_area_t *area)
+{
+    uint32_t offset = area->y1 * s_present.stride + area->x1 * s_present.pixel_size;
+    example_blit_copy(dst + offset, s_present.stride, src + offset, s_present.stride,
+                      lv_area_get_width(area) * s_present.pixel_size, lv_area_get_height(area));
+}
+
+void example_present_acquire(lv_display_t *disp)
+{
+    if (!s_present.submitted) {
+        return;
+    }
+    uint8_t fb;
+    xQueueReceive(s_present.free_queue, &fb, portMAX_DELAY);
+
+    uint8_t *dst = s_present.bufs[fb].data;
+    const uint8_t *src = s_present.bufs[s_present.latest].data;
+    present_areas_t *stale = &s_present.stale[fb];
+    if (stale->full) {
+        memcpy(dst, src, s_present.stride * s_present.ver_res);
+        s_present.copied = (lv_area_t) {0, 0, s_present.hor_res - 1, s_present.ver_res - 1};
+        s_present.has_copied = true;
+    } else {
+        for (uint32_t i = 0; i < stale->num; i++) {
+            present_copy_area(dst, src, &stale->areas[i]);
+            present_join(&s_present.copied, &s_present.has_copied, &stale->areas[i]);
+        }
+    }
+    memset(stale, 0, sizeof(*stale));
+
+    s_present.cur = fb;
+    s_present.submitted = false;
+    lv_display_set_draw_buffers(disp, &s_present.bufs[fb], NULL);
+}
@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+#include "esp_lcd_types.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EXAMPLE_PRESENT_MAX_FBS    3
+
+/**
+ * @brief Let LVGL render into the panel frame buffers in direct mode, and swap them only at VSYNC.
+ *
+ * LVGL is given one frame buffer at a time. When the last area of a frame is flushed, the buffer is put
+ * into a ready queue and a present task hands it to the panel, the swap being confirmed by the next VSYNC.
+ * With three frame buffers LVGL can render frame N+2 while N is scanned out and N+1 waits for VSYNC.
+ * Before LVGL draws into a buffer, the areas it misses are copied from the newest frame, so only the
+ * newly invalidated areas have to be rendered.
+ *
+ * @param[in] disp      LVGL display, its resolution and color format must match the frame buffers
+ * @param[in] panel     RGB panel owning the frame buffers
+ * @param[in] fbs       Frame buffers, `fbs[0]` is the one scanned out by the panel after initialization
+ * @param[in] num_fbs   Number of frame buffers, 2 or 3
+ * @param[in] task_prio Priority of the present task, should be higher than the LVGL task
+ * @return
+ *      - ESP_OK: LVGL draws into `fbs[1]` from now on
+ *      - ESP_ERR_INVALID_ARG: The frame buffers can't be used as LVGL draw buffers
+ *      - ESP_ERR_NO_MEM: Out of memory for the queues or the present task
+ */
+esp_err_t example_present_init(lv_display_t *disp, esp_lcd_panel_handle_t panel, void *const *fbs, int num_fbs, int task_prio);
+
+/**
+ * @brief Let the present task hand frames to the panel, call once the panel is initialized.
+ *
+ * @note  LVGL can render and queue the first frame before, it is presented after this call.
+ */
+void example_present_start(void);
+
+/**
+ * @brief Call from the flush callback with every area LVGL rendered.
+ *
+ * @note  The area can be reported as flushed right away, the frame buffer is handed over to the present task
+ *        with the last area of the frame.
+ *
+ * @param[in] area   Area rendered into the frame buffer
+ * @param[in] px_map Frame buffer
+ * @param[in] last   The area is the last one of the frame
+ */
+void example_present_flush(const lv_area_t *area, uint8_t *px_map, bool last);
+
+/**
+ * @brief Call from the RGB panel VSYNC callback (ISR context).
+ *
+ * @param[out] need_yield Set to pdTRUE if the present task was woken up
+ * @return true if a new frame is on screen
+ */
+bool example_present_on_vsync(BaseType_t *need_yield);
+
+/**
+ * @brief Give LVGL a free frame buffer, brought up to date with the newest frame.
+ *
+ * @note  Call from the LVGL task before rendering starts. Blocks while all other frame buffers are
+ *        waiting for or being scanned out.
+ */
+void example_present_acquire(lv_display_t *disp);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,238 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+#include "latency_trace.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+#include "esp_log.h"
+static const char *TAG = "trace";
+#define TRACE_LOG(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#else
+#include <stdio.h>
+#define IRAM_ATTR
+#define TRACE_LOG(fmt, ...) printf(fmt "\n", ##__VA_ARGS__)
+#endif
+
+#define TRACE_RING_SIZE         512 // must be a power of 2
+#define TRACE_MAX_OPEN_CHAINS   8
+
+// log-linear histogram: values below 8us are exact, above that each octave is split into 8 buckets (<12.5% error)
+#define TRACE_SUB_BUCKET_BITS   3
+#define TRACE_SUB_BUCKETS       (1 << TRACE_SUB_BUCKET_BITS)
+#define TRACE_MAX_OCTAVE        24  // up to ~16 s
+#define TRACE_NUM_BUCKETS       ((TRACE_MAX_OCTAVE - TRACE_SUB_BUCKET_BITS + 1) * TRACE_SUB_BUCKETS)
+
+typedef struct {
+    atomic_uint seq;    // ring index + 1 once the slot is written
+    uint32_t timestamp_us;
+    uint8_t stage;
+} trace_slot_t;
+
+typedef struct {
+    bool used;
+    uint8_t next_stage;
+    uint32_t opened;    // chain number, to evict the oldest one
+    uint32_t timestamp_us[EXAMPLE_TRACE_STAGE_NUM];
+} trace_chain_t;
+
+typedef struct {
+    uint32_t buckets[TRACE_NUM_BUCKETS];
+    uint32_t count;
+    uint32_t max_us;
+} trace_histogram_t;
+
+static trace_slot_t s_ring[TRACE_RING_SIZE];
+static atomic_uint s_head;
+static uint32_t s_tail;
+static uint32_t s_dropped;
+
+static trace_chain_t s_chains[TRACE_MAX_OPEN_CHAINS];
+static uint32_t s_chain_count;
+static trace_histogram_t s_hist[EXAMPLE_TRACE_INTERVAL_NUM];
+
+static const char *s_interval_names[EXAMPLE_TRACE_INTERVAL_NUM] = {
+    [EXAMPLE_TRACE_WAIT_LVGL] = "touch->lvgl",
+    [EXAMPLE_TRACE_WAIT_INDEV] = "lvgl->indev",
+    [EXAMPLE_TRACE_RENDER] = "indev->flush",
+    [EXAMPLE_TRACE_FLUSH_TIME] = "flush->done",
+    [EXAMPLE_TRACE_TOTAL] = "touch->photon",
+};
+
+void IRAM_ATTR example_trace_record_at(example_trace_stage_t stage, uint32_t timestamp_us)
+{
+    uint32_t idx = atomic_fetch_add_explicit(&s_head, 1, memory_order_relaxed);
+    trace_slot_t *slot = &s_ring[idx & (TRACE_RING_SIZE - 1)];
+    slot->timestamp_us = timestamp_us;
+    slot->stage = (uint8_t)stage;
+    atomic_store_explicit(&slot->seq, idx + 1, memory_order_release);
+}
+
+static uint32_t trace_bucket_index(uint32_t value)
+{
+    if (value < TRACE_SUB_BUCKETS) {
+        return value;
+    }
+    uint32_t msb = 31 - __builtin_clz(value);
+    uint32_t sub = (value >> (msb - TRACE_SUB_BUCKET_BITS)) & (TRACE_SUB_BUCKETS - 1);
+    uint32_t idx = (msb - TRACE_SUB_BUCKET_BITS + 1) * TRACE_SUB_BUCKETS + sub;
+    return idx < TRACE_NUM_BUCKETS ? idx : TRACE_NUM_BUCKETS - 1;
+}
+
+static uint32_t trace_bucket_lower(uint32_t idx)
+{
+    if (idx < TRACE_SUB_BUCKETS) {
+        return idx;
+    }
+    uint32_t msb = idx / TRACE_SUB_BUCKETS + TRACE_SUB_BUCKET_BITS - 1;
+    uint32_t sub = idx % TRACE_SUB_BUCKETS;
+    return (TRACE_SUB_BUCKETS + sub) << (msb - TRACE_SUB_BUCKET_BITS);
+}
+
+static void trace_histogram_add(trace_histogram_t *hist, uint32_t value)
+{
+    hist->buckets[trace_bucket_index(value)]++;
+    hist->count++;
+    if (value > hist->max_us) {
+        hist->max_us = value;
+    }
+}
+
+static uint32_t trace_histogram_percentile(const trace_histogram_t *hist, uint32_t percent)
+{
+    if (hist->count == 0) {
+        return 0;
+    }
+    uint32_t target = (uint32_t)(((uint64_t)hist->count * percent + 99) / 100);
+    uint32_t seen = 0;
+    for (uint32_t i = 0; i < TRACE_NUM_BUCKETS; i++) {
+        seen += hist->buckets[i];
+        if (seen >= target) {
+            // report the bucket's upper bound, but never above the exact maximum
+            uint32_t upper = (i + 1 < TRACE_NUM_BUCKETS) ? trace_bucket_lower(i + 1) - 1 : hist->max_us;
+            return upper < hist->max_us ? upper : hist->max_us;
+        }
+    }
+    return hist->max_us;
+}
+
+static void trace_chain_complete(const trace_chain_t *chain)
+{
+    const uint32_t *ts = chain->timestamp_us;
+    trace_histogram_add(&s_hist[EXAMPLE_TRACE_WAIT_LVGL], ts[EXAMPLE_TRACE_LVGL_HANDLER] - ts[EXAMPLE_TRACE_TOUCH_READ]);
+    trace_histogram_add(&s_hist[EXAMPLE_TRACE_WAIT_INDEV], ts[EXAMPLE_TRACE_INDEV_READ] - ts[EXAMPLE_TRACE_LVGL_HANDLER]);
+    trace_histogram_add(&s_hist[EXAMPLE_TRACE_RENDER], ts[EXAMPLE_TRACE_FLUSH] - ts[EXAMPLE_TRACE_INDEV_READ]);
+    trace_histogram_add(&s_hist[EXAMPLE_TRACE_FLUSH_TIME], ts[EXAMPLE_TRACE_FLUSH_DONE] - ts[EXAMPLE_TRACE_FLUSH]);
+    trace_histogram_add(&s_hist[EXAMPLE_TRACE_TOTAL], ts[EXAMPLE_TRACE_FLUSH_DONE] - ts[EXAMPLE_TRACE_TOUCH_READ]);
+}
+
+static void trace_handle_event(uint8_t stage, uint32_t timestamp_us)
+{
+    if (stage >= EXAMPLE_TRACE_STAGE_NUM) {
+        return;
+    }
+    if (stage == EXAMPLE_TRACE_TOUCH_READ) {
+        // every touch frame opens a chain, evict the oldest one if all are busy
+        trace_chain_t *chain = &s_chains[0];
+        for (int i = 0; i < TRACE_MAX_OPEN_CHAINS; i++) {
+            if (!s_chains[i].used) {
+                chain = &s_chains[i];
+                break;
+            }
+            if (s_chains[i].opened < chain->opened) {
+                chain = &s_chains[i];
+            }
+        }
+        chain->used = true;
+        chain->opened = s_chain_count++;
+        chain->next_stage = EXAMPLE_TRACE_TOUCH_READ + 1;
+        chain->timestamp_us[EXAMPLE_TRACE_TOUCH_READ] = timestamp_us;
+        return;
+    }
+    // any other trace point advances every chain waiting for it
+    for (int i = 0; i < TRACE_MAX_OPEN_CHAINS; i++) {
+        trace_chain_t *chain = &s_chains[i];
+        if (!chain->used || chain->next_stage != stage ||
+                (int32_t)(timestamp_us - chain->timestamp_us[stage - 1]) < 0) {
+            continue;
+        }
+        chain->timestamp_us[stage] = timestamp_us;
+        chain->next_stage++;
+        if (chain->next_stage == EXAMPLE_TRACE_STAGE_NUM) {
+            trace_chain_complete(chain);
+            chain->used = false;
+        }
+    }
+}
+
+void example_trace_process(void)
+{
+    uint32_t head = atomic_load_explicit(&s_head, memory_order_acquire);
+    if (head - s_tail > TRACE_RING_SIZE) {
+        s_dropped += head - s_tail - TRACE_RING_SIZE;
+        s_tail = head - TRACE_RING_SIZE;
+    }
+    while (s_tail != head) {
+        trace_slot_t *slot = &s_ring[s_tail & (TRACE_RING_SIZE - 1)];
+        uint32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        if (seq != s_tail + 1) {
+            if ((int32_t)(seq - (s_tail + 1)) < 0) {
+                break; // still being written, pick it up next time
+            }
+            s_dropped++; // overwritten by a newer lap
+            s_tail++;
+            continue;
+        }
+        uint8_t stage = slot->stage;
+        uint32_t timestamp_us = slot->timestamp_us;
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&slot->seq, memory_order_relaxed) != seq) {
+            s_dropped++;
+            s_tail++;
+            continue;
+        }
+        trace_handle_event(stage, timestamp_us);
+        s_tail++;
+    }
+}
+
+void example_trace_get_stats(example_trace_interval_t interval, example_trace_stats_t *stats)
+{
+    const trace_histogram_t *hist = &s_hist[interval];
+    stats->count = hist->count;
+    stats->p50_us = trace_histogram_percentile(hist, 50);
+    stats->p99_us = trace_histogram_percentile(hist, 99);
+    stats->max_us = hist->max_us;
+}
+
+uint32_t example_trace_get_dropped(void)
+{
+    return s_dropped;
+}
+
+void example_trace_reset(void)
+{
+    memset(s_hist, 0, sizeof(s_hist));
+    memset(s_chains, 0, sizeof(s_chains));
+    s_dropped = 0;
+}
+
+void example_trace_dump(void)
+{
+    example_trace_stats_t stats;
+    for (int i = 0; i < EXAMPLE_TRACE_INTERVAL_NUM; i++) {
+        example_trace_get_stats(i, &stats);
+        TRACE_LOG("%-14s n=%-6lu p50=%-6lu p99=%-6lu max=%lu us", s_interval_names[i],
+                  (unsigned long)stats.count, (unsigned long)stats.p50_us,
+                  (unsigned long)stats.p99_us, (unsigned long)stats.max_us);
+    }
+    if (s_dropped) {
+        TRACE_LOG("dropped %lu trace points", (unsigned long)s_dropped);
+    }
+}
@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#include "esp_timer.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Trace points along the touch-to-photon path, in the order a touch travels through them.
+ */
+typedef enum {
+    EXAMPLE_TRACE_TOUCH_READ,       /*!< GT911 frame read over I2C */
+    EXAMPLE_TRACE_LVGL_HANDLER,     /*!< `lv_timer_handler()` entered */
+    EXAMPLE_TRACE_INDEV_READ,       /*!< LVGL read callback took the touch sample */
+    EXAMPLE_TRACE_FLUSH,            /*!< Flush callback handed an area to the panel */
+    EXAMPLE_TRACE_FLUSH_DONE,       /*!< Last area of the frame reached the frame buffer */
+    EXAMPLE_TRACE_STAGE_NUM,
+} example_trace_stage_t;
+
+/**
+ * @brief Latency intervals aggregated from the trace points.
+ */
+typedef enum {
+    EXAMPLE_TRACE_WAIT_LVGL,        /*!< Touch read -> LVGL task runs */
+    EXAMPLE_TRACE_WAIT_INDEV,       /*!< LVGL task runs -> read callback */
+    EXAMPLE_TRACE_RENDER,           /*!< Read callback -> first flush */
+    EXAMPLE_TRACE_FLUSH_TIME,       /*!< First flush -> last flush done */
+    EXAMPLE_TRACE_TOTAL,            /*!< Touch read -> last flush done */
+    EXAMPLE_TRACE_INTERVAL_NUM,
+} example_trace_interval_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t p50_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} example_trace_stats_t;
+
+/**
+ * @brief Record a trace point with an explicit timestamp. Lock-free, safe to call from ISR.
+ */
+void example_trace_record_at(example_trace_stage_t stage, uint32_t timestamp_us);
+
+/**
+ * @brief Drain recorded trace points into the latency histograms.
+ *
+ * @note  Must be called from a single task, often enough that the ring buffer does not wrap.
+ */
+void example_trace_process(void);
+
+/**
+ * @brief Get p50/p99/max of one interval, from the histograms built so far.
+ */
+void example_trace_get_stats(example_trace_interval_t interval, example_trace_stats_t *stats);
+
+/**
+ * @brief Number of trace points lost because the ring buffer wrapped before processing.
+ */
+uint32_t example_trace_get_dropped(void);
+
+/**
+ * @brief Clear the histograms.
+ */
+void example_trace_reset(void);
+
+/**
+ * @brief Print the histograms to the console.
+ *
+ * @note  Only formats what `example_trace_process()` aggregated so far, call it from the same task
+ *        so the histograms are not read while being updated.
+ */
+void example_trace_dump(void);
+
+#ifdef ESP_PLATFORM
+#if CONFIG_EXAMPLE_ENABLE_LATENCY_TRACE
+#define EXAMPLE_TRACE(stage)            example_trace_record_at(stage, (uint32_t)esp_timer_get_time())
+#define EXAMPLE_TRACE_AT(stage, ts_us)  example_trace_record_at(stage, (uint32_t)(ts_us))
+#else
+#define EXAMPLE_TRACE(stage)
+#define EXAMPLE_TRACE_AT(stage, ts_us)
+#endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
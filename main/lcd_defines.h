@@ -5,15 +5,6 @@
 extern "C"{
 #endif
 
-#ifdef CONFIG_EXAMPLE_LCD_CONTROLLER_ST7701S
-#include "esp_lcd_st7701.h"
-#elif CONFIG_EXAMPLE_LCD_CONTROLLER_NV3052C
-#include "esp_lcd_nv3052c.h"
-#elif CONFIG_EXAMPLE_LCD_H040A18
-#include "lcd_h040a18.h"
-#elif CONFIG_EXAMPLE_LCD_H035A17
-#include "lcd_h035a17.h"
-#endif
 #include "vernon_gt911.h"
 
 static const char *TAG = "example";
@@ -27,51 +18,11 @@ static const char *TAG = "example";
 #define TOUCH_I2C_SCL   40
 #define TOUCH_PIN_RTN   38
 #define TOUCH_PIN_INT   39
+#define TOUCH_I2C_FREQ_HZ CONFIG_EXAMPLE_LCD_TOUCH_I2C_FREQ_HZ
 
-#define TOUCH_PAD_WIDTH  640
-#define TOUCH_PAD_HEIGHT 480
-#endif
-#ifdef CONFIG_EXAMPLE_LCD_CONTROLLER_ST7701S
-#define EXAMPLE_LCD_PIXEL_CLOCK_HZ     (20 * 1000 * 1000)
-#define EXAMPLE_LCD_H_RES              480
-#define EXAMPLE_LCD_V_RES              854
-#define EXAMPLE_LCD_HSYNC              80
-#define EXAMPLE_LCD_HBP                40
-#define EXAMPLE_LCD_HFP                40
-#define EXAMPLE_LCD_VSYNC              4
-#define EXAMPLE_LCD_VBP                20
-#define EXAMPLE_LCD_VFP                20
-#elif CONFIG_EXAMPLE_LCD_CONTROLLER_NV3052C
-#define EXAMPLE_LCD_PIXEL_CLOCK_HZ     (15 * 1000 * 1000)
-#define EXAMPLE_LCD_H_RES              720
-#define EXAMPLE_LCD_V_RES              720
-#define EXAMPLE_LCD_HSYNC              2
-#define EXAMPLE_LCD_HBP                44
-#define EXAMPLE_LCD_HFP                46
-#define EXAMPLE_LCD_VSYNC              5
-#define EXAMPLE_LCD_VBP                15
-#define EXAMPLE_LCD_VFP                16
-#elif CONFIG_EXAMPLE_LCD_H040A18
-#define EXAMPLE_LCD_PIXEL_CLOCK_HZ     (20 * 1000 * 1000)
-#define EXAMPLE_LCD_H_RES              400
-#define EXAMPLE_LCD_V_RES              960
-#define EXAMPLE_LCD_HSYNC              8
-#define EXAMPLE_LCD_HBP                50
-#define EXAMPLE_LCD_HFP                50
-#define EXAMPLE_LCD_VSYNC              8
-#define EXAMPLE_LCD_VBP                20
-#define EXAMPLE_LCD_VFP                20
-#elif CONFIG_EXAMPLE_LCD_H035A17
-#define EXAMPLE_LCD_PIXEL_CLOCK_HZ     (20 * 1000 * 1000)
-#define EXAMPLE_LCD_H_RES              640
-#define EXAMPLE_LCD_V_RES              480
-#define EXAMPLE_LCD_HSYNC              23
-#define EXAMPLE_LCD_HBP                20
-#define EXAMPLE_LCD_HFP                20
-#define EXAMPLE_LCD_VSYNC              2
-#define EXAMPLE_LCD_VBP                6
-#define EXAMPLE_LCD_VFP                12
+#define TOUCH_TASK_PRIORITY 4
 #endif
+// the resolution and timings come with the panel the board is fitted with, see panel_select.h
 
 #define EXAMPLE_LCD_BK_LIGHT_ON_LEVEL  1
 #define EXAMPLE_LCD_BK_LIGHT_OFF_LEVEL !EXAMPLE_LCD_BK_LIGHT_ON_LEVEL
@@ -118,11 +69,13 @@ static const char *TAG = "example";
 #define EXAMPLE_PIN_NUM_DATA23         37
 #endif
 
-#if CONFIG_EXAMPLE_USE_DOUBLE_FB
+#if CONFIG_EXAMPLE_USE_TRIPLE_FB
+#define EXAMPLE_LCD_NUM_FB             3
+#elif CONFIG_EXAMPLE_USE_DOUBLE_FB
 #define EXAMPLE_LCD_NUM_FB             2
 #else
 #define EXAMPLE_LCD_NUM_FB             1
-#endif // CONFIG_EXAMPLE_USE_DOUBLE_FB
+#endif // CONFIG_EXAMPLE_USE_TRIPLE_FB
 
 #if CONFIG_EXAMPLE_LCD_DATA_LINES_16
 #define EXAMPLE_DATA_BUS_WIDTH         16
@@ -134,14 +87,52 @@ static const char *TAG = "example";
 #define EXAMPLE_LV_COLOR_FORMAT        LV_COLOR_FORMAT_RGB888
 #endif
 
+// bytes per pixel of the frame buffer in PSRAM
+#if CONFIG_EXAMPLE_BOUNCE_INDEXED_FB
+#define EXAMPLE_FB_PIXEL_SIZE          1 // palette indices, expanded when the bounce buffers are refilled
+#else
+#define EXAMPLE_FB_PIXEL_SIZE          EXAMPLE_PIXEL_SIZE
+#endif
+
+// clockwise rotation of the LVGL display on the panel, in quarter turns (example_blit_rotation_t)
+#if CONFIG_EXAMPLE_DISPLAY_ROTATE_90
+#define EXAMPLE_DISPLAY_ROTATION       1
+#elif CONFIG_EXAMPLE_DISPLAY_ROTATE_180
+#define EXAMPLE_DISPLAY_ROTATION       2
+#elif CONFIG_EXAMPLE_DISPLAY_ROTATE_270
+#define EXAMPLE_DISPLAY_ROTATION       3
+#else
+#define EXAMPLE_DISPLAY_ROTATION       0
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////// Please update the following configuration according to your Application ///////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #define EXAMPLE_LVGL_DRAW_BUF_LINES    50 // number of display lines in each draw buffer
-#define EXAMPLE_LVGL_TICK_PERIOD_MS    2
+#define EXAMPLE_DIRTY_TILE_BURST_PX    (64 / EXAMPLE_FB_PIXEL_SIZE) // frame buffer pixels in a 64-byte PSRAM burst
+#define EXAMPLE_DIRTY_TILE_LINES       8
+// the tiles are snapped in LVGL coordinates, a burst runs along a panel line, which is a UI column at 90 and 270 degrees
+#if EXAMPLE_DISPLAY_ROTATION == 1 || EXAMPLE_DISPLAY_ROTATION == 3
+#define EXAMPLE_DIRTY_TILE_W           EXAMPLE_DIRTY_TILE_LINES
+#define EXAMPLE_DIRTY_TILE_H           EXAMPLE_DIRTY_TILE_BURST_PX
+#else
+#define EXAMPLE_DIRTY_TILE_W           EXAMPLE_DIRTY_TILE_BURST_PX
+#define EXAMPLE_DIRTY_TILE_H           EXAMPLE_DIRTY_TILE_LINES
+#endif
+#define EXAMPLE_DIRTY_RECT_COST_PX     4096 // overhead of one more area (flush call, cache write back), in pixels
+#define EXAMPLE_BEAM_MARGIN_LINES      4 // lines kept between the scan-out and the lines being written
+#define EXAMPLE_LVGL_MAX_BUSY_MS       500 // longest time the LVGL task may run without blocking
+#define EXAMPLE_LVGL_FLUSH_TIMEOUT_MS  100
 #define EXAMPLE_LVGL_TASK_STACK_SIZE   (5 * 1024)
 #define EXAMPLE_LVGL_TASK_PRIORITY     2
+#define EXAMPLE_PRESENT_TASK_PRIORITY  3 // hands finished frames to the panel, above the LVGL task
+#define EXAMPLE_PANEL_INIT_TASK_STACK_SIZE (4 * 1024)
+#define EXAMPLE_PANEL_INIT_TASK_PRIORITY 3 // sends the init sequence while the LVGL task renders the first screen
+#define EXAMPLE_BOOT_FIRST_FRAME_TIMEOUT_MS 1000 // the backlight is turned on after this even without a frame
+#define EXAMPLE_MONITOR_TASK_STACK_SIZE (3 * 1024)
+#define EXAMPLE_MONITOR_TASK_PRIORITY  1
+#define EXAMPLE_MONITOR_PERIOD_MS      100
 
 #ifdef __cplusplus
 }
@@ -85,6 +85,13 @@ static void scale1_indic3_anim_cb(void *var, int32_t v)
     lv_label_set_text_fmt(label, "Costs: %"LV_PRId32" %%", v);
 }
 
+// colors the UI draws with, the palette colors below and those of the dark default theme
+const uint32_t example_lvgl_demo_ui_colors[] = {
+    0x000000, 0x15171A, 0x282B30, 0x2F3237, 0x9E9E9E, 0xFAFAFA,
+    0xF44336, 0x2196F3, 0x4CAF50,
+};
+const uint32_t example_lvgl_demo_ui_num_colors = sizeof(example_lvgl_demo_ui_colors) / sizeof(example_lvgl_demo_ui_colors[0]);
+
 void example_lvgl_demo_ui(lv_display_t *disp)
 {
     // init default theme
@@ -0,0 +1,194 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <math.h>
+#include <string.h>
+#include <stdbool.h>
+#include "lvgl_touch.h"
+
+typedef struct {
+    example_touch_point_t point;
+    uint32_t since;     // frame number when the finger landed, orders tracks by age
+    bool active;
+} example_touch_track_t;
+
+static example_touch_track_t s_tracks[TOUCH_POINT_TOTAL];
+static uint32_t s_frame;
+static lv_point_t s_last_point;
+
+static struct {
+    bool active;
+    uint8_t id_a;
+    uint8_t id_b;
+    float distance;     // finger distance at gesture begin
+    float angle;        // finger angle at gesture begin, in degrees
+    example_touch_gesture_t last;
+} s_gesture;
+
+uint32_t example_touch_gesture_event;
+
+void example_touch_init(void)
+{
+    example_touch_gesture_event = lv_event_register_id();
+    memset(s_tracks, 0, sizeof(s_tracks));
+    memset(&s_gesture, 0, sizeof(s_gesture));
+}
+
+static void example_touch_update_tracks(const TP_point_info *points, uint8_t touch_num)
+{
+    bool seen[TOUCH_POINT_TOTAL] = {0};
+
+    s_frame++;
+    for (int i = 0; i < touch_num; i++) {
+        int slot = -1;
+        for (int j = 0; j < TOUCH_POINT_TOTAL; j++) {
+            if (s_tracks[j].active && s_tracks[j].point.id == points[i].id) {
+                slot = j;
+                break;
+            }
+        }
+        if (slot < 0) {
+            // new finger, take the first free slot
+            for (int j = 0; j < TOUCH_POINT_TOTAL; j++) {
+                if (!s_tracks[j].active && !seen[j]) {
+                    slot = j;
+                    s_tracks[j].active = true;
+                    s_tracks[j].since = s_frame;
+                    s_tracks[j].point.id = points[i].id;
+                    break;
+                }
+            }
+        }
+        if (slot < 0) {
+            continue;
+        }
+        seen[slot] = true;
+        s_tracks[slot].point.x = points[i].x;
+        s_tracks[slot].point.y = points[i].y;
+        s_tracks[slot].point.size = points[i].size;
+    }
+    // fingers not reported in this frame have been lifted
+    for (int j = 0; j < TOUCH_POINT_TOTAL; j++) {
+        if (!seen[j]) {
+            s_tracks[j].active = false;
+        }
+    }
+}
+
+static uint8_t example_touch_sorted_tracks(const example_touch_track_t **sorted)
+{
+    uint8_t count = 0;
+    for (int j = 0; j < TOUCH_POINT_TOTAL; j++) {
+        if (!s_tracks[j].active) {
+            continue;
+        }
+        // insertion sort, oldest first
+        int k = count++;
+        while (k > 0 && sorted[k - 1]->since > s_tracks[j].since) {
+            sorted[k] = sorted[k - 1];
+            k--;
+        }
+        sorted[k] = &s_tracks[j];
+    }
+    return count;
+}
+
+static void example_touch_send_gesture(lv_indev_t *indev, example_touch_gesture_t *gesture)
+{
+    lv_obj_t *screen = lv_display_get_screen_active(lv_indev_get_display(indev));
+    lv_obj_t *target = lv_indev_search_obj(screen, &gesture->center);
+    lv_obj_send_event(target ? target : screen, example_touch_gesture_event, gesture);
+}
+
+static void example_touch_update_gesture(lv_indev_t *indev, const example_touch_track_t **sorted, uint8_t count)
+{
+    if (count < 2) {
+        if (s_gesture.active) {
+            s_gesture.active = false;
+            s_gesture.last.state = EXAMPLE_TOUCH_GESTURE_END;
+            example_touch_send_gesture(indev, &s_gesture.last);
+        }
+        return;
+    }
+
+    const example_touch_point_t *a = &sorted[0]->point;
+    const example_touch_point_t *b = &sorted[1]->point;
+    float dx = (float)(b->x - a->x);
+    float dy = (float)(b->y - a->y);
+    float distance = sqrtf(dx * dx + dy * dy);
+    float angle = atan2f(dy, dx) * 180.0f / (float)M_PI;
+    if (distance < 1.0f) {
+        distance = 1.0f;
+    }
+
+    example_touch_gesture_t *gesture = &s_gesture.last;
+    gesture->center.x = (a->x + b->x) / 2;
+    gesture->center.y = (a->y + b->y) / 2;
+
+    if (!s_gesture.active || s_gesture.id_a != a->id || s_gesture.id_b != b->id) {
+        s_gesture.active = true;
+        s_gesture.id_a = a->id;
+        s_gesture.id_b = b->id;
+        s_gesture.distance = distance;
+        s_gesture.angle = angle;
+        gesture->state = EXAMPLE_TOUCH_GESTURE_BEGIN;
+        gesture->scale = 256;
+        gesture->rotation = 0;
+        // the two fingers belong to the gesture now, don't let LVGL turn them into a drag or click
+        lv_indev_wait_release(indev);
+    } else {
+        float delta = angle - s_gesture.angle;
+        if (delta > 180.0f) {
+            delta -= 360.0f;
+        } else if (delta <= -180.0f) {
+            delta += 360.0f;
+        }
+        gesture->state = EXAMPLE_TOUCH_GESTURE_UPDATE;
+        gesture->scale = (int32_t)lroundf(distance / s_gesture.distance * 256.0f);
+        gesture->rotation = (int32_t)lroundf(delta * 10.0f);
+    }
+    example_touch_send_gesture(indev, gesture);
+}
+
+void example_touch_process(lv_indev_t *indev, const TP_point_info *points, uint8_t touch_num, lv_indev_data_t *data)
+{
+    const example_touch_track_t *sorted[TOUCH_POINT_TOTAL];
+
+    if (touch_num > TOUCH_POINT_TOTAL) {
+        touch_num = TOUCH_POINT_TOTAL;
+    }
+    example_touch_update_tracks(points, touch_num);
+    uint8_t count = example_touch_sorted_tracks(sorted);
+    example_touch_update_gesture(indev, sorted, count);
+
+    if (count > 0) {
+        s_last_point.x = sorted[0]->point.x;
+        s_last_point.y = sorted[0]->point.y;
+        data->state = LV_INDEV_STATE_PRESSED;
+    } else {
+        data->state = LV_INDEV_STATE_RELEASED;
+    }
+    // LVGL expects the last pressed position on release as well
+    data->point = s_last_point;
+}
+
+void example_touch_read_snapshot(lv_indev_t *indev, Vernon_GT911 *gt911, lv_indev_data_t *data)
+{
+    // the touch task publishes every finished frame, just take the latest one
+    GT911_snapshot snapshot;
+    GT911_read_snapshot(gt911, &snapshot);
+    example_touch_process(indev, snapshot.points_info, snapshot.touch_num, data);
+}
+
+uint8_t example_touch_get_points(example_touch_point_t *points)
+{
+    const example_touch_track_t *sorted[TOUCH_POINT_TOTAL];
+    uint8_t count = example_touch_sorted_tracks(sorted);
+    for (int i = 0; i < count; i++) {
+        points[i] = sorted[i]->point;
+    }
+    return count;
+}
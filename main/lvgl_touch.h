@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "lvgl.h"
+#include "vernon_gt911.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief One tracked contact on the touch panel.
+ */
+typedef struct {
+    uint8_t id;         /*!< Track ID reported by the controller, stable while the finger stays down */
+    int32_t x;          /*!< X coordinate in display pixels */
+    int32_t y;          /*!< Y coordinate in display pixels */
+    uint16_t size;      /*!< Contact size, usable as a pressure estimate */
+} example_touch_point_t;
+
+typedef enum {
+    EXAMPLE_TOUCH_GESTURE_BEGIN,    /*!< Second finger landed, reference pose captured */
+    EXAMPLE_TOUCH_GESTURE_UPDATE,   /*!< Fingers moved */
+    EXAMPLE_TOUCH_GESTURE_END,      /*!< One of the two fingers lifted */
+} example_touch_gesture_state_t;
+
+/**
+ * @brief Two-finger pinch/rotate gesture, passed as the parameter of `example_touch_gesture_event`.
+ */
+typedef struct {
+    example_touch_gesture_state_t state;
+    lv_point_t center;  /*!< Midpoint between the two fingers */
+    int32_t scale;      /*!< Relative to the begin pose, 256 means unchanged (same unit as `lv_image_set_scale()`) */
+    int32_t rotation;   /*!< Relative to the begin pose, in 0.1 degree (same unit as `lv_image_set_rotation()`) */
+} example_touch_gesture_t;
+
+/**
+ * @brief LVGL event code sent to the object under the gesture center, registered by `example_touch_init()`.
+ */
+extern uint32_t example_touch_gesture_event;
+
+/**
+ * @brief Register the gesture event code. Call once after `lv_init()`.
+ */
+void example_touch_init(void);
+
+/**
+ * @brief Update tracks and gestures from one touch frame and fill the LVGL pointer data.
+ *
+ * @note  Only the first `touch_num` entries of `points` are read. The pointer follows the
+ *        oldest finger, so it does not jump when a second finger lands.
+ *
+ * @param[in]  indev      LVGL input device being read
+ * @param[in]  points     Points reported by the controller
+ * @param[in]  touch_num  Number of valid entries in `points`
+ * @param[out] data       LVGL input data to fill
+ */
+void example_touch_process(lv_indev_t *indev, const TP_point_info *points, uint8_t touch_num, lv_indev_data_t *data);
+
+/**
+ * @brief Fill the LVGL pointer data from the latest frame the GT911 touch task published.
+ *
+ * @note  Never touches the I2C bus, the frame was read by the touch task on the INT edge or on `GT911_request_read()`.
+ *
+ * @param[in]  indev  LVGL input device being read
+ * @param[in]  gt911  Touch controller, with its touch task started
+ * @param[out] data   LVGL input data to fill
+ */
+void example_touch_read_snapshot(lv_indev_t *indev, Vernon_GT911 *gt911, lv_indev_data_t *data);
+
+/**
+ * @brief Copy the currently active tracks, oldest first.
+ *
+ * @param[out] points  Array with room for `TOUCH_POINT_TOTAL` entries
+ * @return Number of active tracks
+ */
+uint8_t example_touch_get_points(example_touch_point_t *points);
+
+#ifdef __cplusplus
+}
+#endif
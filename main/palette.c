@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include "esp_attr.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "palette.h"
+#include "blit.h"
+
+static const char *TAG = "palette";
+
+// internal RAM, the bounce buffer refill ISR reads the expansion table
+static struct {
+    uint32_t pixel_size;
+    uint32_t size;                          // entries in use
+    uint32_t rgb[EXAMPLE_PALETTE_SIZE];     // 0xRRGGBB
+    union {
+        uint16_t rgb565[EXAMPLE_PALETTE_SIZE];
+        uint32_t rgb888[EXAMPLE_PALETTE_SIZE];  // B, G, R in the low 3 bytes, LVGL byte order
+    } lut;
+    uint8_t inv_lut[EXAMPLE_BLIT_L8_KEYS];  // nearest entry per RGB444 cell
+} s_palette;
+
+static uint32_t palette_distance(uint32_t a, uint32_t b)
+{
+    int dr = (int)((a >> 16) & 0xFF) - (int)((b >> 16) & 0xFF);
+    int dg = (int)((a >> 8) & 0xFF) - (int)((b >> 8) & 0xFF);
+    int db = (int)(a & 0xFF) - (int)(b & 0xFF);
+    // rough perceptual weights, the eye is most sensitive to green
+    return 2 * dr * dr + 4 * dg * dg + 3 * db * db;
+}
+
+static uint8_t palette_nearest(uint32_t rgb)
+{
+    uint32_t best = 0;
+    uint32_t best_dist = UINT32_MAX;
+    for (uint32_t i = 0; i < s_palette.size; i++) {
+        uint32_t dist = palette_distance(rgb, s_palette.rgb[i]);
+        if (dist < best_dist) {
+            best = i;
+            best_dist = dist;
+        }
+    }
+    return best;
+}
+
+esp_err_t example_palette_init(const uint32_t *colors, uint32_t num_colors, uint32_t pixel_size)
+{
+    ESP_RETURN_ON_FALSE(num_colors <= EXAMPLE_PALETTE_MAX_COLORS, ESP_ERR_INVALID_ARG, TAG,
+                        "at most %d colors besides the color cube", EXAMPLE_PALETTE_MAX_COLORS);
+    ESP_RETURN_ON_FALSE(pixel_size == 2 || pixel_size == 3, ESP_ERR_INVALID_ARG, TAG, "unsupported pixel size");
+    memset(&s_palette, 0, sizeof(s_palette));
+    s_palette.pixel_size = pixel_size;
+
+    // the colors of the UI first, so they win ties, then the cube
+    uint32_t n = 0;
+    for (; n < num_colors; n++) {
+        s_palette.rgb[n] = colors[n] & 0xFFFFFF;
+    }
+    const uint32_t step = 255 / (EXAMPLE_PALETTE_CUBE_LEVELS - 1);
+    for (uint32_t r = 0; r < EXAMPLE_PALETTE_CUBE_LEVELS; r++) {
+        for (uint32_t g = 0; g < EXAMPLE_PALETTE_CUBE_LEVELS; g++) {
+            for (uint32_t b = 0; b < EXAMPLE_PALETTE_CUBE_LEVELS; b++) {
+                s_palette.rgb[n++] = (r * step) << 16 | (g * step) << 8 | (b * step);
+            }
+        }
+    }
+    s_palette.size = n;
+
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t c = s_palette.rgb[i];
+        if (pixel_size == 2) {
+            s_palette.lut.rgb565[i] = ((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F);
+        } else {
+            // 0xRRGGBB stored little endian is B, G, R
+            s_palette.lut.rgb888[i] = c;
+        }
+    }
+
+    // the nearest entry to the center of each cell
+    for (uint32_t key = 0; key < EXAMPLE_BLIT_L8_KEYS; key++) {
+        uint32_t r = ((key >> 8) << 4) | 8;
+        uint32_t g = (((key >> 4) & 0xF) << 4) | 8;
+        uint32_t b = ((key & 0xF) << 4) | 8;
+        s_palette.inv_lut[key] = palette_nearest(r << 16 | g << 8 | b);
+    }
+    // the colors of the UI are exact, even when the center of their cell is nearer to a cube entry
+    for (uint32_t i = 0; i < num_colors; i++) {
+        uint32_t c = s_palette.rgb[i];
+        uint32_t key = EXAMPLE_BLIT_L8_KEY(c >> 16, (c >> 8) & 0xFF, c & 0xFF);
+        uint32_t prev = s_palette.inv_lut[key];
+        if (prev < i && EXAMPLE_BLIT_L8_KEY(s_palette.rgb[prev] >> 16, (s_palette.rgb[prev] >> 8) & 0xFF,
+                                            s_palette.rgb[prev] & 0xFF) == key) {
+            ESP_LOGW(TAG, "0x%06"PRIx32" and 0x%06"PRIx32" are too close to both be exact", s_palette.rgb[prev], c);
+        }
+        s_palette.inv_lut[key] = i;
+    }
+
+    ESP_LOGI(TAG, "%"PRIu32" colors, %"PRIu32" of the UI and a %dx%dx%d color cube", n, num_colors,
+             EXAMPLE_PALETTE_CUBE_LEVELS, EXAMPLE_PALETTE_CUBE_LEVELS, EXAMPLE_PALETTE_CUBE_LEVELS);
+    return ESP_OK;
+}
+
+void example_palette_quantize(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                              uint32_t w, uint32_t h)
+{
+    if (s_palette.pixel_size == 2) {
+        example_blit_rgb565_to_l8(dst, dst_stride, src, src_stride, w, h, s_palette.inv_lut);
+    } else {
+        example_blit_rgb888_to_l8(dst, dst_stride, src, src_stride, w, h, s_palette.inv_lut);
+    }
+}
+
+void IRAM_ATTR example_palette_expand(uint8_t *dst, const uint8_t *src, uint32_t num_px)
+{
+    if (s_palette.pixel_size == 2) {
+        example_blit_l8_to_rgb565(dst, num_px * 2, src, num_px, num_px, 1, s_palette.lut.rgb565);
+    } else {
+        example_blit_l8_to_rgb888(dst, num_px * 3, src, num_px, num_px, 1, s_palette.lut.rgb888);
+    }
+}
@@ -0,0 +1,48 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EXAMPLE_PALETTE_SIZE        256
+#define EXAMPLE_PALETTE_CUBE_LEVELS 6   // levels per channel of the color cube filling the palette
+#define EXAMPLE_PALETTE_MAX_COLORS  (EXAMPLE_PALETTE_SIZE - EXAMPLE_PALETTE_CUBE_LEVELS * EXAMPLE_PALETTE_CUBE_LEVELS * EXAMPLE_PALETTE_CUBE_LEVELS)
+
+/**
+ * @brief Build the palette of an indexed frame buffer.
+ *
+ * The palette holds `colors` first, they are reproduced exactly, and a color cube for everything else,
+ * e.g. anti-aliased edges, which are mapped to the nearest entry.
+ *
+ * @param[in] colors     Colors of the UI, as 0xRRGGBB
+ * @param[in] num_colors Number of colors, up to `EXAMPLE_PALETTE_MAX_COLORS`
+ * @param[in] pixel_size Bytes per pixel of the panel, 2 for RGB565 or 3 for RGB888
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Too many colors, or unsupported pixel size
+ */
+esp_err_t example_palette_init(const uint32_t *colors, uint32_t num_colors, uint32_t pixel_size);
+
+/**
+ * @brief Map rendered pixels to palette indices.
+ */
+void example_palette_quantize(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                              uint32_t w, uint32_t h);
+
+/**
+ * @brief Expand palette indices to pixels of the panel (ISR safe).
+ */
+void example_palette_expand(uint8_t *dst, const uint8_t *src, uint32_t num_px);
+
+#ifdef __cplusplus
+}
+#endif
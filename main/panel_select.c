@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "driver/gpio.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#if CONFIG_EXAMPLE_PANEL_ID_FROM_NVS
+#include "nvs_flash.h"
+#include "nvs.h"
+#endif
+#include "esp_lcd_nv3052c.h"
+#include "lcd_h040a18.h"
+#include "lcd_h035a17.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include "esp_lcd_st7701.h"
+#endif
+#include "panel_select.h"
+
+#define PANEL_NVS_NAMESPACE     "display"
+#define PANEL_NVS_KEY           "panel_id"
+
+#if CONFIG_EXAMPLE_LCD_CONTROLLER_ST7701S
+#define PANEL_ID_DEFAULT        EXAMPLE_PANEL_ID_ST7701S
+#elif CONFIG_EXAMPLE_LCD_H040A18
+#define PANEL_ID_DEFAULT        EXAMPLE_PANEL_ID_H040A18
+#elif CONFIG_EXAMPLE_LCD_H035A17
+#define PANEL_ID_DEFAULT        EXAMPLE_PANEL_ID_H035A17
+#else
+#define PANEL_ID_DEFAULT        EXAMPLE_PANEL_ID_NV3052C
+#endif
+
+static const char *TAG = "panel";
+
+#if !CONFIG_IDF_TARGET_LINUX
+// the ST7701S driver is a managed component, its descriptor lives here rather than in the driver
+static esp_err_t panel_st7701_new(esp_lcd_panel_io_handle_t io, const lcd_panel_new_config_t *config,
+                                  esp_lcd_panel_handle_t *ret_panel)
+{
+    st7701_vendor_config_t vendor_config = {
+        .rgb_config = config->rgb_config,
+        .flags = {
+            .mirror_by_cmd = config->flags.mirror_by_cmd,
+            .enable_io_multiplex = 0,
+        },
+    };
+    esp_lcd_panel_dev_config_t panel_dev_config = {
+        .reset_gpio_num = config->reset_gpio_num,
+        .rgb_ele_order = LCD_RGB_ELEMENT_ORDER_RGB,
+        .bits_per_pixel = 16,
+        .vendor_config = &vendor_config,
+    };
+    return esp_lcd_new_panel_st7701_rgb(io, &panel_dev_config, ret_panel);
+}
+
+static const lcd_panel_desc_t panel_st7701_desc = {
+    .name = "st7701s",
+    .timings = {
+        .pclk_hz = 20 * 1000 * 1000,
+        .h_res = 480,
+        .v_res = 854,
+        .hsync_pulse_width = 80,
+        .hsync_back_porch = 40,
+        .hsync_front_porch = 40,
+        .vsync_pulse_width = 4,
+        .vsync_back_porch = 20,
+        .vsync_front_porch = 20,
+        .flags.pclk_active_neg = true,
+    },
+    .io = {
+        .spi_mode = 0,
+        .cmd_bytes = 1,
+        .param_bytes = 1,
+    },
+    .new_panel = panel_st7701_new,
+};
+#endif
+
+esp_err_t example_panel_register_all(void)
+{
+    ESP_RETURN_ON_ERROR(lcd_panel_registry_add(EXAMPLE_PANEL_ID_NV3052C, &nv3052_panel_desc), TAG, "register failed");
+#if !CONFIG_IDF_TARGET_LINUX
+    ESP_RETURN_ON_ERROR(lcd_panel_registry_add(EXAMPLE_PANEL_ID_ST7701S, &panel_st7701_desc), TAG, "register failed");
+#endif
+    ESP_RETURN_ON_ERROR(lcd_panel_registry_add(EXAMPLE_PANEL_ID_H040A18, &h040a18_panel_desc), TAG, "register failed");
+    ESP_RETURN_ON_ERROR(lcd_panel_registry_add(EXAMPLE_PANEL_ID_H035A17, &h035a17_panel_desc), TAG, "register failed");
+    return ESP_OK;
+}
+
+#if CONFIG_EXAMPLE_PANEL_ID_FROM_NVS
+static bool panel_read_nvs_id(uint8_t *id)
+{
+    // never erased here, even when full or from an older IDF: it may hold what the factory provisioned
+    esp_err_t ret = nvs_flash_init();
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "NVS not available: %s", esp_err_to_name(ret));
+        return false;
+    }
+    nvs_handle_t nvs;
+    if (nvs_open(PANEL_NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK) {
+        return false;
+    }
+    ret = nvs_get_u8(nvs, PANEL_NVS_KEY, id);
+    nvs_close(nvs);
+    return ret == ESP_OK;
+}
+#endif
+
+static bool panel_read_strap_id(uint8_t *id)
+{
+    const int pins[] = {CONFIG_EXAMPLE_PANEL_ID_GPIO_0, CONFIG_EXAMPLE_PANEL_ID_GPIO_1};
+    uint8_t value = 0;
+    for (size_t bit = 0; bit < sizeof(pins) / sizeof(pins[0]); bit++) {
+        if (pins[bit] < 0) {
+            // the board has no strap for this bit, it reads as 0
+            continue;
+        }
+        gpio_config_t strap_config = {
+            .mode = GPIO_MODE_INPUT,
+            .pull_up_en = GPIO_PULLUP_ENABLE,
+            .pin_bit_mask = 1ULL << pins[bit],
+        };
+        if (gpio_config(&strap_config) != ESP_OK) {
+            return false;
+        }
+        value |= gpio_get_level(pins[bit]) << bit;
+        gpio_reset_pin(pins[bit]);
+    }
+    *id = value;
+    return CONFIG_EXAMPLE_PANEL_ID_GPIO_0 >= 0 || CONFIG_EXAMPLE_PANEL_ID_GPIO_1 >= 0;
+}
+
+esp_err_t example_panel_select(const lcd_panel_desc_t **ret_panel, uint8_t *ret_id)
+{
+    const char *source = "default";
+    uint8_t id = PANEL_ID_DEFAULT;
+#if CONFIG_EXAMPLE_PANEL_ID_FROM_NVS
+    if (panel_read_nvs_id(&id)) {
+        source = "NVS";
+    } else
+#endif
+    if (panel_read_strap_id(&id)) {
+        source = "strap pins";
+    }
+
+    const lcd_panel_desc_t *panel = lcd_panel_registry_find(id);
+    if (!panel) {
+        ESP_LOGW(TAG, "no panel with ID %u (from %s), use the default one", id, source);
+        source = "default";
+        id = PANEL_ID_DEFAULT;
+        panel = lcd_panel_registry_find(id);
+    }
+    ESP_RETURN_ON_FALSE(panel, ESP_ERR_NOT_FOUND, TAG, "default panel %u not registered", id);
+    ESP_LOGI(TAG, "%s, ID %u from %s, %"PRIu32"x%"PRIu32" at %.2f Hz", panel->name, id, source,
+             panel->timings.h_res, panel->timings.v_res, lcd_panel_refresh_hz(&panel->timings));
+    *ret_panel = panel;
+    *ret_id = id;
+    return ESP_OK;
+}
@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "lcd_panel_registry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// IDs the board reports for the panels it can be fitted with, two strap pins tell them all apart
+#define EXAMPLE_PANEL_ID_NV3052C    0
+#define EXAMPLE_PANEL_ID_ST7701S    1
+#define EXAMPLE_PANEL_ID_H040A18    2
+#define EXAMPLE_PANEL_ID_H035A17    3
+
+/**
+ * @brief Register every panel this image can drive.
+ */
+esp_err_t example_panel_register_all(void);
+
+/**
+ * @brief Find out which panel the board is fitted with.
+ *
+ * The ID is read from NVS if it was provisioned there, otherwise from the ID strap pins if the board has them.
+ * The default panel of the configuration is used when neither gives the ID of a registered panel.
+ *
+ * @param[out] ret_panel Descriptor of the panel
+ * @param[out] ret_id    ID of the panel
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NOT_FOUND if not even the default panel is registered
+ */
+esp_err_t example_panel_select(const lcd_panel_desc_t **ret_panel, uint8_t *ret_id);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include "panel_timing.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_log.h"
+
+static const char *TAG = "timing";
+#endif
+
+// bytes read per pixel clock while the scan-out is busy: the DMA reads during the active pixels only,
+// the bounce buffers spread the reads over the whole line
+static float timing_peak_bytes_per_clk(const example_timing_config_t *config, example_timing_scan_t scan)
+{
+    float bytes = config->pixel_size;
+    if (scan == EXAMPLE_TIMING_SCAN_BOUNCE) {
+        bytes = bytes * config->h_res / (config->h_res + config->h_blank);
+    }
+    return bytes;
+}
+
+static float timing_bandwidth_mbps(const example_timing_config_t *config, example_timing_scan_t scan)
+{
+    return scan == EXAMPLE_TIMING_SCAN_BOUNCE ? config->psram_copy_mbps : config->psram_dma_mbps;
+}
+
+uint32_t example_timing_max_pclk_hz(const example_timing_config_t *config, example_timing_scan_t scan)
+{
+    // the average over the frame must leave the reserve, the peak must not exceed the bandwidth
+    float bandwidth = timing_bandwidth_mbps(config, scan) * 1e6f;
+    float peak = timing_peak_bytes_per_clk(config, scan);
+    float average = (float)config->pixel_size * config->h_res * config->v_res /
+                    ((config->h_res + config->h_blank) * (config->v_res + config->v_blank));
+    float by_peak = bandwidth / peak;
+    float by_average = bandwidth * (100 - config->reserve_percent) / 100 / average;
+    return (uint32_t)(by_peak < by_average ? by_peak : by_average);
+}
+
+void example_timing_calc(const example_timing_config_t *config, example_timing_report_t *report)
+{
+    const uint32_t h_total = config->h_res + config->h_blank;
+    const uint32_t v_total = config->v_res + config->v_blank;
+    const float bandwidth = timing_bandwidth_mbps(config, config->scan);
+
+    report->refresh_hz = (float)config->pclk_hz / h_total / v_total;
+    report->line_us = h_total * 1e6f / config->pclk_hz;
+    report->peak_mbps = config->pclk_hz * timing_peak_bytes_per_clk(config, config->scan) / 1e6f;
+    report->average_mbps = report->refresh_hz * config->h_res * config->v_res * config->pixel_size / 1e6f;
+    report->headroom_percent = 100 * (1 - report->average_mbps / bandwidth);
+    for (int scan = 0; scan < EXAMPLE_TIMING_SCAN_MAX; scan++) {
+        report->max_pclk_hz[scan] = example_timing_max_pclk_hz(config, scan);
+    }
+
+    if (report->peak_mbps > bandwidth || report->average_mbps > bandwidth) {
+        report->verdict = EXAMPLE_TIMING_UNDERRUN;
+    } else if (report->headroom_percent < config->reserve_percent) {
+        report->verdict = EXAMPLE_TIMING_LOW_HEADROOM;
+    } else {
+        report->verdict = EXAMPLE_TIMING_OK;
+    }
+}
+
+#ifdef ESP_PLATFORM
+void example_timing_log(const example_timing_config_t *config, const example_timing_report_t *report)
+{
+    ESP_LOGI(TAG, "%.2f Hz refresh, %.1f us per line, PSRAM read %.1f MB/s peak, %.1f MB/s average, %.0f%% left",
+             report->refresh_hz, report->line_us, report->peak_mbps, report->average_mbps, report->headroom_percent);
+    ESP_LOGI(TAG, "highest pixel clock keeping %lu%% free: %lu Hz from the frame buffer, %lu Hz with bounce buffers",
+             (unsigned long)config->reserve_percent, (unsigned long)report->max_pclk_hz[EXAMPLE_TIMING_SCAN_DMA],
+             (unsigned long)report->max_pclk_hz[EXAMPLE_TIMING_SCAN_BOUNCE]);
+    if (report->verdict == EXAMPLE_TIMING_UNDERRUN) {
+        ESP_LOGE(TAG, "the scan-out needs more PSRAM bandwidth than available, lower the pixel clock to %lu Hz",
+                 (unsigned long)report->max_pclk_hz[config->scan]);
+    } else if (report->verdict == EXAMPLE_TIMING_LOW_HEADROOM) {
+        ESP_LOGW(TAG, "less than %lu%% of the PSRAM bandwidth left to the CPU, rendering and flushes will slow down",
+                 (unsigned long)config->reserve_percent);
+    }
+}
+#endif
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief How the scan-out reads the frame buffer in PSRAM.
+ */
+typedef enum {
+    EXAMPLE_TIMING_SCAN_DMA,    /*!< The LCD DMA reads the frame buffer (single, double and triple frame buffer modes) */
+    EXAMPLE_TIMING_SCAN_BOUNCE, /*!< The CPU copies it into bounce buffers in SRAM (bounce buffer mode) */
+    EXAMPLE_TIMING_SCAN_MAX,
+} example_timing_scan_t;
+
+typedef enum {
+    EXAMPLE_TIMING_OK,          /*!< The scan-out leaves the reserved bandwidth to the CPU */
+    EXAMPLE_TIMING_LOW_HEADROOM,/*!< The scan-out keeps up, but eats into the bandwidth reserved for the CPU */
+    EXAMPLE_TIMING_UNDERRUN,    /*!< The scan-out needs more than the PSRAM delivers, the panel will show glitches */
+} example_timing_verdict_t;
+
+/**
+ * @brief Panel timing and PSRAM limits.
+ */
+typedef struct {
+    uint32_t pclk_hz;               /*!< Pixel clock */
+    uint32_t h_res;                 /*!< Active pixels per line */
+    uint32_t v_res;                 /*!< Active lines per frame */
+    uint32_t h_blank;               /*!< HSYNC pulse and porches, in pixel clocks */
+    uint32_t v_blank;               /*!< VSYNC pulse and porches, in lines */
+    uint32_t pixel_size;            /*!< Bytes per pixel */
+    uint32_t psram_dma_mbps;        /*!< PSRAM read rate of the LCD DMA, in MB/s */
+    uint32_t psram_copy_mbps;       /*!< PSRAM to SRAM copy rate of the CPU, in MB/s */
+    uint32_t reserve_percent;       /*!< Share of the PSRAM bandwidth kept for the CPU and LVGL */
+    example_timing_scan_t scan;     /*!< Scan-out used */
+} example_timing_config_t;
+
+typedef struct {
+    float refresh_hz;               /*!< Frames per second */
+    float line_us;                  /*!< Line period */
+    float peak_mbps;                /*!< Rate the scan-out has to read at without falling behind: during an active line
+                                         for the DMA, averaged over a line for the bounce buffers */
+    float average_mbps;             /*!< Average read rate over the frame */
+    float headroom_percent;         /*!< Share of the PSRAM bandwidth left to the CPU and LVGL */
+    uint32_t max_pclk_hz[EXAMPLE_TIMING_SCAN_MAX]; /*!< Highest pixel clock that keeps the reserve, per scan-out */
+    example_timing_verdict_t verdict;
+} example_timing_report_t;
+
+/**
+ * @brief Work out what a panel timing costs in PSRAM bandwidth, and the highest pixel clock each scan-out allows.
+ */
+void example_timing_calc(const example_timing_config_t *config, example_timing_report_t *report);
+
+/**
+ * @brief Highest pixel clock for which `scan` keeps `reserve_percent` of the bandwidth free, the rest of `config` unchanged.
+ */
+uint32_t example_timing_max_pclk_hz(const example_timing_config_t *config, example_timing_scan_t scan);
+
+/**
+ * @brief Log the report, with a warning or an error if the PSRAM can't keep up.
+ */
+void example_timing_log(const example_timing_config_t *config, const example_timing_report_t *report);
+
+#ifdef __cplusplus
+}
+#endif
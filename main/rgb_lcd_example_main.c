@@ -4,13 +4,18 @@
  * SPDX-License-Identifier: CC0-1.0
  */
 
+#include <inttypes.h>
 #include <stdio.h>
-#include <unistd.h>
 #include <sys/lock.h>
 #include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_timer.h"
+#include "esp_cache.h"
+#if CONFIG_EXAMPLE_FLUSH_COPY_GDMA
+#include "esp_memory_utils.h"
+#endif
 #include "esp_lcd_panel_ops.h"
 #include "esp_lcd_panel_rgb.h"
 #include "esp_lcd_panel_io.h"
@@ -20,98 +25,457 @@
 #include "esp_log.h"
 
 #include "lvgl.h"
+#if CONFIG_EXAMPLE_DIRTY_COALESCE
+// the invalidated areas of a refresh are only reachable through the display internals
+#include "src/display/lv_display_private.h"
+#endif
 #include "lcd_defines.h"
+#include "lvgl_touch.h"
+#include "latency_trace.h"
+#include "display_telemetry.h"
+#include "frame_present.h"
+#include "bounce_buffer.h"
+#include "palette.h"
+#include "blit.h"
+#include "async_flush.h"
+#include "display_rotate.h"
+#include "dirty_region.h"
+#include "beam_race.h"
+#include "boot_timing.h"
+#include "panel_timing.h"
+#include "panel_select.h"
 #include "esp_io_expander.h"
 #include "esp_lcd_panel_io_additions.h"
 
-// #include "driver/i2c_master.h"
-
-// i2c_master_bus_config_t i2c_config={
-//     .clk_source=I2C_CLK_SRC_DEFAULT,
-//     .i2c_port=I2C_NUM_0,
-//     .sda_io_num=GPIO_NUM_21,
-//     .scl_io_num=GPIO_NUM_40,
-//     .glitch_ignore_cnt=7,
-//     .flags.enable_internal_pullup=true,
-// };
-// i2c_master_bus_handle_t i2c_handle;
-
-// i2c_device_config_t i2c_dev_config={
-//     .dev_addr_length=I2C_ADDR_BIT_7,
-//     .device_address=0x5D,
-//     .scl_speed_hz=10000,
-// };
-// i2c_master_dev_handle_t i2c_dev_handle;
-
-// void i2c_init(void){
-//     uint8_t reg=0x8140;
-//     uint8_t buf[2];
-//     uint8_t buffer[2];
-//     ESP_ERROR_CHECK(i2c_new_master_bus(&i2c_config,&i2c_handle));
-//     ESP_ERROR_CHECK(i2c_master_bus_add_device(i2c_handle,&i2c_dev_config,&i2c_dev_handle));
-//     ESP_ERROR_CHECK(i2c_master_probe(i2c_handle,0x5D,-1));
-
-// }
+// reasons to wake up the LVGL task, delivered as task notification bits
+#define EXAMPLE_LVGL_WAKE_REFRESH   (1 << 0)
+#define EXAMPLE_LVGL_WAKE_INPUT     (1 << 1)
+
+static TaskHandle_t example_lvgl_task_handle;
+static SemaphoreHandle_t example_flush_done_sem;
+
+static void example_lvgl_wake(uint32_t reason)
+{
+    // the LVGL task runs the timer handler right after its own LVGL calls anyway
+    if (example_lvgl_task_handle && xTaskGetCurrentTaskHandle() != example_lvgl_task_handle) {
+        xTaskNotify(example_lvgl_task_handle, reason, eSetBits);
+    }
+}
+
 Vernon_GT911 vernonGT911;
 #if CONFIG_EXAMPLE_LCD_USE_TOUCH_ENABLED
+static lv_indev_t *example_touch_indev;
+
+static void example_touch_frame_cb(Vernon_GT911 *gt911, const GT911_snapshot *snapshot, void *user_ctx)
+{
+    EXAMPLE_TRACE_AT(EXAMPLE_TRACE_TOUCH_READ, snapshot->timestamp_us);
+    example_lvgl_wake(EXAMPLE_LVGL_WAKE_INPUT);
+}
+
 static void example_lvgl_touch_cb(lv_indev_t* indev,lv_indev_data_t* data){
-    uint16_t x,y;
-    if(GT911_touched(&vernonGT911)){
-        GT911_read_pos(&vernonGT911,&x,&y,0);
-        data->point.x=x;
-        data->point.y=y;
-        data->state=LV_INDEV_STATE_PRESSED;
-    }else{
-        data->state=LV_INDEV_STATE_RELEASED;
+#if !CONFIG_EXAMPLE_LCD_TOUCH_USE_INTERRUPT
+    // no INT line, ask the touch task for the next frame without waiting for the I2C transfer
+    GT911_request_read(&vernonGT911);
+#endif
+    EXAMPLE_TRACE(EXAMPLE_TRACE_INDEV_READ);
+    example_touch_read_snapshot(indev,&vernonGT911,data);
+}
+
+static esp_err_t example_touch_install(uint16_t width, uint16_t height)
+{
+    esp_err_t err = GT911_init(&vernonGT911, TOUCH_I2C_SDA,TOUCH_I2C_SCL,TOUCH_PIN_INT,
+                               TOUCH_PIN_RTN, I2C_NUM_0,GT911_ADDR1,TOUCH_I2C_FREQ_HZ,
+                               width, height);
+    if (err != ESP_OK) {
+        return err;
     }
+
+    // touch coordinates follow the display rotation
+    static const uint8_t touch_rotation[] = {ROTATION_NORMAL, ROTATION_RIGHT, ROTATION_INVERTED, ROTATION_LEFT};
+    GT911_setRotation(&vernonGT911,touch_rotation[EXAMPLE_DISPLAY_ROTATION]);
+#if CONFIG_EXAMPLE_LCD_TOUCH_USE_INTERRUPT
+    err = GT911_enable_interrupt(&vernonGT911, TOUCH_TASK_PRIORITY);
+#else
+    err = GT911_start_task(&vernonGT911, TOUCH_TASK_PRIORITY);
+#endif
+    if (err != ESP_OK) {
+        return err;
+    }
+    GT911_register_frame_callback(&vernonGT911, example_touch_frame_cb, NULL);
+    ESP_LOGW(TAG,"GT911 TouchPad Init");
+    return ESP_OK;
 }
 #endif
 // LVGL library is not thread-safe, this example will call LVGL APIs from different tasks, so use a mutex to protect it
 static _lock_t lvgl_api_lock;
 
+static void example_lvgl_lock(void)
+{
+    _lock_acquire(&lvgl_api_lock);
+    example_telemetry_lock_acquired();
+}
+
+static void example_lvgl_unlock(void)
+{
+    example_telemetry_lock_released();
+    _lock_release(&lvgl_api_lock);
+    // other tasks may have changed the UI or created timers, let the LVGL task recompute its deadline
+    example_lvgl_wake(EXAMPLE_LVGL_WAKE_REFRESH);
+}
+
 extern void example_lvgl_demo_ui(lv_display_t *disp);
+extern const uint32_t example_lvgl_demo_ui_colors[];
+extern const uint32_t example_lvgl_demo_ui_num_colors;
+
+// timings of the panel the board is fitted with, picked at startup
+static esp_lcd_rgb_timing_t example_timings;
+
+#if EXAMPLE_LCD_NUM_FB == 1 && !CONFIG_EXAMPLE_USE_BOUNCE_BUFFER
+// frame buffer of the RGB driver, the flush callback copies the rendered areas into it
+static uint8_t *example_fb;
+#endif
+
+// set by the flush callback when the area being transferred is the last one of the frame
+static volatile bool example_flush_is_last;
+// set by the flush callback, cleared by the flush done callback
+static volatile bool example_flush_busy;
+// set while the flush wait callback blocks on example_flush_done_sem, so no token is given without a taker
+static volatile bool example_flush_waiting;
+
+// initializes the panel while LVGL builds and renders the first screen, then turns the backlight on
+static TaskHandle_t example_panel_init_task_handle;
 
-static bool example_notify_lvgl_flush_ready(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_data_t *event_data, void *user_ctx)
+// returns whether the panel init task is to be woken up, the caller notifies it from its own context
+static bool example_boot_frame_ready(int64_t now_us)
+{
+    // the first complete frame after the UI was built is the first one worth lighting the panel for
+    return example_boot_time(EXAMPLE_BOOT_UI_BUILT) >= 0 && example_boot_mark(EXAMPLE_BOOT_FIRST_FRAME, now_us);
+}
+
+#if CONFIG_EXAMPLE_BEAM_RACING
+// area whose write waits for the scan-out to move on
+static lv_area_t example_beam_area;
+static uint8_t *example_beam_px_map;
+static esp_timer_handle_t example_beam_timer;
+// last frame buffer write, its duration refines the write time estimate
+static uint32_t example_beam_write_bytes;
+static int64_t example_beam_write_start_us;
+static volatile int64_t example_beam_write_end_us;
+#endif
+
+#if EXAMPLE_LCD_NUM_FB > 1
+static bool example_notify_lvgl_vsync(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_data_t *event_data, void *user_ctx)
+{
+    int64_t isr_enter_us = esp_timer_get_time();
+    BaseType_t need_yield = pdFALSE;
+    // LVGL was told the frame is flushed when it got queued, this is when it reaches the screen
+    if (example_present_on_vsync(&need_yield)) {
+        EXAMPLE_TRACE_AT(EXAMPLE_TRACE_FLUSH_DONE, isr_enter_us);
+        example_telemetry_flush_done(isr_enter_us);
+        if (example_boot_frame_ready(isr_enter_us)) {
+            vTaskNotifyGiveFromISR(example_panel_init_task_handle, &need_yield);
+        }
+    }
+    return need_yield == pdTRUE;
+}
+#else
+// the area is in the frame buffer, LVGL may render into the draw buffer again.
+// Returns whether the panel init task and the flush waiter are to be woken up
+static bool example_flush_done(lv_display_t *disp, int64_t now_us, bool *wake_waiter)
 {
-    lv_display_t *disp = (lv_display_t *)user_ctx;
+    bool boot_frame = false;
+    if (example_flush_is_last) {
+        EXAMPLE_TRACE_AT(EXAMPLE_TRACE_FLUSH_DONE, now_us);
+        // the last area is in the frame buffer, the scan-out shows the whole frame from now on
+        boot_frame = example_boot_frame_ready(now_us);
+    }
     lv_display_flush_ready(disp);
+    example_flush_busy = false;
+    *wake_waiter = example_flush_waiting;
+    example_telemetry_flush_done(now_us);
+    return boot_frame;
+}
+
+#if CONFIG_EXAMPLE_FLUSH_COPY_GDMA
+static bool example_notify_lvgl_flush_ready_isr(lv_display_t *disp)
+{
+    int64_t isr_enter_us = esp_timer_get_time();
+    BaseType_t need_yield = pdFALSE;
+    bool wake_waiter;
+    if (example_flush_done(disp, isr_enter_us, &wake_waiter)) {
+        vTaskNotifyGiveFromISR(example_panel_init_task_handle, &need_yield);
+    }
+    if (wake_waiter) {
+        xSemaphoreGiveFromISR(example_flush_done_sem, &need_yield);
+    }
+    return need_yield == pdTRUE;
+}
+#endif
+
+// from the LVGL task for a synchronous flush, or from the esp_timer task for a write deferred by the beam racing
+static void example_notify_lvgl_flush_ready(lv_display_t *disp)
+{
+    bool wake_waiter;
+    if (example_flush_done(disp, esp_timer_get_time(), &wake_waiter)) {
+        xTaskNotifyGive(example_panel_init_task_handle);
+    }
+    if (wake_waiter) {
+        xSemaphoreGive(example_flush_done_sem);
+    }
+}
+#endif
+
+#if CONFIG_EXAMPLE_FLUSH_COPY_GDMA
+static bool example_notify_lvgl_copy_done(void *user_ctx)
+{
+#if CONFIG_EXAMPLE_BEAM_RACING
+    example_beam_write_end_us = esp_timer_get_time();
+#endif
+    // the GDMA is through with the draw buffer, LVGL may render into it again
+    return example_notify_lvgl_flush_ready_isr((lv_display_t *)user_ctx);
+}
+#endif
+
+#if CONFIG_EXAMPLE_BEAM_RACING
+static bool example_beam_vsync_cb(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_data_t *event_data, void *user_ctx)
+{
+    example_beam_on_vsync(esp_timer_get_time());
     return false;
 }
+#endif
+
+static void example_lvgl_flush_wait_cb(lv_display_t *disp)
+{
+    // block until the flush done callback fires instead of letting LVGL spin on the flushing flag
+    if (!example_flush_busy) {
+        return;
+    }
+    int64_t wait_start_us = esp_timer_get_time();
+    // a token given to the previous wait just as it ended would wake this one early, drop it
+    xSemaphoreTake(example_flush_done_sem, 0);
+    example_flush_waiting = true;
+    while (example_flush_busy) {
+        xSemaphoreTake(example_flush_done_sem, pdMS_TO_TICKS(EXAMPLE_LVGL_FLUSH_TIMEOUT_MS));
+    }
+    example_flush_waiting = false;
+    // the draw buffer LVGL wants next is still being flushed, rendering could not overlap the copy
+    example_telemetry_flush_wait((uint32_t)(esp_timer_get_time() - wait_start_us));
+}
+
+static void example_lvgl_invalidate_cb(lv_event_t *e)
+{
+#if CONFIG_EXAMPLE_DIRTY_COALESCE
+    // LVGL stores the area as modified by the event handlers
+    example_dirty_snap((example_dirty_rect_t *)lv_event_get_param(e));
+#endif
+    example_lvgl_wake(EXAMPLE_LVGL_WAKE_REFRESH);
+}
+
+#if CONFIG_EXAMPLE_DIRTY_COALESCE
+_Static_assert(sizeof(lv_area_t) == sizeof(example_dirty_rect_t), "example_dirty_rect_t must match lv_area_t");
+
+static void example_lvgl_coalesce_cb(lv_event_t *e)
+{
+    lv_display_t *disp = lv_event_get_target(e);
+    // LVGL only joins areas whose union is smaller than both, merge further counting the cost of each flush
+    example_dirty_merge((example_dirty_rect_t *)disp->inv_areas, disp->inv_area_joined, disp->inv_p);
+}
+#endif
+
+#if EXAMPLE_LCD_NUM_FB > 1
+static void example_lvgl_render_start_cb(lv_event_t *e)
+{
+    // LVGL is about to draw, switch to a frame buffer that is neither on screen nor queued
+    example_present_acquire(lv_event_get_target(e));
+}
+#endif
+
+#if EXAMPLE_LCD_NUM_FB == 1 && !CONFIG_EXAMPLE_USE_BOUNCE_BUFFER
+static void example_fb_write(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+#if CONFIG_EXAMPLE_BEAM_RACING
+    example_beam_write_bytes = lv_area_get_size(area) * EXAMPLE_PIXEL_SIZE;
+    example_beam_write_start_us = esp_timer_get_time();
+#endif
+#if EXAMPLE_DISPLAY_ROTATION
+    // LVGL renders upright, the area is rotated while it's copied into the frame buffer
+    example_rotate_draw(area, px_map);
+#else
+    const uint32_t fb_stride = example_timings.h_res * EXAMPLE_PIXEL_SIZE;
+    uint32_t line_bytes = lv_area_get_width(area) * EXAMPLE_PIXEL_SIZE;
+    uint8_t *fb_line = example_fb + area->y1 * fb_stride;
+#if CONFIG_EXAMPLE_FLUSH_COPY_GDMA
+    // queue the copy, LVGL renders the next area into the other draw buffer meanwhile.
+    // A draw buffer that fell back to PSRAM is not coherent with the GDMA, it's copied by the CPU below.
+    if (esp_ptr_internal(px_map)) {
+        example_flush_busy = true;
+        example_async_flush_start(fb_line + area->x1 * EXAMPLE_PIXEL_SIZE, fb_stride,
+                                  px_map, line_bytes, line_bytes, lv_area_get_height(area));
+        return;
+    }
+#endif
+    // copy the draw buffer into the frame buffer, then write the cache back for the DMA
+    example_blit_copy(fb_line + area->x1 * EXAMPLE_PIXEL_SIZE, fb_stride, px_map, line_bytes, line_bytes, lv_area_get_height(area));
+    esp_cache_msync(fb_line, lv_area_get_height(area) * fb_stride, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+#endif
+#if CONFIG_EXAMPLE_BEAM_RACING
+    example_beam_write_end_us = esp_timer_get_time();
+#endif
+    example_notify_lvgl_flush_ready(disp);
+}
+#endif
+
+#if CONFIG_EXAMPLE_BEAM_RACING
+static void example_beam_timer_cb(void *arg)
+{
+    // the scan-out is out of the way now
+    example_fb_write((lv_display_t *)arg, &example_beam_area, example_beam_px_map);
+}
+
+static uint32_t example_beam_wait(const lv_area_t *area)
+{
+    // the GDMA reports the end of the previous write from an ISR, learn from it here
+    if (example_beam_write_end_us > example_beam_write_start_us) {
+        example_beam_write_done(example_beam_write_bytes, (uint32_t)(example_beam_write_end_us - example_beam_write_start_us));
+        example_beam_write_start_us = example_beam_write_end_us;
+    }
+    lv_area_t fb_area = *area;
+#if EXAMPLE_DISPLAY_ROTATION
+    // a rotated area is not written in scan-out order
+    example_rotate_area(area, &fb_area);
+#endif
+    return example_beam_schedule(fb_area.y1, fb_area.y2, lv_area_get_size(area) * EXAMPLE_PIXEL_SIZE,
+                                 !EXAMPLE_DISPLAY_ROTATION, esp_timer_get_time());
+}
+#endif
 
 static void example_lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
 {
-    esp_lcd_panel_handle_t panel_handle = lv_display_get_user_data(disp);
-    int offsetx1 = area->x1;
-    int offsetx2 = area->x2;
-    int offsety1 = area->y1;
-    int offsety2 = area->y2;
-    // pass the draw buffer to the driver
-    esp_lcd_panel_draw_bitmap(panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, px_map);
+    EXAMPLE_TRACE(EXAMPLE_TRACE_FLUSH);
+    example_flush_is_last = lv_display_flush_is_last(disp);
+    example_telemetry_flush_start(area);
+#if EXAMPLE_LCD_NUM_FB > 1
+    // the whole frame buffer is queued for VSYNC with the last area, LVGL continues in another one
+    example_present_flush(area, px_map, example_flush_is_last);
+    lv_display_flush_ready(disp);
+#elif CONFIG_EXAMPLE_USE_BOUNCE_BUFFER
+    // the bounce buffers are refilled from this frame buffer, the area is flushed once copied
+#if EXAMPLE_DISPLAY_ROTATION
+    example_rotate_draw(area, px_map);
+#else
+    example_bounce_draw(area, px_map);
+#endif
+    example_notify_lvgl_flush_ready(disp);
+#else
+#if CONFIG_EXAMPLE_BEAM_RACING
+    uint32_t wait_us = example_beam_wait(area);
+    if (wait_us) {
+        // the scan-out would catch up with the write, LVGL renders the next area meanwhile
+        example_flush_busy = true;
+        example_beam_area = *area;
+        example_beam_px_map = px_map;
+        ESP_ERROR_CHECK(esp_timer_start_once(example_beam_timer, wait_us));
+        return;
+    }
+#endif
+    example_fb_write(disp, area, px_map);
+#endif
 }
 
-static void example_increase_lvgl_tick(void *arg)
+static uint32_t example_lvgl_tick_get(void)
 {
-    /* Tell LVGL how many milliseconds has elapsed */
-    lv_tick_inc(EXAMPLE_LVGL_TICK_PERIOD_MS);
+    /* Read the LVGL tick straight from esp_timer, so no periodic tick interrupt is needed */
+    return (uint32_t)(esp_timer_get_time() / 1000);
 }
 
 static void example_lvgl_port_task(void *arg)
 {
     ESP_LOGI(TAG, "Starting LVGL task");
     uint32_t time_till_next_ms = 0;
+    uint32_t wake_reason = 0;
+    int64_t last_block_us = esp_timer_get_time();
     while (1) {
-        _lock_acquire(&lvgl_api_lock);
+        example_lvgl_lock();
+        EXAMPLE_TRACE(EXAMPLE_TRACE_LVGL_HANDLER);
+#if CONFIG_EXAMPLE_LCD_TOUCH_USE_INTERRUPT
+        if ((wake_reason & EXAMPLE_LVGL_WAKE_INPUT) && example_touch_indev) {
+            lv_indev_read(example_touch_indev);
+        }
+#endif
         time_till_next_ms = lv_timer_handler();
-        _lock_release(&lvgl_api_lock);
+        example_lvgl_unlock();
 
-        // in case of task watch dog timeout, set the minimal delay to 10ms
-        if (time_till_next_ms < 10) {
-            time_till_next_ms = 10;
+        // sleep until the next LVGL timer is due, or until something wakes us up earlier
+        TickType_t wait_ticks = portMAX_DELAY;
+        if (time_till_next_ms != LV_NO_TIMER_READY) {
+            wait_ticks = (time_till_next_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
         }
+        int64_t now = esp_timer_get_time();
+        if (wait_ticks == 0 && now - last_block_us > EXAMPLE_LVGL_MAX_BUSY_MS * 1000) {
+            // LVGL kept us busy for too long, give the idle task a chance to feed the task watchdog
+            wait_ticks = 1;
+        }
+        wake_reason = 0;
+        if (wait_ticks) {
+            xTaskNotifyWait(0, UINT32_MAX, &wake_reason, wait_ticks);
+            last_block_us = esp_timer_get_time();
+        }
+    }
+}
 
-        usleep(1000 * time_till_next_ms);
+#if CONFIG_EXAMPLE_ENABLE_LATENCY_TRACE || CONFIG_EXAMPLE_ENABLE_DISPLAY_TELEMETRY
+#define EXAMPLE_USE_MONITOR_TASK 1
+static void example_monitor_task(void *arg)
+{
+#if CONFIG_EXAMPLE_ENABLE_LATENCY_TRACE
+    const uint32_t dump_every = CONFIG_EXAMPLE_LATENCY_TRACE_DUMP_PERIOD_S * 1000 / EXAMPLE_MONITOR_PERIOD_MS;
+    uint32_t dump_rounds = 0;
+#endif
+#if CONFIG_EXAMPLE_ENABLE_DISPLAY_TELEMETRY
+    const uint32_t publish_every = CONFIG_EXAMPLE_TELEMETRY_PERIOD_S * 1000 / EXAMPLE_MONITOR_PERIOD_MS;
+    uint32_t publish_rounds = 0;
+#endif
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(EXAMPLE_MONITOR_PERIOD_MS));
+#if CONFIG_EXAMPLE_ENABLE_LATENCY_TRACE
+        // drain the ring buffer often enough that it never wraps
+        example_trace_process();
+        if (dump_every && ++dump_rounds >= dump_every) {
+            dump_rounds = 0;
+            example_trace_dump();
+        }
+#endif
+#if CONFIG_EXAMPLE_ENABLE_DISPLAY_TELEMETRY
+        if (publish_every && ++publish_rounds >= publish_every) {
+            publish_rounds = 0;
+            example_telemetry_publish();
+#if CONFIG_EXAMPLE_USE_BOUNCE_BUFFER
+            example_bounce_stats_t bounce_stats;
+            example_bounce_get_stats(&bounce_stats, true);
+            ESP_LOGI(TAG, "bounce buffer %"PRIu32" px, %"PRIu32" refills, %"PRIu32" underruns, refill max %"PRIu32" us of %"PRIu32" us",
+                     bounce_stats.size_px, bounce_stats.fills, bounce_stats.underruns,
+                     bounce_stats.fill_max_us, bounce_stats.period_us);
+#endif
+#if CONFIG_EXAMPLE_BEAM_RACING
+            example_beam_stats_t beam_stats;
+            example_beam_get_stats(&beam_stats, true);
+            ESP_LOGI(TAG, "beam racing: %"PRIu32" writes, %"PRIu32" deferred, %"PRIu32" too long to avoid tearing, wait max %"PRIu32" us, copy %.1f ns/byte",
+                     beam_stats.writes, beam_stats.deferred, beam_stats.unavoidable, beam_stats.wait_max_us,
+                     beam_stats.copy_ns_per_byte);
+#endif
+#if CONFIG_EXAMPLE_DIRTY_COALESCE
+            example_dirty_stats_t dirty_stats;
+            example_dirty_get_stats(&dirty_stats, true);
+            ESP_LOGI(TAG, "dirty areas %"PRIu32" merged into %"PRIu32" in %"PRIu32" refreshes, %"PRIu32" of %"PRIu32" invalidated px rendered (%"PRIu32"%%)",
+                     dirty_stats.rects_in, dirty_stats.rects_out, dirty_stats.passes, dirty_stats.rendered_px,
+                     dirty_stats.invalidated_px,
+                     dirty_stats.invalidated_px ? (uint32_t)((uint64_t)dirty_stats.rendered_px * 100 / dirty_stats.invalidated_px) : 0);
+#endif
+        }
+#endif
     }
 }
+#endif
 
 static void example_bsp_init_lcd_backlight(void)
 {
@@ -131,36 +495,56 @@ static void example_bsp_set_lcd_backlight(uint32_t level)
 #endif
 }
 
-void GT911_test(void *param){
-    uint16_t x,y;
-    while (1){
-        if(GT911_touched(&vernonGT911)){
-            //
-            // for(int i=0;i<5;i++){
-                GT911_read_pos(&vernonGT911,&x,&y,0);
-                ESP_LOGW(TAG,"No: %d, touched x: %d, touched y: %d\n", 0,  x, y);
-            // }
-        }
-        vTaskDelay(100 / portTICK_PERIOD_MS);
-    }
+static void example_panel_init_task(void *arg)
+{
+    esp_lcd_panel_handle_t panel_handle = (esp_lcd_panel_handle_t)arg;
+    ESP_LOGI(TAG, "Initialize RGB LCD panel");
+    ESP_ERROR_CHECK(esp_lcd_panel_reset(panel_handle));
+    example_boot_mark(EXAMPLE_BOOT_PANEL_RESET, esp_timer_get_time());
+    ESP_ERROR_CHECK(esp_lcd_panel_init(panel_handle));
+    // ESP_ERROR_CHECK(esp_lcd_panel_disp_on_off(panel_handle, true));
+    example_boot_mark(EXAMPLE_BOOT_PANEL_INIT, esp_timer_get_time());
+#if EXAMPLE_LCD_NUM_FB > 1
+    example_present_start();
+#endif
 
+    // LVGL has been rendering meanwhile, the first frame may be in the frame buffer already
+    if (!ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(EXAMPLE_BOOT_FIRST_FRAME_TIMEOUT_MS))) {
+        ESP_LOGW(TAG, "No frame after %d ms, turn on the backlight anyway", EXAMPLE_BOOT_FIRST_FRAME_TIMEOUT_MS);
+    }
+    // one more refresh period, so every line was scanned out after the frame was complete
+    const uint32_t refresh_ms = (uint32_t)(1000 / lcd_panel_refresh_hz(&example_timings)) + 1;
+    vTaskDelay((refresh_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS + 1);
+    ESP_LOGI(TAG, "Turn on LCD backlight");
+    example_bsp_set_lcd_backlight(EXAMPLE_LCD_BK_LIGHT_ON_LEVEL);
+    example_boot_mark(EXAMPLE_BOOT_BACKLIGHT_ON, esp_timer_get_time());
+    example_boot_report();
+    vTaskDelete(NULL);
 }
 
 void app_main(void)
 {
-    xTaskCreate(GT911_test,"i2c",1024*4,NULL,3,NULL);
-#if CONFIG_EXAMPLE_LCD_USE_TOUCH_ENABLED
-    GT911_init(&vernonGT911, TOUCH_I2C_SDA,TOUCH_I2C_SCL,TOUCH_PIN_INT,
-               TOUCH_PIN_RTN, I2C_NUM_0,GT911_ADDR1,
-               TOUCH_PAD_WIDTH, TOUCH_PAD_HEIGHT);
-
-    GT911_setRotation(&vernonGT911,ROTATION_NORMAL);
-    ESP_LOGW(TAG,"GT911 TouchPad Init");
-#endif
+    example_boot_mark(EXAMPLE_BOOT_APP_MAIN, esp_timer_get_time());
     ESP_LOGI(TAG, "Turn off LCD backlight");
     example_bsp_init_lcd_backlight();
     example_bsp_set_lcd_backlight(EXAMPLE_LCD_BK_LIGHT_OFF_LEVEL);
 
+    ESP_LOGI(TAG, "Select RGB LCD panel");
+    ESP_ERROR_CHECK(example_panel_register_all());
+    const lcd_panel_desc_t *panel = NULL;
+    uint8_t panel_id;
+    ESP_ERROR_CHECK(example_panel_select(&panel, &panel_id));
+    example_timings = panel->timings;
+
+#if CONFIG_EXAMPLE_LCD_USE_TOUCH_ENABLED
+    // the touch pad covers the panel, its unrotated size is the resolution of the selected panel.
+    // The display is still useful without touch, e.g. with the touch flex cable unplugged
+    esp_err_t touch_err = example_touch_install(example_timings.h_res, example_timings.v_res);
+    if (touch_err != ESP_OK) {
+        ESP_LOGE(TAG, "GT911 init failed (%s), continue without touch", esp_err_to_name(touch_err));
+    }
+#endif
+
     ESP_LOGI(TAG,"Initialize 3-Wire SPI Panel IO");
     spi_line_config_t line_config={
         .cs_io_type=IO_TYPE_GPIO,
@@ -171,18 +555,70 @@ void app_main(void)
         .sda_gpio_num=PIN_NUM_SDA,
         .io_expander=NULL,
     };
-#ifdef CONFIG_EXAMPLE_LCD_CONTROLLER_ST7701S
-    esp_lcd_panel_io_3wire_spi_config_t io_config=ST7701_PANEL_IO_3WIRE_SPI_CONFIG(line_config,0);
-#elif CONFIG_EXAMPLE_LCD_CONTROLLER_NV3052C
-    esp_lcd_panel_io_3wire_spi_config_t io_config=NV3052_PANEL_IO_3WIRE_SPI_CONFIG(line_config,0);
-#elif CONFIG_EXAMPLE_LCD_H040A18
-    esp_lcd_panel_io_3wire_spi_config_t io_config=H040A18_PANEL_IO_3WIRE_SPI_CONFIG(line_config,0);
-#elif CONFIG_EXAMPLE_LCD_H035A17
-    esp_lcd_panel_io_3wire_spi_config_t io_config=H035A17_PANEL_IO_3WIRE_SPI_CONFIG(line_config,0);
-#endif
+    esp_lcd_panel_io_3wire_spi_config_t io_config = {
+        .line_config = line_config,
+        .expect_clk_speed = PANEL_IO_3WIRE_SPI_CLK_MAX,
+        .spi_mode = panel->io.spi_mode,
+        .lcd_cmd_bytes = panel->io.cmd_bytes,
+        .lcd_param_bytes = panel->io.param_bytes,
+        .flags = {
+            .use_dc_bit = 1,
+            .del_keep_cs_inactive = 1,
+        },
+    };
     esp_lcd_panel_io_handle_t io_handle=NULL;
     ESP_ERROR_CHECK(esp_lcd_new_panel_io_3wire_spi(&io_config,&io_handle));
 
+    ESP_LOGI(TAG, "Check panel timing against the PSRAM bandwidth");
+    example_timing_config_t timing_config = {
+        .pclk_hz = example_timings.pclk_hz,
+        .h_res = example_timings.h_res,
+        .v_res = example_timings.v_res,
+        .h_blank = lcd_panel_h_total(&example_timings) - example_timings.h_res,
+        .v_blank = lcd_panel_v_total(&example_timings) - example_timings.v_res,
+        .pixel_size = EXAMPLE_FB_PIXEL_SIZE, // what the scan-out reads from PSRAM
+        .psram_dma_mbps = CONFIG_EXAMPLE_PSRAM_DMA_BANDWIDTH_MBPS,
+        .psram_copy_mbps = CONFIG_EXAMPLE_BOUNCE_PSRAM_BANDWIDTH_MBPS,
+        .reserve_percent = CONFIG_EXAMPLE_PSRAM_RESERVE_PERCENT,
+#if CONFIG_EXAMPLE_USE_BOUNCE_BUFFER
+        .scan = EXAMPLE_TIMING_SCAN_BOUNCE,
+#else
+        .scan = EXAMPLE_TIMING_SCAN_DMA,
+#endif
+    };
+    example_timing_report_t timing_report;
+    example_timing_calc(&timing_config, &timing_report);
+    example_timing_log(&timing_config, &timing_report);
+    if (timing_report.verdict == EXAMPLE_TIMING_UNDERRUN) {
+        // the PSRAM can't feed this panel in this buffer mode, a lower refresh rate beats a drifting picture
+        example_timings.pclk_hz = timing_report.max_pclk_hz[timing_config.scan];
+        ESP_LOGW(TAG, "Pixel clock lowered to %"PRIu32" Hz", example_timings.pclk_hz);
+    }
+
+#if CONFIG_EXAMPLE_BOUNCE_INDEXED_FB
+    ESP_LOGI(TAG, "Build frame buffer palette");
+    // the colors of the UI are kept exact
+    ESP_ERROR_CHECK(example_palette_init(example_lvgl_demo_ui_colors, example_lvgl_demo_ui_num_colors, EXAMPLE_PIXEL_SIZE));
+#endif
+#if CONFIG_EXAMPLE_USE_BOUNCE_BUFFER
+    ESP_LOGI(TAG, "Size bounce buffers");
+    example_bounce_config_t bounce_config = {
+        .pclk_hz = example_timings.pclk_hz,
+        .h_res = example_timings.h_res,
+        .v_res = example_timings.v_res,
+        .h_total = lcd_panel_h_total(&example_timings),
+        .v_total = lcd_panel_v_total(&example_timings),
+        .pixel_size = EXAMPLE_PIXEL_SIZE,
+        .fb_pixel_size = EXAMPLE_FB_PIXEL_SIZE,
+        .psram_bandwidth_mbps = CONFIG_EXAMPLE_BOUNCE_PSRAM_BANDWIDTH_MBPS,
+        .max_isr_latency_us = CONFIG_EXAMPLE_BOUNCE_MAX_ISR_LATENCY_US,
+        .sram_budget_percent = CONFIG_EXAMPLE_BOUNCE_SRAM_BUDGET_PERCENT,
+    };
+    uint32_t bounce_buffer_size_px = example_bounce_calc_size_px(&bounce_config);
+    // the frame buffer is owned by the example, so the bounce buffer refills can be timed
+    ESP_ERROR_CHECK(example_bounce_init(&bounce_config, bounce_buffer_size_px));
+#endif
+
     ESP_LOGI(TAG, "Install RGB LCD panel driver");
     esp_lcd_panel_handle_t panel_handle = NULL;
     esp_lcd_rgb_panel_config_t panel_config = {
@@ -190,7 +626,7 @@ void app_main(void)
         .dma_burst_size = 64,
         .num_fbs = EXAMPLE_LCD_NUM_FB,
 #if CONFIG_EXAMPLE_USE_BOUNCE_BUFFER
-        .bounce_buffer_size_px = 20 * EXAMPLE_LCD_H_RES,
+        .bounce_buffer_size_px = bounce_buffer_size_px,
 #endif
         .clk_src = LCD_CLK_SRC_DEFAULT,
         .disp_gpio_num = EXAMPLE_PIN_NUM_DISP_EN,
@@ -226,122 +662,186 @@ void app_main(void)
             EXAMPLE_PIN_NUM_DATA23
 #endif
         },
-        .timings = {
-            .pclk_hz = EXAMPLE_LCD_PIXEL_CLOCK_HZ,
-            .h_res = EXAMPLE_LCD_H_RES,
-            .v_res = EXAMPLE_LCD_V_RES,
-            .hsync_back_porch = EXAMPLE_LCD_HBP,
-            .hsync_front_porch = EXAMPLE_LCD_HFP,
-            .hsync_pulse_width = EXAMPLE_LCD_HSYNC,
-            .vsync_back_porch = EXAMPLE_LCD_VBP,
-            .vsync_front_porch = EXAMPLE_LCD_VFP,
-            .vsync_pulse_width = EXAMPLE_LCD_VSYNC,
-            .flags = {
-                .pclk_active_neg = true,
-            },
-        },
+        .timings = example_timings,
         .flags.fb_in_psram = true, // allocate frame buffer in PSRAM
-    };
-    
-#ifdef CONFIG_EXAMPLE_LCD_CONTROLLER_ST7701S
-    st7701_vendor_config_t vendor_config={
-#elif CONFIG_EXAMPLE_LCD_CONTROLLER_NV3052C
-    nv3052_vendor_config_t vendor_config={
-#elif CONFIG_EXAMPLE_LCD_H040A18
-    h040a18_vendor_config_t vendor_config={
-#elif CONFIG_EXAMPLE_LCD_H035A17  
-    h035a17_vendor_config_t vendor_config={      
-#endif
-        .rgb_config=&panel_config,
-        .flags={
-            .mirror_by_cmd=1,
-            .enable_io_multiplex=0,
-        }
-    };
-    
-    esp_lcd_panel_dev_config_t panel_dev_config={
-        .reset_gpio_num=PIN_NUM_RST,
-        .rgb_ele_order=LCD_RGB_ELEMENT_ORDER_RGB,
-        .bits_per_pixel=16,
-        .vendor_config=&vendor_config,
+#if CONFIG_EXAMPLE_USE_BOUNCE_BUFFER
+        .flags.no_fb = true, // bounce buffers are refilled by example_bounce_on_empty()
+#endif
     };
 
-#ifdef CONFIG_EXAMPLE_LCD_CONTROLLER_ST7701S
-    ESP_ERROR_CHECK(esp_lcd_new_panel_st7701_rgb(io_handle,&panel_dev_config,&panel_handle));
-#elif CONFIG_EXAMPLE_LCD_CONTROLLER_NV3052C
-    ESP_ERROR_CHECK(esp_lcd_new_panel_nv3052_rgb(io_handle,&panel_dev_config,&panel_handle));
-#elif CONFIG_EXAMPLE_LCD_H040A18
-    ESP_ERROR_CHECK(esp_lcd_new_panel_h040a18(io_handle,&panel_dev_config,&panel_handle));
-#elif CONFIG_EXAMPLE_LCD_H035A17
-    ESP_ERROR_CHECK(esp_lcd_new_panel_h035a17(io_handle,&panel_dev_config,&panel_handle));
+    lcd_panel_new_config_t panel_new_config = {
+        .rgb_config = &panel_config,
+        .reset_gpio_num = PIN_NUM_RST,
+        .flags = {
+            .mirror_by_cmd = 1,
+#if CONFIG_EXAMPLE_PANEL_WARM_RESTART
+            .warm_restart = 1,
 #endif
+        },
+    };
+    ESP_ERROR_CHECK(panel->new_panel(io_handle, &panel_new_config, &panel_handle));
+    example_boot_mark(EXAMPLE_BOOT_PANEL_CREATED, esp_timer_get_time());
 
-    ESP_LOGI(TAG, "Initialize RGB LCD panel");
-    ESP_ERROR_CHECK(esp_lcd_panel_reset(panel_handle));
-    ESP_ERROR_CHECK(esp_lcd_panel_init(panel_handle));
-    // ESP_ERROR_CHECK(esp_lcd_panel_disp_on_off(panel_handle, true));
-
-    ESP_LOGI(TAG, "Turn on LCD backlight");
-    example_bsp_set_lcd_backlight(EXAMPLE_LCD_BK_LIGHT_ON_LEVEL);
+#if CONFIG_EXAMPLE_BLIT_SELF_TEST
+    ESP_LOGI(TAG, "Blit self test: %s", example_blit_self_test() ? "pass" : "FAIL");
+#endif
 
     ESP_LOGI(TAG, "Initialize LVGL library");
     lv_init();
+    // resolution LVGL renders at
+    const bool ui_transposed = EXAMPLE_DISPLAY_ROTATION == 1 || EXAMPLE_DISPLAY_ROTATION == 3;
+    const uint32_t ui_h_res = ui_transposed ? example_timings.v_res : example_timings.h_res;
+    const uint32_t ui_v_res = ui_transposed ? example_timings.h_res : example_timings.v_res;
     // create a lvgl display
-    lv_display_t *display = lv_display_create(EXAMPLE_LCD_H_RES, EXAMPLE_LCD_V_RES);
+    lv_display_t *display = lv_display_create(ui_h_res, ui_v_res);
     // associate the rgb panel handle to the display
     lv_display_set_user_data(display, panel_handle);
     // set color depth
     lv_display_set_color_format(display, EXAMPLE_LV_COLOR_FORMAT);
     // create draw buffers
-    void *buf1 = NULL;
-    void *buf2 = NULL;
-#if CONFIG_EXAMPLE_USE_DOUBLE_FB
+#if EXAMPLE_LCD_NUM_FB > 1
     ESP_LOGI(TAG, "Use frame buffers as LVGL draw buffers");
-    ESP_ERROR_CHECK(esp_lcd_rgb_panel_get_frame_buffer(panel_handle, 2, &buf1, &buf2));
-    // set LVGL draw buffers and direct mode
-    lv_display_set_buffers(display, buf1, buf2, EXAMPLE_LCD_H_RES * EXAMPLE_LCD_V_RES * EXAMPLE_PIXEL_SIZE, LV_DISPLAY_RENDER_MODE_DIRECT);
+    void *fbs[EXAMPLE_LCD_NUM_FB] = {NULL};
+#if EXAMPLE_LCD_NUM_FB == 3
+    ESP_ERROR_CHECK(esp_lcd_rgb_panel_get_frame_buffer(panel_handle, 3, &fbs[0], &fbs[1], &fbs[2]));
+#else
+    ESP_ERROR_CHECK(esp_lcd_rgb_panel_get_frame_buffer(panel_handle, 2, &fbs[0], &fbs[1]));
+#endif
+    // direct mode, LVGL renders into an off screen frame buffer and they are swapped at VSYNC
+    ESP_ERROR_CHECK(example_present_init(display, panel_handle, fbs, EXAMPLE_LCD_NUM_FB, EXAMPLE_PRESENT_TASK_PRIORITY));
 #else
+#if !CONFIG_EXAMPLE_USE_BOUNCE_BUFFER
+    ESP_ERROR_CHECK(esp_lcd_rgb_panel_get_frame_buffer(panel_handle, 1, (void **)&example_fb));
+#endif
     ESP_LOGI(TAG, "Allocate LVGL draw buffers");
-    // it's recommended to allocate the draw buffer from internal memory, for better performance
-    size_t draw_buffer_sz = EXAMPLE_LCD_H_RES * EXAMPLE_LCD_V_RES/10 * EXAMPLE_PIXEL_SIZE;
-    buf1 = heap_caps_malloc(draw_buffer_sz, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    // two strips, LVGL renders into one while the other one is flushed
+    // it's recommended to allocate the draw buffers from internal memory, for better performance
+    size_t draw_buffer_sz = ui_h_res * EXAMPLE_LVGL_DRAW_BUF_LINES * EXAMPLE_PIXEL_SIZE;
+#if CONFIG_EXAMPLE_FLUSH_COPY_GDMA
+    const uint32_t draw_buffer_caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA;
+#else
+    const uint32_t draw_buffer_caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+#endif
+    void *buf1 = heap_caps_malloc(draw_buffer_sz, draw_buffer_caps);
     assert(buf1);
+    void *buf2 = heap_caps_malloc(draw_buffer_sz, draw_buffer_caps);
+    if (!buf2) {
+        // still better than serializing render and flush
+        ESP_LOGW(TAG, "Not enough internal memory for the second draw buffer, allocate it from PSRAM");
+        buf2 = heap_caps_malloc(draw_buffer_sz, MALLOC_CAP_SPIRAM);
+    }
+    assert(buf2);
     // set LVGL draw buffers and partial mode
     lv_display_set_buffers(display, buf1, buf2, draw_buffer_sz, LV_DISPLAY_RENDER_MODE_PARTIAL);
-#endif // CONFIG_EXAMPLE_USE_DOUBLE_FB
+#if EXAMPLE_DISPLAY_ROTATION
+    example_rotate_config_t rotate_config = {
+#if CONFIG_EXAMPLE_USE_BOUNCE_BUFFER
+        .fb = example_bounce_get_fb(),
+#else
+        .fb = example_fb,
+        .dma_reads_fb = true,
+#endif
+        .h_res = example_timings.h_res,
+        .v_res = example_timings.v_res,
+        .pixel_size = EXAMPLE_PIXEL_SIZE,
+        .rotation = EXAMPLE_DISPLAY_ROTATION,
+    };
+    ESP_ERROR_CHECK(example_rotate_init(&rotate_config));
+#endif
+#endif // EXAMPLE_LCD_NUM_FB > 1
 
     // set the callback which can copy the rendered image to an area of the display
     lv_display_set_flush_cb(display, example_lvgl_flush_cb);
+    example_flush_done_sem = xSemaphoreCreateBinary();
+    assert(example_flush_done_sem);
+    lv_display_set_flush_wait_cb(display, example_lvgl_flush_wait_cb);
+    lv_display_add_event_cb(display, example_lvgl_invalidate_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+#if CONFIG_EXAMPLE_DIRTY_COALESCE
+    example_dirty_config_t dirty_config = {
+        .h_res = ui_h_res,
+        .v_res = ui_v_res,
+        .tile_w = EXAMPLE_DIRTY_TILE_W,
+        .tile_h = EXAMPLE_DIRTY_TILE_H,
+        .rect_cost_px = EXAMPLE_DIRTY_RECT_COST_PX,
+    };
+    example_dirty_init(&dirty_config);
+    lv_display_add_event_cb(display, example_lvgl_coalesce_cb, LV_EVENT_RENDER_START, NULL);
+#endif
+#if EXAMPLE_LCD_NUM_FB > 1
+    // registered before the telemetry, so the wait for VSYNC is not counted as render time
+    lv_display_add_event_cb(display, example_lvgl_render_start_cb, LV_EVENT_RENDER_START, NULL);
+#endif
+    example_telemetry_init(display, lcd_panel_refresh_hz(&example_timings));
+#if CONFIG_EXAMPLE_FLUSH_COPY_GDMA
+    ESP_ERROR_CHECK(example_async_flush_install_gdma(example_notify_lvgl_copy_done, display));
+#endif
+#if CONFIG_EXAMPLE_BEAM_RACING
+    example_beam_config_t beam_config = {
+        .pclk_hz = example_timings.pclk_hz,
+        .h_total = lcd_panel_h_total(&example_timings),
+        .v_res = example_timings.v_res,
+        .v_total = lcd_panel_v_total(&example_timings),
+        // the VSYNC event comes at the start of the pulse
+        .vsync_to_active_lines = example_timings.vsync_pulse_width + example_timings.vsync_back_porch,
+        .margin_lines = EXAMPLE_BEAM_MARGIN_LINES,
+    };
+    example_beam_init(&beam_config);
+    const esp_timer_create_args_t beam_timer_args = {
+        .callback = example_beam_timer_cb,
+        .arg = display,
+        // the deferred write may use the PIE blits, which are not usable from an ISR
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "beam",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&beam_timer_args, &example_beam_timer));
+#endif
 
     ESP_LOGI(TAG, "Register event callbacks");
     esp_lcd_rgb_panel_event_callbacks_t cbs = {
-        .on_color_trans_done = example_notify_lvgl_flush_ready,
+#if EXAMPLE_LCD_NUM_FB > 1
+        .on_vsync = example_notify_lvgl_vsync,
+#elif CONFIG_EXAMPLE_USE_BOUNCE_BUFFER
+        .on_bounce_empty = example_bounce_on_empty,
+#endif
+#if CONFIG_EXAMPLE_BEAM_RACING
+        .on_vsync = example_beam_vsync_cb,
+#endif
     };
     ESP_ERROR_CHECK(esp_lcd_rgb_panel_register_event_callbacks(panel_handle, &cbs, display));
+    example_boot_mark(EXAMPLE_BOOT_LVGL_READY, esp_timer_get_time());
+
+    // the reset and init sequence mostly wait, LVGL builds and renders the first screen into the frame buffer meanwhile
+    xTaskCreate(example_panel_init_task, "panel_init", EXAMPLE_PANEL_INIT_TASK_STACK_SIZE, panel_handle,
+                EXAMPLE_PANEL_INIT_TASK_PRIORITY, &example_panel_init_task_handle);
 
     ESP_LOGI(TAG, "Install LVGL tick timer");
-    // Tick interface for LVGL (using esp_timer to generate 2ms periodic event)
-    const esp_timer_create_args_t lvgl_tick_timer_args = {
-        .callback = &example_increase_lvgl_tick,
-        .name = "lvgl_tick"
-    };
-    esp_timer_handle_t lvgl_tick_timer = NULL;
-    ESP_ERROR_CHECK(esp_timer_create(&lvgl_tick_timer_args, &lvgl_tick_timer));
-    ESP_ERROR_CHECK(esp_timer_start_periodic(lvgl_tick_timer, EXAMPLE_LVGL_TICK_PERIOD_MS * 1000));
+    // Tick interface for LVGL (read from esp_timer on demand)
+    lv_tick_set_cb(example_lvgl_tick_get);
 
 #if CONFIG_EXAMPLE_LCD_USE_TOUCH_ENABLED
-    static lv_indev_t* touch_indev;
-    touch_indev=lv_indev_create();
-    lv_indev_set_type(touch_indev,LV_INDEV_TYPE_POINTER);
-    lv_indev_set_display(touch_indev,display);
-    lv_indev_set_read_cb(touch_indev,example_lvgl_touch_cb);
+    if (touch_err == ESP_OK) {
+        example_touch_init();
+        example_touch_indev=lv_indev_create();
+        lv_indev_set_type(example_touch_indev,LV_INDEV_TYPE_POINTER);
+        lv_indev_set_display(example_touch_indev,display);
+        lv_indev_set_read_cb(example_touch_indev,example_lvgl_touch_cb);
+#if CONFIG_EXAMPLE_LCD_TOUCH_USE_INTERRUPT
+        // the touch task wakes the LVGL task for every new frame, no need to poll the read callback
+        lv_indev_set_mode(example_touch_indev,LV_INDEV_MODE_EVENT);
+#endif
+    }
 #endif
-    ESP_LOGI(TAG, "Create LVGL task");
-    xTaskCreate(example_lvgl_port_task, "LVGL", EXAMPLE_LVGL_TASK_STACK_SIZE, NULL, EXAMPLE_LVGL_TASK_PRIORITY, NULL);
-
     ESP_LOGI(TAG, "Display LVGL UI");
+    // built before the LVGL task starts, so the first frame it renders is the UI and not an empty screen.
     // Lock the mutex due to the LVGL APIs are not thread-safe
-    _lock_acquire(&lvgl_api_lock);
+    example_lvgl_lock();
     example_lvgl_demo_ui(display);
-    _lock_release(&lvgl_api_lock);
+    example_boot_mark(EXAMPLE_BOOT_UI_BUILT, esp_timer_get_time());
+    example_lvgl_unlock();
+
+    ESP_LOGI(TAG, "Create LVGL task");
+    xTaskCreate(example_lvgl_port_task, "LVGL", EXAMPLE_LVGL_TASK_STACK_SIZE, NULL, EXAMPLE_LVGL_TASK_PRIORITY, &example_lvgl_task_handle);
+#if EXAMPLE_USE_MONITOR_TASK
+    xTaskCreate(example_monitor_task, "monitor", EXAMPLE_MONITOR_TASK_STACK_SIZE, NULL, EXAMPLE_MONITOR_TASK_PRIORITY, NULL);
+#endif
 }
@@ -10,8 +10,12 @@ from pytest_embedded import Dut
     'config',
     [
         'single_fb_with_bb',
+        'bounce_indexed_fb',
         'single_fb_no_bb',
+        'single_fb_gdma_flush',
+        'single_fb_rotate_90',
         'double_fb',
+        'triple_fb',
     ],
     indirect=True,
 )
@@ -32,8 +36,12 @@ def test_rgb_lcd_lvgl_esp32s3(dut: Dut) -> None:
     'config',
     [
         'single_fb_with_bb',
+        'bounce_indexed_fb',
         'single_fb_no_bb',
+        'single_fb_gdma_flush',
+        'single_fb_rotate_90',
         'double_fb',
+        'triple_fb',
     ],
     indirect=True,
 )